@@ -0,0 +1,230 @@
+//-----------------------------------------------------------------------------
+// CRC-32, as used by zlib, PNG and tuners such as TunerStudio
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2018 Arend Lammertink
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, version 3.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+// for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+//
+// Description:
+//
+// The CRC is updated in zlib style, starting from 0:
+//
+//   uint32_t crc = crc32Update( 0, a, na );
+//   crc          = crc32Update( crc, b, nb );     // CRC of a followed by b
+//
+// On the host, 8 bytes are processed per step using 8 tables of 256 entries
+// (slice-by-8, 8 kB), which are computed on first use. On an MCU, a table of
+// 16 entries in flash is used, processing a nibble per step. This is selected
+// by CRC32_SMALL, which is defined by default on Arduino, for any MCU; define
+// it to use the small table on a host as well.
+//
+// The CRC of a concatenation can also be computed from the CRCs of its parts,
+// without the data, using crc32Combine(). This is used to compute the CRC of a
+// page of maps from the CRCs cached by the maps, see MapRegistry::crc.
+//
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// Multi-include protection
+//-----------------------------------------------------------------------------
+
+#ifndef _CRC32_H
+#define _CRC32_H
+
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#ifdef AVR
+#include <avr/pgmspace.h>
+#endif
+
+
+//-----------------------------------------------------------------------------
+// Defines
+//-----------------------------------------------------------------------------
+
+#define CRC32_POLY      0xEDB88320UL    // reflected 0x04C11DB7
+
+#if defined(ARDUINO) && !defined(CRC32_SMALL)
+#define CRC32_SMALL
+#endif
+
+#ifdef AVR
+#define CRC32_FLASH         PROGMEM
+#define CRC32_READ(p)       pgm_read_dword(p)
+#else                                   // const data stays in flash
+#define CRC32_FLASH
+#define CRC32_READ(p)       (*(p))
+#endif
+
+
+#ifdef CRC32_SMALL
+//-----------------------------------------------------------------------------
+// Update crc with n bytes at p, a nibble at a time.
+//-----------------------------------------------------------------------------
+
+inline uint32_t crc32Update( uint32_t crc, const uint8_t* p, size_t n )
+{
+    static const uint32_t table[16] CRC32_FLASH =
+    {
+      0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC,
+      0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+      0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+      0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+    };
+
+    crc = ~crc;
+
+    while( n-- )
+    {
+      crc ^= *p++;
+      crc  = CRC32_READ( &table[crc & 0x0F] ) ^ (crc >> 4);
+      crc  = CRC32_READ( &table[crc & 0x0F] ) ^ (crc >> 4);
+    }
+
+    return ~crc;
+}
+
+#else
+//-----------------------------------------------------------------------------
+// Tables for slice-by-8. t[0] is the classic byte wise table, t[k] advances
+// the CRC over k more zero bytes.
+//-----------------------------------------------------------------------------
+
+struct Crc32Tables
+{
+                  Crc32Tables()
+                  {
+                    for( uint32_t i=0; i<256; i++ )
+                    {
+                      uint32_t c = i;
+
+                      for( int b=0; b<8; b++ ) c = c & 1 ? (c >> 1) ^ CRC32_POLY : c >> 1;
+
+                      t[0][i] = c;
+                    }
+
+                    for( int k=1; k<8; k++ )
+                      for( int i=0; i<256; i++ )
+                        t[k][i] = (t[k-1][i] >> 8) ^ t[0][t[k-1][i] & 0xFF];
+                  }
+
+    uint32_t      t[8][256];
+};
+
+
+//-----------------------------------------------------------------------------
+// Update crc with n bytes at p, 8 bytes at a time.
+//-----------------------------------------------------------------------------
+
+inline uint32_t crc32Update( uint32_t crc, const uint8_t* p, size_t n )
+{
+    static const Crc32Tables tables;
+
+    const uint32_t (*t)[256] = tables.t;
+
+    crc = ~crc;
+
+#if !defined(__BYTE_ORDER__) || __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    for( ; n >= 8; n -= 8, p += 8 )
+    {
+      uint32_t a, b;
+
+      memcpy( &a, p,   4 );
+      memcpy( &b, p+4, 4 );
+
+      a ^= crc;
+
+      crc = t[7][ a        & 0xFF] ^ t[6][(a >>  8) & 0xFF] ^
+            t[5][(a >> 16) & 0xFF] ^ t[4][ a >> 24        ] ^
+            t[3][ b        & 0xFF] ^ t[2][(b >>  8) & 0xFF] ^
+            t[1][(b >> 16) & 0xFF] ^ t[0][ b >> 24        ];
+    }
+#endif
+
+    while( n-- ) crc = t[0][(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+
+    return ~crc;
+}
+#endif
+
+
+//-----------------------------------------------------------------------------
+// Multiplication modulo the CRC polynomial, in the reflected representation,
+// where 1 << 31 is x^0. Returns x^(8n) mod P, the effect on the CRC register
+// of n zero bytes.
+//-----------------------------------------------------------------------------
+
+inline uint32_t crc32MulModP( uint32_t a, uint32_t b )
+{
+    uint32_t p = 0;
+
+    for( uint32_t m = 1UL << 31; m; m >>= 1 )
+    {
+      if( a & m ) p ^= b;
+
+      b = b & 1 ? (b >> 1) ^ CRC32_POLY : b >> 1;
+    }
+
+    return p;
+}
+
+inline uint32_t crc32PowModP( size_t n )
+{
+    uint32_t p = 1UL << 31;             // x^0
+    uint32_t x = 1UL << 23;             // x^8
+
+    for( ; n; n >>= 1 )
+    {
+      if( n & 1 ) p = crc32MulModP( x, p );
+      x = crc32MulModP( x, x );
+    }
+
+    return p;
+}
+
+
+//-----------------------------------------------------------------------------
+// CRC of a followed by b, given crcA, the CRC of a, and crcB, the CRC of b,
+// which is nb bytes long.
+//-----------------------------------------------------------------------------
+
+inline uint32_t crc32Combine( uint32_t crcA, uint32_t crcB, size_t nb )
+{
+    return crc32MulModP( crc32PowModP(nb), crcA ) ^ crcB;
+}
+
+
+//-----------------------------------------------------------------------------
+// Update crc with n zero bytes, without processing them one by one.
+//-----------------------------------------------------------------------------
+
+inline uint32_t crc32Zeros( uint32_t crc, size_t n )
+{
+    return ~crc32MulModP( crc32PowModP(n), ~crc );
+}
+
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+
+#endif // End multi-include protection
@@ -40,6 +40,11 @@
 //
 //   ExtentedSerial mySerial(Serial);
 //
+// or using any other Transport (see Transport.h), such as a pipe on a host:
+//
+//   FdTransport    pipeEnd(fd);
+//   ExtentedSerial mySerial(pipeEnd);
+//
 // It can then be used just like any other Serial, like:
 //   
 //   mySerial.begin(9600);
@@ -55,6 +60,20 @@
 //   float g;
 //   if( !mySerial.receive(g) ) { mySerial.println("No data available"); }
 //
+// Arrays are sent and received in one call:
+//
+//   Fix16 table[256];
+//   mySerial.send(table, 256);
+//
+// The byte order on the wire is little endian by default, which is the native
+// order of AVR, ARM and x86, and can be set to big endian with setByteOrder().
+// If it differs from the native order, the values are byte swapped in bulk
+// into a transmit buffer, which is written in one call per buffer full.
+//
+// Between beginSend() and endSend(), all sent values are collected in the
+// transmit buffer, so e.g. the rows of a map are written in a few large
+// writes rather than one per row.
+//
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
@@ -70,6 +89,61 @@
 
 #include <HardwareSerial.h>
 #include <fix16.hpp>
+#include <string.h>
+#include "Transport.h"
+
+//-----------------------------------------------------------------------------
+// Defines
+//-----------------------------------------------------------------------------
+
+#ifndef EXTENDED_SERIAL_TX_BUFFER
+#ifdef AVR
+#define EXTENDED_SERIAL_TX_BUFFER   16
+#else
+#define EXTENDED_SERIAL_TX_BUFFER   256
+#endif
+#endif
+
+//-----------------------------------------------------------------------------
+// Scalar types which can be sent and received in binary format. Other types
+// have no WireType and are rejected at compile time.
+//-----------------------------------------------------------------------------
+
+template<typename T> struct WireType;
+
+template<> struct WireType<uint8_t>  { enum { size = sizeof(uint8_t)  }; };
+template<> struct WireType<int8_t>   { enum { size = sizeof(int8_t)   }; };
+template<> struct WireType<uint16_t> { enum { size = sizeof(uint16_t) }; };
+template<> struct WireType<int16_t>  { enum { size = sizeof(int16_t)  }; };
+template<> struct WireType<uint32_t> { enum { size = sizeof(uint32_t) }; };
+template<> struct WireType<int32_t>  { enum { size = sizeof(int32_t)  }; };
+template<> struct WireType<float>    { enum { size = sizeof(float)    }; };
+template<> struct WireType<double>   { enum { size = sizeof(double)   }; };
+template<> struct WireType<Fix16>    { enum { size = sizeof(Fix16)    }; };
+
+// Reverse the bytes of n values of 'size' bytes each, in place. The loops
+// have no dependencies between iterations, so the compiler can vectorize
+// them on the host.
+inline void byteSwap( uint8_t* b, size_t n, size_t size )
+{
+    switch( size )
+    {
+      case 2:
+        for( size_t i=0; i<n; i++, b+=2 )
+        { uint16_t v; memcpy( &v, b, 2 ); v = __builtin_bswap16(v); memcpy( b, &v, 2 ); }
+        break;
+
+      case 4:
+        for( size_t i=0; i<n; i++, b+=4 )
+        { uint32_t v; memcpy( &v, b, 4 ); v = __builtin_bswap32(v); memcpy( b, &v, 4 ); }
+        break;
+
+      case 8:
+        for( size_t i=0; i<n; i++, b+=8 )
+        { uint64_t v; memcpy( &v, b, 8 ); v = __builtin_bswap64(v); memcpy( b, &v, 8 ); }
+        break;
+    }
+}
 
 //-----------------------------------------------------------------------------
 // ExtendedSerial class
@@ -79,22 +153,26 @@ class ExtendedSerial : public Stream
 {
 
   public:
-                    ExtendedSerial(HardwareSerial& s) : _s(s) {}
+    enum ByteOrder  { WIRE_LITTLE_ENDIAN, WIRE_BIG_ENDIAN };
+
+                    ExtendedSerial(HardwareSerial& s)
+                      : _s(HardwareSerialTransport::of(s)), _order(WIRE_LITTLE_ENDIAN), _txlen(0), _txdepth(0), _txshort(false) {}
 
-    // Methods delegated to existing Serial instance
+                    ExtendedSerial(Transport& t)
+                      : _s(t), _order(WIRE_LITTLE_ENDIAN), _txlen(0), _txdepth(0), _txshort(false) {}
+
+    // Methods delegated to the transport
+    void            begin(unsigned long baud)         { _s.begin(baud);           }
 #ifdef AVR
-    void            begin(unsigned long baud)         { begin(baud, SERIAL_8N1);  }
     void            begin(unsigned long b, uint8_t m) { _s.begin(b,m);            }
-#else
-    void            begin(unsigned long baud)         { _s.begin(baud);           }
 #endif
     void            end()                             { _s.end();                 }
     virtual int     available(void)                   { return _s.available();    }
     virtual int     peek(void)                        { return _s.peek();         }
     virtual int     read(void)                        { return _s.read();         }
-    virtual void    flush(void)                       { return _s.flush();        }
-    virtual size_t  write(uint8_t n)                  { return _s.write(n);       }
-    virtual size_t  write(const uint8_t* b,size_t sz) { return _s.write(b,sz);    }
+    virtual void    flush(void)                       { flushTx(); _s.flush();    }
+    virtual size_t  write(uint8_t n)                  { flushTx(); return _s.write(n);    }
+    virtual size_t  write(const uint8_t* b,size_t sz) { flushTx(); return _s.write(b,sz); }
     inline  size_t  write(unsigned long n)            { return write((uint8_t)n); }
     inline  size_t  write(long n)                     { return write((uint8_t)n); }
     inline  size_t  write(unsigned int n)             { return write((uint8_t)n); }
@@ -108,41 +186,105 @@ class ExtendedSerial : public Stream
     size_t          print(  Fix16 f, int d = 2)       { return print(  (double)f,d); }
     size_t          println(Fix16 f, int d = 2)       { return println((double)f,d); }
 
-    size_t          receive(uint8_t* buf, size_t sz)
+    // Byte order of values on the wire
+    void            setByteOrder(ByteOrder o)         { _order = o;               }
+    ByteOrder       byteOrder() const                 { return _order;            }
+
+    static ByteOrder nativeOrder()
+                    {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+                      return WIRE_BIG_ENDIAN;
+#else
+                      return WIRE_LITTLE_ENDIAN;
+#endif
+                    }
+
+    // Send n values in binary format. Returns the number of bytes written,
+    // which is less than n*size on a short write of the transport. Between
+    // beginSend() and endSend(), returns the number of bytes buffered; short
+    // writes are then reported by endSend().
+    template<typename T>
+    size_t          send(const T* x, size_t n)
                     {
-                      if( available() < sz )            return 0;
+                      const size_t   size  = WireType<T>::size;
+                      const size_t   total = n*size;
+                      const uint8_t* src   = (const uint8_t*)x;
+                      size_t         sent  = 0;
+
+                      if( _order == nativeOrder() && !_txdepth && total >= sizeof(_txbuf) )
+                      {
+                        flushTx();                  // large, no staging needed
+                        return _s.write(src, total);
+                      }
+
+                      for( size_t done=0; done<total; )
+                      {
+                        if( _txlen + size > sizeof(_txbuf) )
+                        {
+                          const size_t len = _txlen;
+                          const size_t k   = writeTx();
+
+                          sent += k;
+                          if( k < len && !_txdepth ) return sent;
+                        }
+
+                        size_t len = (sizeof(_txbuf) - _txlen) / size * size;
+                        if( len > total - done ) len = total - done;
+
+                        memcpy( _txbuf + _txlen, src + done, len );
+
+                        if( _order != nativeOrder() ) byteSwap( _txbuf + _txlen, len/size, size );
+
+                        _txlen += len;
+                        done   += len;
+                      }
 
-                      for( int i=0; i<sz; i++)        { *buf++ = (uint8_t)read();    }
+                      if( _txdepth )    return total;
 
-                      return sz;
+                      return sent + writeTx();
                     }
 
-    size_t          send(const uint8_t& x)  { return write(x);                                   }
-    size_t          receive(uint8_t& x)     { return receive((uint8_t*)&x, sizeof(uint8_t));     }
+    // Receive n values in binary format. Returns 0, without reading anything,
+    // if fewer than n values are available.
+    template<typename T>
+    size_t          receive(T* x, size_t n)
+                    {
+                      const size_t   size  = WireType<T>::size;
+                      const size_t   total = n*size;
+                      uint8_t*       dst   = (uint8_t*)x;
 
-    size_t          send(const int8_t& x)   { return write((uint8_t)x);                          }
-    size_t          receive(int8_t& x)      { return receive((uint8_t*)&x, sizeof(int8_t));      }
+                      if( available() < (int)total )    return 0;
 
-    size_t          send(const int16_t& x)  { return write((const uint8_t*)&x, sizeof(int16_t)); }
-    size_t          receive(int16_t& x)     { return receive((uint8_t*)&x,     sizeof(int16_t)); }
+                      for( size_t i=0; i<total; i++)  { dst[i] = (uint8_t)read();    }
 
-    size_t          send(const uint16_t& x) { return write((const uint8_t*)&x, sizeof(uint16_t));}
-    size_t          receive(uint16_t& x)    { return receive((uint8_t*)&x,     sizeof(uint16_t));}
+                      if( _order != nativeOrder() ) byteSwap( dst, n, size );
 
-    size_t          send(const int32_t& x)  { return write((const uint8_t*)&x, sizeof(int32_t)); }
-    size_t          receive(int32_t& x)     { return receive((uint8_t*)&x,     sizeof(int32_t)); }
+                      return total;
+                    }
 
-    size_t          send(const uint32_t& x) { return write((const uint8_t*)&x, sizeof(uint32_t));}
-    size_t          receive(uint32_t& x)    { return receive((uint8_t*)&x,     sizeof(uint32_t));}
+    template<typename T>
+    size_t          send(const T& x)                  { return send(&x, 1);       }
 
-    size_t          send(const float& x)    { return write((const uint8_t*)&x, sizeof(float));   }
-    size_t          receive(float& x)       { return receive((uint8_t*)&x,     sizeof(float));   }
+    template<typename T>
+    size_t          receive(T& x)                     { return receive(&x, 1);    }
 
-    size_t          send(const double& x)   { return write((const uint8_t*)&x, sizeof(double));  }
-    size_t          receive(double& x)      { return receive((uint8_t*)&x,     sizeof(double));  }
+    // Collect everything sent until the matching endSend() in the transmit
+    // buffer. May be nested. endSend() returns false if the transport wrote
+    // fewer bytes than were sent since the outermost beginSend().
+    void            beginSend()   { if( !_txdepth++ ) _txshort = false;          }
+    bool            endSend()
+                    {
+                      if( _txdepth && !--_txdepth ) flushTx();
+                      return !_txshort;
+                    }
 
-    size_t          send(const Fix16& x)    { return write((const uint8_t*)&x, sizeof(Fix16));   }
-    size_t          receive(Fix16& x)       { return receive((uint8_t*)&x,     sizeof(Fix16));   }
+    // Write the contents of the transmit buffer. Returns false on a short
+    // write, the bytes not written are dropped.
+    bool            flushTx()
+                    {
+                      const size_t len = _txlen;
+                      return writeTx() == len;
+                    }
 
     using           Print::write;   // pull in the other write methods from Print.
     using           Print::print;   // pull in existing print methods from Print.
@@ -150,9 +292,29 @@ class ExtendedSerial : public Stream
 
   private:
 
-    HardwareSerial& _s;
+    // Write and empty the transmit buffer, returns the number of bytes written.
+    size_t          writeTx()
+                    {
+                      const size_t len = _txlen;
+                      if( !len ) return 0;
+
+                      _txlen = 0;
+
+                      const size_t k = _s.write(_txbuf, len);
+                      if( k < len ) _txshort = true;
+
+                      return k;
+                    }
+
+    Transport&      _s;
+
+    ByteOrder       _order;
+    uint8_t         _txbuf[EXTENDED_SERIAL_TX_BUFFER];
+    size_t          _txlen;
+    uint8_t         _txdepth;
+    bool            _txshort;       // short write since the outermost beginSend()
 
-                    // Must be instantiated with a HardwareSerial&.
+                    // Must be instantiated with a HardwareSerial& or Transport&.
                     ExtendedSerial();
                     ExtendedSerial(ExtendedSerial&);
                     ExtendedSerial(int);
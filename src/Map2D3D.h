@@ -76,6 +76,8 @@
 #include "interpolate.h"
 #include "toString.h"
 #include "ExtendedSerial.h"
+#include "MapHeatmap.h"
+#include "MapTrace.h"
 
 #ifdef AVR
 #include <avr/eeprom.h>
@@ -84,19 +86,12 @@
 #endif
 
 
-//-----------------------------------------------------------------------------
-// Debug stuff
-//-----------------------------------------------------------------------------
-
-//#define DEBUG            1
-
-#if DEBUG == 1
-    #define dprint(expression) p.print(F("# ")); p.print( F(#expression) ); \
-                               p.print( F(": ") ); p.println( expression )
-    #define dshow(expression) p.println( expression )
+// Byte offset in the wire image of a map. Run time sized maps on hosts, see
+// MapDyn.h, may exceed 64 KiB.
+#ifdef ARDUINO
+typedef uint16_t    map_offset_t;
 #else
-    #define dprint(expression)
-    #define dshow(expression)
+typedef size_t      map_offset_t;
 #endif
 
 
@@ -107,8 +102,15 @@
 class Map
 {
   public:
+                  Map() : bytesToReceive(0), bytesReceived(0), curOffset(0),
+                          crcValue(0), crcOrder(0) {}
+
     virtual int   memSize() const                               =0;
 
+    // Bytes per row of cells on the wire. Neighbouring rows of a map tend
+    // to be alike, which is used for compression, see MapCompress.h.
+    virtual int   rowSize() const                               =0;
+
 #ifdef AVR
     virtual bool  updateEeprom(uint8_t*      dest) const        =0;
     virtual bool  readEeprom( const uint8_t* src)               =0;
@@ -119,33 +121,194 @@ class Map
 
     virtual void  sendTo( ExtendedSerial& s)                    =0;
 
-    void          initReceive( uint16_t offset, size_t nr_bytes) 
-                  { bytesToReceive=nr_bytes; bytesReceived=0; curOffset=offset; }
+    // Send nr_bytes of the wire layout used by sendTo, starting at byte
+    // offset 'offset'. Both must lie on element boundaries, as for receive.
+    // Returns the number of bytes sent, 0 if the transport did not take them
+    // all (see ExtendedSerial::endSend).
+    virtual size_t sendRange( ExtendedSerial& s, map_offset_t offset,
+                              size_t nr_bytes)                  =0;
+
+    // Bytes on the wire of the element at byte offset 'offset', 0 past the
+    // end. Used to keep ranges on element boundaries, see MapPatch.h.
+    virtual size_t elementSize( map_offset_t offset)            =0;
+
+    // CRC-32 of the wire image, as sent by sendTo in the given byte order.
+    // It is cached until the map is modified, so e.g. a tuner verifying its
+    // pages does not cause the maps to be rescanned.
+    virtual uint32_t crc( ExtendedSerial::ByteOrder order =
+                          ExtendedSerial::WIRE_LITTLE_ENDIAN)   =0;
+
+    void          initReceive( map_offset_t offset, size_t nr_bytes) 
+                  {
+                    MAP_TRACE_POINT( TRACE_RECEIVE, offset, nr_bytes );
+                    bytesToReceive=nr_bytes; bytesReceived=0; curOffset=offset;
+                  }
 
     bool		  receiveDone()
                   { return bytesReceived >= bytesToReceive; }
                 
-    virtual bool  receiveFrom( ExtendedSerial& s)
+    // Receive the available data, but at most about maxBytes (0: no limit)
+    // per call, so the time spent in a call is bounded. Elements are only
+    // stored when all their bytes have arrived. Returns receiveDone().
+    virtual bool  receiveFrom( ExtendedSerial& /*s*/, size_t /*maxBytes*/ = 0)
                   { return receiveDone();                   }
 
     protected:
 
     size_t		 bytesToReceive;
     size_t		 bytesReceived;
-    uint16_t	 curOffset;
+    map_offset_t curOffset;
+
+    uint32_t     crcValue;              // valid if VALID_CRC is set
+    uint8_t      crcOrder;              // byte order of crcValue
 };
 
 
 
+//-----------------------------------------------------------------------------
+// Derived data cached by maps. The corresponding bits in the 'valid' byte of
+// a map are cleared whenever its axes or cells are modified.
+//-----------------------------------------------------------------------------
+
+enum MapValid
+{
+    VALID_ORDER     = 0x01,         // Map2D: monotonicity of the ys
+    VALID_CACHE     = 0x02,         // Cached: dense table of f(x)
+    VALID_CRC       = 0x04          // Map: CRC-32 of the wire image
+};
+
+
+//-----------------------------------------------------------------------------
+// Search an ordered table of n elements using bisection. Returns i, such that
+// xs[i] <= x < xs[i+1]. x must be within the range [xs[0], xs[n-1]].
+//
+// Each axis type gets its own instantiation, so the compares in the inner loop
+// are done at the native width of the axis.
+//
+// With MAP_CONSTANT_TIME_SEARCH, the number of steps depends on n only, and
+// each step selects its half without a branch, so every search of a table
+// takes the same time. See also MapProfile.h.
+//-----------------------------------------------------------------------------
+
+template<typename X>
+inline int search( const X* xs, int n, X x )
+{
+#ifdef MAP_CONSTANT_TIME_SEARCH
+    int i = 0, len = n-1;               // i .. i+len-1 may hold the result
+
+    while ( len > 1 ) {
+        const int half = len >> 1;
+
+        i   += ( x >= xs[i+half] ) * half;
+        len -= half;
+    }
+
+    return i;
+#else
+    int i=0, j=n-1, k;
+
+    while ( j - i > 1) {
+        k = (i+j) >> 1;  // k = (i+j)/2
+
+        if ( x >= xs[k] )   i = k;
+        else                j = k;
+    }
+
+    return i;
+#endif
+}
+
+
+//-----------------------------------------------------------------------------
+// Search an ordered table of n elements, starting from the result i of a
+// previous search. For inputs which arrive in (nearly) sorted order, such as
+// log files and sweeps, the table is walked from there in merge fashion, so
+// n lookups cost O(n + S) instead of O(n log S). Returns the same i as
+// search(), x must be within the range [xs[0], xs[n-1]].
+//
+// The time of a walk depends on the distance to the previous result, so with
+// MAP_CONSTANT_TIME_SEARCH search() is used instead.
+//-----------------------------------------------------------------------------
+
+template<typename X>
+inline int walk( const X* xs, int n, X x, int i )
+{
+#ifdef MAP_CONSTANT_TIME_SEARCH
+    (void)i;
+    return search( xs, n, x );
+#else
+    if ( i < 0 )    i = 0;
+    if ( i > n-2 )  i = n-2;
+
+    while ( i < n-2 && x >= xs[i+1] )   i++;    // forward
+    while ( i > 0   && x <  xs[i]   )   i--;    // backward
+
+    return i;
+#endif
+}
+
+
+//-----------------------------------------------------------------------------
+// Position of the previous lookup in a map, for lookups using walk().
+//-----------------------------------------------------------------------------
+
+struct MapCursor
+{
+                  MapCursor() : i(0), j(0) {}
+
+    int           i;                    // x or x1 axis
+    int           j;                    // x2 axis
+};
+
+
+//-----------------------------------------------------------------------------
+// Operations on a single element of a map, applied thru visitAt(). The map
+// cores resolve a byte offset in their wire layout to an element; these
+// decide what is done with it.
+//-----------------------------------------------------------------------------
+
+struct MapSendOp
+{
+                  MapSendOp( ExtendedSerial& s ) : s(s) {}
+
+    template<typename T>
+    size_t        operator()( T& x )    { return s.send( x ); }
+
+    ExtendedSerial& s;
+};
+
+struct MapReceiveOp
+{
+                  MapReceiveOp( ExtendedSerial& s ) : s(s) {}
+
+    template<typename T>
+    size_t        operator()( T& x )    { return s.receive( x ); }
+
+    ExtendedSerial& s;
+};
+
+struct MapSizeOp
+{
+    template<typename T>
+    size_t        operator()( T& )      { return WireType<T>::size; }
+};
+
+
 //-----------------------------------------------------------------------------
 // 2D lookup table / fuel map. X axis (xs) must be sorted in ascending order.
+//
+// Map2DCore is the lean version, without virtual methods and receive state,
+// for tables that are never accessed thru a Map&. Use Map2D for those.
 //-----------------------------------------------------------------------------
 
 template<int S, typename X, typename Y> // S: size, X,Y: data types
-class Map2D : public Map
+class Map2DCore
 {
 public:
-                  Map2D()
+    typedef X     x_type;
+    typedef Y     y_type;
+
+                  Map2DCore() : valid(0)
                   {
                       for( int i=0; i<S; i++ ) { xs[i] = 0; ys[i] = 0; }
                   }
@@ -153,31 +316,34 @@ public:
     int           xSize()   const       { return S; }
     int           ySize()   const       { return S; }
     int           memSize() const       { return S*(sizeof(X)+sizeof(Y)); }
+    int           rowSize() const       { return sizeof(Y); }
 
-    void          setXs( const X* xss ) { memcpy( xs, xss, S*sizeof(X) ); }
+    void          setXs( const X* xss ) { memcpy( xs, xss, S*sizeof(X) ); modified(); }
 
     void          setXsFromFloat( const float* xss )
                   {
                       for( int i=0; i<S; i++ ) { xs[i] = static_cast<X>(xss[i]); }
+                      modified();
                   }                        
 
-    int           getXInt( int i )      { return 0<=i<S ? static_cast<int>(xs[i])   : 0; }
+    int           getXInt( int i )      { return i >= 0 && i < S ? static_cast<int>(xs[i])   : 0; }
 
-    float         getXFloat( int i )    { return 0<=i<S ? static_cast<float>(xs[i]) : 0; }
+    float         getXFloat( int i )    { return i >= 0 && i < S ? static_cast<float>(xs[i]) : 0; }
 
-    void          setYs( const Y* yss ) { memcpy( ys, yss, S*sizeof(Y) ); }
+    void          setYs( const Y* yss ) { memcpy( ys, yss, S*sizeof(Y) ); modified(); }
 
     void          setYsFromFloat( const float* yss )
                   {
                       for( int i=0; i<S; i++ ) { ys[i] = static_cast<Y>(yss[i]); }
+                      modified();
                   }
 
-    int           getYInt( int i )      { return 0<=i<S ? static_cast<int>(ys[i])   : 0; }
+    int           getYInt( int i )      { return i >= 0 && i < S ? static_cast<int>(ys[i])   : 0; }
 
-    float         getYFloat( int i )    { return 0<=i<S ? static_cast<float>(ys[i]) : 0; }
+    float         getYFloat( int i )    { return i >= 0 && i < S ? static_cast<float>(ys[i]) : 0; }
 
 #ifdef AVR
-    virtual bool  updateEeprom(uint8_t* dest) const
+    bool          updateEeprom(uint8_t* dest) const
                   {
                     if( !eeprom_is_ready() ) return false;
 
@@ -187,12 +353,13 @@ public:
                     return true;
                   }
 
-    virtual bool  readEeprom(const uint8_t* src)
+    bool          readEeprom(const uint8_t* src)
                   {
                     if( !eeprom_is_ready() ) return false;
 
                     eeprom_read_block( xs, src, sizeof(xs) );
                     eeprom_read_block( ys, src+ sizeof(xs), sizeof(ys) );
+                    modified();
 
                     return true;
                   }
@@ -200,26 +367,28 @@ public:
 
 #ifdef ARDUINO    // Initialization from array in PROGMEM
 
-    void          setXs_P( const X* xss ) { memcpy_P( xs, xss, S*sizeof(X) ); }
+    void          setXs_P( const X* xss ) { memcpy_P( xs, xss, S*sizeof(X) ); modified(); }
 
     void          setXsFromFloat_P( const float* xss )
                   {
                       for( int i=0; i<S; i++ ) {
                         xs[i] = static_cast<X>(pgm_read_float_near(xss+i)); }
+                      modified();
                   }
 
-    void          setYs_P( const Y* yss ) { memcpy_P( ys, yss, S*sizeof(Y) ); }
+    void          setYs_P( const Y* yss ) { memcpy_P( ys, yss, S*sizeof(Y) ); modified(); }
                        
     void          setYsFromFloat_P( const float* yss )
                   {
                       for( int i=0; i<S; i++ )
                           { ys[i] = static_cast<Y>( pgm_read_float_near(yss+i) ); }
+                      modified();
                   }
 #endif
 
-    virtual void  printTo( Print& p, const uint8_t tabsize = 4, const char delim = ' ' )
+    void          printTo( Print& p, const uint8_t tabsize = 4, const char delim = ' ' )
                   {
-                    const char spaceChar=' ';
+                    char buf[TO_STRING_SIZE];
                     
 //                      p.println( table title ); // TODO
 
@@ -227,15 +396,12 @@ public:
 
                     for (int x = 0; x < S; x++)
                     {
-                      const char* _x = toString(xs[x]);
-
-                      for( uint16_t idx=0; idx<tabsize-strlen(_x); idx++)    p.write(spaceChar);
+                      const char* _x = toString(buf, sizeof(buf), xs[x], tabsize);
 
                       p.print(_x);// Vertical Bins
                       p.write(delim);
 
-                      const char* value = toString(ys[x]);
-                      for( uint16_t idx=0; idx<tabsize-strlen(value); idx++) p.write(spaceChar);
+                      const char* value = toString(buf, sizeof(buf), ys[x], tabsize);
 
                       p.print(value);
 
@@ -245,195 +411,469 @@ public:
                     p.println();
                   }
 
-    virtual void  sendTo( ExtendedSerial& s)
+    void          sendTo( ExtendedSerial& s)
+                  {
+                    s.beginSend();
+                    s.send( xs, S );
+                    s.send( ys, S );
+                    s.endSend();
+                  }
+
+    // Send or receive the element at byte offset 'offset' of the layout used
+    // by sendTo. Returns the number of bytes transferred, 0 if not available.
+    size_t        sendAt( ExtendedSerial& s, map_offset_t offset )
+                  {
+                    MapSendOp op(s);
+                    return visitAt( op, offset );
+                  }
+
+    size_t        receiveAt( ExtendedSerial& s, map_offset_t offset )
                   {
-                    for (int i = 0; i < S; i++) { s.send( xs[i] ); }
-                    for (int i = 0; i < S; i++) { s.send( ys[i] ); }
+                    MapReceiveOp op(s);
+                    modified();
+                    return visitAt( op, offset );
                   }
 
-    virtual bool  receiveFrom( ExtendedSerial& s) 
-				  {
+    // Apply op to the element at byte offset 'offset' of the wire layout.
+    template<class Op>
+    size_t        visitAt( Op& op, map_offset_t offset )
+                  {
                     const size_t xend = S*sizeof(X);
                     const size_t yend = xend + S*sizeof(Y);
-                      
-                    while( (curOffset < xend) && !receiveDone() )
+
+                    if( offset < xend ) return op( xs[offset / sizeof(X)] );
+                    if( offset < yend ) return op( ys[(offset - xend) / sizeof(Y)] );
+
+                    return 0;
+                  }
+
+
+    const X&      x( int i ) const      { return xs[i]; }
+    const Y&      y( int i ) const      { return ys[i]; }
+
+    // Find i, such that xs[i] <= x < xs[i+1], after clamping x to the axis,
+    // and the fraction dx of x between xs[i] and xs[i+1].
+    template<typename T>
+    void          locate( X x, int& i, T& dx ) const
+                  {
+                    if (x < xs[0])      { x = xs[0];   } // minimum
+                    if (x > xs[S-1])    { x = xs[S-1]; } // maximum
+
+                    i  = search( xs, S, x );
+                    dx = fraction<T>( x, xs[i], xs[i+1] );
+                  }
+
+    Y             f( X x )              // approximate f(x)
+                  {
+                    if (x < xs[0])                      // minimum
                     {
-                       int idx = curOffset / sizeof(X);
-                       size_t recvd = s.receive(xs[idx]);
+                      MAP_HEAT( heat.hitCell(0) );
+                      MAP_TRACE_POINT( TRACE_LOOKUP_2D, 0, (uintptr_t)this );
+                      return ys[0];
+                    }
+                    if (x > xs[S-1])                    // maximum
+                    {
+                      MAP_HEAT( heat.hitCell(S-1) );
+                      MAP_TRACE_POINT( TRACE_LOOKUP_2D, S-2, (uintptr_t)this );
+                      return ys[S-1];
+                    }
 
-                       if( recvd) { curOffset += recvd; }
-                       else return false; // avoid infinite loop when we receive nothing.
+                    int i = search( xs, S, x );
+
+                    MAP_HEAT( heat.hit( i, heatFraction( x, xs[i], xs[i+1] ) ) );
+                    MAP_TRACE_POINT( TRACE_LOOKUP_2D, i, (uintptr_t)this );
+
+                    return interpolate( x, xs[i], xs[i+1], ys[i], ys[i+1]);
+
+                  }
+
+    // approximate f(x) for a stream of (nearly) sorted xs. The cursor keeps
+    // the position in the table between calls.
+    Y             f( X x, MapCursor& c )
+                  {
+                    if (x < xs[0])                      // minimum
+                    {
+                      MAP_HEAT( heat.hitCell(0) );
+                      MAP_TRACE_POINT( TRACE_LOOKUP_2D, 0, (uintptr_t)this );
+                      c.i = 0;
+                      return ys[0];
+                    }
+                    if (x > xs[S-1])                    // maximum
+                    {
+                      MAP_HEAT( heat.hitCell(S-1) );
+                      MAP_TRACE_POINT( TRACE_LOOKUP_2D, S-2, (uintptr_t)this );
+                      c.i = S-2;
+                      return ys[S-1];
                     }
 
-                    while( (curOffset < yend) && !receiveDone() )
+                    int i = c.i = walk( xs, S, x, c.i );
+
+                    MAP_HEAT( heat.hit( i, heatFraction( x, xs[i], xs[i+1] ) ) );
+                    MAP_TRACE_POINT( TRACE_LOOKUP_2D, i, (uintptr_t)this );
+
+                    return interpolate( x, xs[i], xs[i+1], ys[i], ys[i+1]);
+                  }
+
+    // As f(x,c), but without counting the lookup in the heatmap, e.g. to
+    // fill a cache. c.i is set to the segment used.
+    Y             lookup( X x, MapCursor& c ) const
+                  {
+                    if (x < xs[0])      { c.i = 0; return ys[0];   } // minimum
+                    if (x > xs[S-1])    { c.i = S-2; return ys[S-1]; } // maximum
+
+                    int i = c.i = walk( xs, S, x, c.i );
+
+                    return interpolate( x, xs[i], xs[i+1], ys[i], ys[i+1]);
+                  }
+
+    // approximate y[k] = f(x[k]) for n (nearly) sorted xs
+    void          f( const X* x, Y* y, int n )
+                  {
+                    MapCursor c;
+
+                    for( int k=0; k<n; k++ ) { y[k] = f( x[k], c ); }
+                  }
+
+    // approximate f(x) and its derivative dy/dx, from the same cell and
+    // weights. Outside the axis f(x) is constant, so dy/dx is 0 there.
+    Y             f_with_gradient( X x, typename InterpolType<Y>::type& dydx )
+                  {
+                    typedef typename InterpolType<Y>::type T;
+
+                    int i; T dx;
+                    locate( x, i, dx );
+
+                    MAP_HEAT( heat.hit( i, heatWeight( dx ) ) );
+
+                    T   y_1 = castTo<T>(ys[i]);
+                    T   y_2 = castTo<T>(ys[i+1]);
+
+                    if( x < xs[0] || x > xs[S-1] )  dydx = 0.0f;
+                    else dydx = (y_2 - y_1) / (castTo<T>(xs[i+1]) - castTo<T>(xs[i]));
+
+                    return castTo<Y>( lerp( dx, y_1, y_2 ) );
+                  }
+
+    // Returns 1 if the ys are strictly ascending, -1 if strictly descending
+    // and 0 otherwise. Determined once after each modification of the map.
+    int8_t        yOrder()
+                  {
+                    if( !(valid & VALID_ORDER) )
                     {
-                       int idx = (curOffset - xend) / sizeof(Y);
-                       size_t recvd = s.receive(ys[idx]);
+                      int up = 0, down = 0;
 
-                       if( recvd) { curOffset += recvd; }
-                       else return false; // avoid infinite loop when we receive nothing.
+                      for( int i=0; i<S-1; i++ )
+                      {
+                        if( ys[i] < ys[i+1] )       up++;
+                        else if( ys[i] > ys[i+1] )  down++;
+                      }
+
+                      order  = up == S-1 ? 1 : down == S-1 ? -1 : 0;
+                      valid |= VALID_ORDER;
                     }
 
-                    return receiveDone();   // bytesReceived >= bytesToReceive
-				  }
+                    return order;
+                  }
 
+    bool          isMonotonic()         { return yOrder() != 0; }
 
-    Y             f( X x )              // approximate f(x)
+    // approximate x, such that f(x) = y, for monotonic maps. The ys are
+    // searched using bisection, so a single table serves both directions.
+    // y is clamped to the range of the ys. Returns xs[0] if the map is not
+    // monotonic.
+    X             inverse( Y y )
                   {
-                    if (x < xs[0])      { return ys[0];   } // minimum
-                    if (x > xs[S-1])    { return ys[S-1]; } // maximum
+                    typedef typename InterpolType<X>::type T;
+
+                    const int8_t o = yOrder();
+
+                    if( o == 0 )        { return xs[0]; }
+
+                    if( o > 0 ? y <= ys[0]   : y >= ys[0]   ) { return xs[0];   }
+                    if( o > 0 ? y >= ys[S-1] : y <= ys[S-1] ) { return xs[S-1]; }
 
                     int i=0, j=S-1, k;
 
-                    // find i, such that xs[i] <= x < xs[j] using bisection
+                    // find i, such that y lies between ys[i] and ys[i+1]
                     while ( j - i > 1) {
                         k = (i+j) >> 1;  // k = (i+j)/2
 
-                        if ( x >= xs[k] )   i = k;
-                        else                j = k;
+                        if ( o > 0 ? y >= ys[k] : y <= ys[k] )  i = k;
+                        else                                    j = k;
                     }
 
-                    return interpolate( x, xs[i], xs[i+1], ys[i], ys[i+1]);
+                    T   dy = fraction<T>( y, ys[i], ys[i+1] );
 
+                    return castTo<X>( lerp( dy, xs[i], xs[i+1] ) );
                   }
 
+    void          modified()            { valid = 0; }
+
+#ifdef MAP_HEATMAP
+    MapHeatmap<S>&        heatmap()     { return heat; }
+#endif
+
 protected:
 
     X             xs[S];
     Y             ys[S];
 
+#ifdef MAP_HEATMAP
+    MapHeatmap<S> heat;                 // cells visited by f()
+#endif
+
+    uint8_t       valid;                // MapValid bits
+    int8_t        order;                // see yOrder()
+
 };
 
 
 //-----------------------------------------------------------------------------
-// 3D lookup table / fuel map. X axis must be sorted in ascending order.
+// Storage layouts for the R x C cells of a 3D map. The bilinear interpolation
+// reads the four corners of a cell, (i,j), (i+1,j), (i,j+1) and (i+1,j+1).
+// With a row major layout these lie in two rows, which may be in different
+// cache lines for large tables. The tiled and Morton layouts keep them close
+// together. Tiles at the edges are padded, so 'size' may exceed R*C.
+//
+// The layout only affects memory. The wire and EEPROM order is row major,
+// regardless of the layout.
 //-----------------------------------------------------------------------------
 
-template<int R, int C, typename X, typename Y> // R,C: size, X,Y: data type
-class Map3D : public Map
+template<int R, int C>
+struct RowMajor
+{
+    enum          { size = R*C, rowMajor = 1 };
+    static int    index( int i, int j ) { return i*C + j; }
+};
+
+template<int R, int C>
+struct ColMajor
+{
+    enum          { size = R*C, rowMajor = 0 };
+    static int    index( int i, int j ) { return j*R + i; }
+};
+
+template<int R, int C>
+struct Tiled2x2
+{
+    enum          { TC = (C+1)/2, size = ((R+1)/2)*TC*4, rowMajor = 0 };
+    static int    index( int i, int j )
+                  { return ((i>>1)*TC + (j>>1))*4 + (i&1)*2 + (j&1); }
+};
+
+template<int R, int C>
+struct Tiled4x4
+{
+    enum          { TC = (C+3)/4, size = ((R+3)/4)*TC*16, rowMajor = 0 };
+    static int    index( int i, int j )
+                  { return ((i>>2)*TC + (j>>2))*16 + (i&3)*4 + (j&3); }
+};
+
+// Morton (Z) order: the bits of i and j are interleaved. Up to 256 x 256.
+
+template<int I, int J>
+struct MortonIndex
+{
+    enum          { value = ((I&1)<<1) + (J&1) + (MortonIndex<(I>>1),(J>>1)>::value << 2) };
+};
+
+template<>
+struct MortonIndex<0,0>
+{
+    enum          { value = 0 };
+};
+
+template<int R, int C>
+struct Morton
+{
+    enum          { size = MortonIndex<R-1,C-1>::value + 1, rowMajor = 0 };
+
+    static int    spread( int v )       // abcdefgh -> 0a0b0c0d0e0f0g0h
+                  {
+                    v &= 0xFF;
+                    v  = (v | (v << 4)) & 0x0F0F;
+                    v  = (v | (v << 2)) & 0x3333;
+                    v  = (v | (v << 1)) & 0x5555;
+                    return v;
+                  }
+
+    static int    index( int i, int j ) { return (spread(i) << 1) | spread(j); }
+};
+
+
+//-----------------------------------------------------------------------------
+// 3D lookup table / fuel map. X axes must be sorted in ascending order.
+//
+// The x1 and x2 axes may be of different types, for example an int16_t rpm
+// axis and an uint8_t load axis. X2 defaults to X1.
+//
+// The storage layout L of the cells defaults to RowMajor, see above.
+//
+// Map3DCore is the lean version, without virtual methods and receive state,
+// for tables that are never accessed thru a Map&. Use Map3D for those.
+//-----------------------------------------------------------------------------
+
+template<int R, int C, typename X1, typename Y, typename X2 = X1,
+         template<int,int> class L = RowMajor>
+class Map3DCore                         // R,C: size, X1,X2,Y: data type
 {
 public:
-                  Map3D()
+    typedef X1      x1_type;
+    typedef X2      x2_type;
+    typedef Y       y_type;
+    typedef L<R,C>  Layout;
+
+                  Map3DCore() : valid(0)
                   {
                       for( int i=0; i<R;   i++ ) { x1s[i] = 0; }
                       for( int i=0; i<C;   i++ ) { x2s[i] = 0; }
-                      for( int i=0; i<R*C; i++ ) { ys[i]  = 0; }
+                      for( int i=0; i<Layout::size; i++ ) { ys[i] = 0; }
                   }                        
 
     int           x1Size()  const    { return R;   }
     int           x2Size()  const    { return C;   }
     int           ySize()   const    { return R*C; }
-    int           memSize() const    { return (R+C)*sizeof(X) + (R*C)*sizeof(Y);}
+    int           memSize() const    { return R*sizeof(X1) + C*sizeof(X2) + (R*C)*sizeof(Y);}
+    int           rowSize() const    { return C*sizeof(Y); }
 
 
-    void          setX1s( const X* x1ss )
-                        { memcpy( x1s, x1ss, R*sizeof(X) ); }
+    void          setX1s( const X1* x1ss )
+                        { memcpy( x1s, x1ss, R*sizeof(X1) ); modified(); }
 
-    void          setX2s( const X* x2ss ) 
-                        { memcpy( x2s, x2ss, C*sizeof(X) ); }
+    void          setX2s( const X2* x2ss ) 
+                        { memcpy( x2s, x2ss, C*sizeof(X2) ); modified(); }
 
     void          setX1sFromFloat( const float* xss )
                   {
-                      for( int i=0; i<R; i++ )  { x1s[i] = static_cast<X>(xss[i]); }
+                      for( int i=0; i<R; i++ )  { x1s[i] = static_cast<X1>(xss[i]); }
+                      modified();
                   }
 
     void          setX2sFromFloat( const float* xss )
                   {
-                      for( int i=0; i<C; i++ )  { x2s[i] = static_cast<X>(xss[i]); }
+                      for( int i=0; i<C; i++ )  { x2s[i] = static_cast<X2>(xss[i]); }
+                      modified();
                   }
 
-    int           getX1Int( int i )   { return 0<=i<R ? static_cast<int>(x1s[i])   : 0; }
-    int           getX2Int( int i )   { return 0<=i<C ? static_cast<int>(x2s[i])   : 0; }
+    int           getX1Int( int i )   { return i >= 0 && i < R ? static_cast<int>(x1s[i])   : 0; }
+    int           getX2Int( int i )   { return i >= 0 && i < C ? static_cast<int>(x2s[i])   : 0; }
 
-    float         getX1Float( int i ) { return 0<=i<R ? static_cast<float>(x1s[i]) : 0; }
-    float         getX2Float( int i ) { return 0<=i<C ? static_cast<float>(x2s[i]) : 0; }
+    float         getX1Float( int i ) { return i >= 0 && i < R ? static_cast<float>(x1s[i]) : 0; }
+    float         getX2Float( int i ) { return i >= 0 && i < C ? static_cast<float>(x2s[i]) : 0; }
 
     void          setYs( const Y* yss )
-                        { memcpy( ys, yss, R*C*sizeof(Y) ); }
+                  {
+                      if( Layout::rowMajor ) { memcpy( ys, yss, R*C*sizeof(Y) ); }
+                      else for( int i=0; i<R*C; i++ ) { cell(i/C,i%C) = yss[i]; }
+                      modified();
+                  }
 
     void          setYsFromFloat( const float* yss )
                   {
                       for( int i=0; i<R*C; i++ ) 
-                        { ys[i] = static_cast<Y>(yss[i]); }
+                        { cell(i/C,i%C) = static_cast<Y>(yss[i]); }
+                      modified();
                   }
 
     int           getYInt( int i, int j )
-                      { return 0<=i<R && 0<=j<C ? static_cast<int>(ys[i][j]) : 0; }
+                      { return i >= 0 && i < R && j >= 0 && j < C ? static_cast<int>(cell(i,j)) : 0; }
 
     float         getYFloat( int i, int j )
-                      { return 0<=i<R && 0<=j<C ? static_cast<float>(ys[i][j]) : 0; }
+                      { return i >= 0 && i < R && j >= 0 && j < C ? static_cast<float>(cell(i,j)) : 0; }
 
 #ifdef AVR
-    virtual bool  updateEeprom(uint8_t* dest) const
+    bool          updateEeprom(uint8_t* dest) const
                   {
                     if( !eeprom_is_ready() ) return false;
 
                     eeprom_update_block( x1s, dest, sizeof(x1s) );
                     eeprom_update_block( x2s, dest+sizeof(x1s), sizeof(x2s) );
-                    eeprom_update_block( ys,  dest+sizeof(x1s)+sizeof(x2s), sizeof(ys) );
+                    dest += sizeof(x1s)+sizeof(x2s);
+
+                    if( Layout::rowMajor ) { eeprom_update_block( ys, dest, R*C*sizeof(Y) ); }
+                    else
+                    {
+                      for( int i=0; i<R*C; i++, dest+=sizeof(Y) )
+                        { eeprom_update_block( &cell(i/C,i%C), dest, sizeof(Y) ); }
+                    }
 
                     return true;
                   }
 
-    virtual bool  readEeprom(const uint8_t* src)
+    bool          readEeprom(const uint8_t* src)
                   {
                     if( !eeprom_is_ready() ) return false;
 
                     eeprom_read_block( x1s, src, sizeof(x1s) );
                     eeprom_read_block( x2s, src+sizeof(x1s), sizeof(x2s) );
-                    eeprom_read_block( ys,  src+sizeof(x1s)+sizeof(x2s), sizeof(ys) );
+                    src += sizeof(x1s)+sizeof(x2s);
+
+                    if( Layout::rowMajor ) { eeprom_read_block( ys, src, R*C*sizeof(Y) ); }
+                    else
+                    {
+                      for( int i=0; i<R*C; i++, src+=sizeof(Y) )
+                        { eeprom_read_block( &cell(i/C,i%C), src, sizeof(Y) ); }
+                    }
 
+                    modified();
                     return true;
                   }
 #endif
 #ifdef ARDUINO    // Initialize from array in PROGMEM
 
-    void          setX1s_P( const X* x1ss ) { memcpy_P( x1s, x1ss, R*sizeof(X) ); }
-    void          setX2s_P( const X* x2ss ) { memcpy_P( x2s, x2ss, C*sizeof(X) ); }
+    void          setX1s_P( const X1* x1ss ) { memcpy_P( x1s, x1ss, R*sizeof(X1) ); modified(); }
+    void          setX2s_P( const X2* x2ss ) { memcpy_P( x2s, x2ss, C*sizeof(X2) ); modified(); }
 
     void          setX1sFromFloat_P( const float* xss )
                   {
                       for( int i=0; i<R; i++ )
-                        { x1s[i] = static_cast<X>(pgm_read_float_near(xss+i)); }
+                        { x1s[i] = static_cast<X1>(pgm_read_float_near(xss+i)); }
+                      modified();
                   }
 
     void          setX2sFromFloat_P( const float* xss )
                   {
                       for( int i=0; i<C; i++ )
-                        { x2s[i] = static_cast<X>(pgm_read_float_near(xss+i)); }
+                        { x2s[i] = static_cast<X2>(pgm_read_float_near(xss+i)); }
+                      modified();
                   }
 
-    void          setYs_P( const Y* yss ) { memcpy_P( ys, yss, R*C*sizeof(Y) ); }
+    void          setYs_P( const Y* yss )
+                  {
+                      if( Layout::rowMajor ) { memcpy_P( ys, yss, R*C*sizeof(Y) ); }
+                      else for( int i=0; i<R*C; i++ )
+                          { memcpy_P( &cell(i/C,i%C), yss+i, sizeof(Y) ); }
+                      modified();
+                  }
 
     void          setYsFromFloat_P( const float* yss )
                   {
                       for( int i=0; i<R*C; i++ ) 
-                          { ys[i] = static_cast<Y>( pgm_read_float_near(yss+i) ); }
+                          { cell(i/C,i%C) = static_cast<Y>( pgm_read_float_near(yss+i) ); }
+                      modified();
                   }
 
 
 #endif
 
-    virtual void  printTo( Print& p, const uint8_t tabsize = 4, const char delim = ' ' )
+    void          printTo( Print& p, const uint8_t tabsize = 4, const char delim = ' ' )
                   {
                     const char spaceChar=' ';
+                    char       buf[TO_STRING_SIZE];
                     
 //                  p.println( table title ); // TODO
 
                     p.println();
                     for( int x = 0; x < R; x++ )
                     {
-                      const char* _x1 = toString(x1s[x]);
-
-                      for( int idx=0; idx<tabsize-strlen(_x1); idx++)    p.write(spaceChar);
+                      const char* _x1 = toString(buf, sizeof(buf), x1s[x], tabsize);
 
                       p.print(_x1);             // Vertical
                       p.write(delim);
 
                       for (int y = 0; y < C; y++)
                       {
-                        const char* value = toString(ys[x][y]);
-                        for( int idx=0; idx<tabsize-strlen(value); idx++) p.write(spaceChar);
+                        const char* value = toString(buf, sizeof(buf), cell(x,y), tabsize);
 
                         p.print(value);
                         p.write(delim);
@@ -445,8 +885,7 @@ public:
 
                     for (int x = 0; x < C; x++) // Horizontal 
                     {
-                      const char* _x2 = toString(x2s[x]);
-                      for( uint16_t idx=0; idx<tabsize-strlen(_x2); idx++)  p.write(spaceChar);
+                      const char* _x2 = toString(buf, sizeof(buf), x2s[x], tabsize);
 
                       p.print(_x2);
                       p.write(delim);
@@ -454,105 +893,499 @@ public:
                     p.println();
                   }
 
-    virtual void  sendTo( ExtendedSerial& s)
+    void          sendTo( ExtendedSerial& s)
                   {
-                    for (int i = 0; i < R; i++) { s.send( x1s[i] ); }
-                    for (int i = 0; i < C; i++) { s.send( x2s[i] ); }
+                    s.beginSend();
+                    s.send( x1s, R );
+                    s.send( x2s, C );
 
                     //for (int x = 0; x < R; x++)
                     for (int x = R-1; x >=0; x--)  // TS likes rows in reverse order
                     {
-                      for (int y = 0; y < C; x++)
-                        { s.send( ys[x][y] ); }
+                      if( Layout::rowMajor ) { s.send( &cell(x,0), C ); continue; }
+
+                      for (int y = 0; y < C; y++)
+                        { s.send( cell(x,y) ); }
                     }
+                    s.endSend();
                   }
 
-    virtual bool  receiveFrom( ExtendedSerial& s) 
-				  {
-                    const size_t x1end = R*sizeof(X);
-                    const size_t x2end = x1end + C*sizeof(X);
-                    const size_t yend  = x2end + R*C*sizeof(Y);
-                      
-                    while( (curOffset < x1end) && !receiveDone() )
-                    {
-                       int idx = curOffset / sizeof(X);
-
-                       size_t recvd = s.receive(x1s[idx]);
-
-                       if( recvd) { curOffset += recvd; }
-                       else return false; // avoid infinite loop when we receive nothing.
-                    }
+    // Send or receive the element at byte offset 'offset' of the layout used
+    // by sendTo. Returns the number of bytes transferred, 0 if not available.
+    size_t        sendAt( ExtendedSerial& s, map_offset_t offset )
+                  {
+                    MapSendOp op(s);
+                    return visitAt( op, offset );
+                  }
 
-                    while( (curOffset < x2end) && !receiveDone() )
-                    {
-                       int idx = (curOffset - x1end) / sizeof(X);
+    size_t        receiveAt( ExtendedSerial& s, map_offset_t offset )
+                  {
+                    MapReceiveOp op(s);
+                    modified();
+                    return visitAt( op, offset );
+                  }
 
-                       size_t recvd = s.receive(x2s[idx]);
+    // Apply op to the element at byte offset 'offset' of the wire layout.
+    template<class Op>
+    size_t        visitAt( Op& op, map_offset_t offset )
+                  {
+                    const size_t x1end = R*sizeof(X1);
+                    const size_t x2end = x1end + C*sizeof(X2);
+                    const size_t yend  = x2end + R*C*sizeof(Y);
 
-                       if( recvd) { curOffset += recvd; }
-                       else return false; // avoid infinite loop when we receive nothing.
-                    }
+                    if( offset < x1end ) return op( x1s[offset / sizeof(X1)] );
+                    if( offset < x2end ) return op( x2s[(offset - x1end) / sizeof(X2)] );
 
-                    while( (curOffset < yend) && !receiveDone() )
+                    if( offset < yend )
                     {
-                       int idx = (curOffset - x2end) / sizeof(Y);
+                       int idx = (offset - x2end) / sizeof(Y);
 
                        //int idx1 = idx/C; 
                        int idx1 = R - 1 - idx/C;  // TS likes the rows in reverse order
                        int idx2 = idx%C;
 
-                       size_t recvd = s.receive(ys[idx1][idx2]);
-
-                       if( recvd) { curOffset += recvd; }
-                       else return false; // avoid infinite loop when we receive nothing.
+                       return op( cell(idx1,idx2) );
                     }
 
-                    return receiveDone();   // bytesReceived >= bytesToReceive
-				  }
+                    return 0;
+                  }
 
 
-    Y             f( X x1, X x2 )
+    const X1&     x1( int i ) const  { return x1s[i]; }
+    const X2&     x2( int j ) const  { return x2s[j]; }
+    // Call modified() after writing cells thru cell(), so cached data such
+    // as the CRC is refreshed.
+    Y&            cell( int i, int j )  { return ys[Layout::index(i,j)]; }
+    const Y&      cell( int i, int j ) const
+                                        { return ys[Layout::index(i,j)]; }
+    const Y&      y( int i, int j ) const
+                                     { return cell(i,j); }
+
+    // Find the cell (i,j) containing (x1,x2), after clamping to the axes,
+    // and the fractions dx1 and dx2 within that cell.
+    template<typename T>
+    void          locate( X1 x1, X2 x2, int& i, int& j, T& dx1, T& dx2 ) const
                   {
                     if (x1 < x1s[0])      { x1 = x1s[0];   } // minimum
                     if (x1 > x1s[R-1])    { x1 = x1s[R-1]; } // maximum
                     if (x2 < x2s[0])      { x2 = x2s[0];   } // minimum
                     if (x2 > x2s[C-1])    { x2 = x2s[C-1]; } // maximum
 
-                    int i=0, j=R-1, m;
+                    i   = search( x1s, R, x1 );
+                    j   = search( x2s, C, x2 );
+                    dx1 = fraction<T>( x1, x1s[i], x1s[i+1] );
+                    dx2 = fraction<T>( x2, x2s[j], x2s[j+1] );
+                  }
 
-                    // find i, such that x1s[i] <= x1 < x1s[j] using bisection
-                    while ( j - i > 1) {
-                        m = (i+j) >> 1;     // m = (i+j)/2
+    Y             f( X1 x1, X2 x2 )
+                  {
+                    if (x1 < x1s[0])      { x1 = x1s[0];   } // minimum
+                    if (x1 > x1s[R-1])    { x1 = x1s[R-1]; } // maximum
+                    if (x2 < x2s[0])      { x2 = x2s[0];   } // minimum
+                    if (x2 > x2s[C-1])    { x2 = x2s[C-1]; } // maximum
 
-                        if ( x1 >= x1s[m] ) i = m;
-                        else                j = m;
-                    }
+                    // find i, such that x1s[i] <= x1 < x1s[i+1] and
+                    // find j, such that x2s[j] <= x2 < x2s[j+1]
+                    int i = search( x1s, R, x1 );
+                    int j = search( x2s, C, x2 );
 
-                    int k=C-1; 
-                    j=0;
+                    MAP_HEAT( heat.hit( i, j, heatFraction( x1, x1s[i], x1s[i+1] ),
+                                              heatFraction( x2, x2s[j], x2s[j+1] ) ) );
+                    MAP_TRACE_POINT( TRACE_LOOKUP_3D, i + 256*j, (uintptr_t)this );
 
-                    // find j, such that x2s[j] <= x2 < x2s[k] using bisection
-                    while ( k - j > 1) {
-                        m = (j+k) >> 1;     // m = (j+k)/2
+                    return interpolate( x1,       x2,
+                                        x1s[i],   x1s[i+1],   x2s[j],       x2s[j+1],
+                                        cell(i,j), cell(i+1,j), cell(i+1,j+1), cell(i,j+1));
+                  }
 
-                        if ( x2 >= x2s[m] ) j = m;
-                        else                k = m;
-                    }
+    // approximate f(x1,x2) for a stream of (nearly) sorted inputs. The
+    // cursor keeps the position in the table between calls.
+    Y             f( X1 x1, X2 x2, MapCursor& c )
+                  {
+                    if (x1 < x1s[0])      { x1 = x1s[0];   } // minimum
+                    if (x1 > x1s[R-1])    { x1 = x1s[R-1]; } // maximum
+                    if (x2 < x2s[0])      { x2 = x2s[0];   } // minimum
+                    if (x2 > x2s[C-1])    { x2 = x2s[C-1]; } // maximum
+
+                    int i = c.i = walk( x1s, R, x1, c.i );
+                    int j = c.j = walk( x2s, C, x2, c.j );
+
+                    MAP_HEAT( heat.hit( i, j, heatFraction( x1, x1s[i], x1s[i+1] ),
+                                              heatFraction( x2, x2s[j], x2s[j+1] ) ) );
+                    MAP_TRACE_POINT( TRACE_LOOKUP_3D, i + 256*j, (uintptr_t)this );
 
                     return interpolate( x1,       x2,
                                         x1s[i],   x1s[i+1],   x2s[j],       x2s[j+1],
-                                        ys[i][j], ys[i+1][j], ys[i+1][j+1], ys[i][j+1]);
+                                        cell(i,j), cell(i+1,j), cell(i+1,j+1), cell(i,j+1));
+                  }
+
+    // approximate y[k] = f(x1[k],x2[k]) for n (nearly) sorted inputs
+    void          f( const X1* x1, const X2* x2, Y* y, int n )
+                  {
+                    MapCursor c;
+
+                    for( int k=0; k<n; k++ ) { y[k] = f( x1[k], x2[k], c ); }
                   }
 
+    // approximate f(x1,x2) and its partial derivatives dy/dx1 and dy/dx2,
+    // from the same cell and weights. Outside an axis f is constant in that
+    // direction, so the corresponding derivative is 0 there.
+    Y             f_with_gradient( X1 x1, X2 x2,
+                                   typename InterpolType<Y>::type& dydx1,
+                                   typename InterpolType<Y>::type& dydx2 )
+                  {
+                    typedef typename InterpolType<Y>::type T;
+
+                    T   one = 1.0f; // avoid ambigious operator overload
+
+                    int i, j; T dx1, dx2;
+                    locate( x1, x2, i, j, dx1, dx2 );
+
+                    MAP_HEAT( heat.hit( i, j, heatWeight( dx1 ), heatWeight( dx2 ) ) );
+
+                    T   y_1 = castTo<T>(cell(i,j));
+                    T   y_2 = castTo<T>(cell(i+1,j));
+                    T   y_3 = castTo<T>(cell(i+1,j+1));
+                    T   y_4 = castTo<T>(cell(i,j+1));
+
+                    if( x1 < x1s[0] || x1 > x1s[R-1] )  dydx1 = 0.0f;
+                    else dydx1 = ( (one-dx2)*(y_2 - y_1) + dx2*(y_3 - y_4) ) /
+                                 ( castTo<T>(x1s[i+1]) - castTo<T>(x1s[i]) );
+
+                    if( x2 < x2s[0] || x2 > x2s[C-1] )  dydx2 = 0.0f;
+                    else dydx2 = ( (one-dx1)*(y_4 - y_1) + dx1*(y_3 - y_2) ) /
+                                 ( castTo<T>(x2s[j+1]) - castTo<T>(x2s[j]) );
+
+                    return castTo<Y>( lerp( dx1, dx2, y_1, y_2, y_3, y_4 ) );
+                  }
+
+    void          modified()            { valid = 0; }
+
+#ifdef MAP_HEATMAP
+    MapHeatmap<R,C>&      heatmap()     { return heat; }
+#endif
+
 protected:
 
-    X             x1s[R];
-    X             x2s[C];
-    Y             ys[R][C];
+    X1            x1s[R];
+    X2            x2s[C];
+    Y             ys[Layout::size];
+
+#ifdef MAP_HEATMAP
+    MapHeatmap<R,C> heat;               // cells visited by f()
+#endif
+
+    uint8_t       valid;                // MapValid bits
 
 };
 
 
+//-----------------------------------------------------------------------------
+// Adapter adding the Map interface to a lean map core. Calls are dispatched
+// statically to the Core, so only maps accessed thru a Map& pay for the
+// vtable pointer and receive state.
+//-----------------------------------------------------------------------------
+
+template<class Core>
+class MapAdapter : public Map, public Core
+{
+public:
+    virtual int   memSize() const       { return Core::memSize(); }
+    virtual int   rowSize() const       { return Core::rowSize(); }
+
+#ifdef AVR
+    virtual bool  updateEeprom(uint8_t* dest) const
+                  {
+                    MAP_TRACE_POINT( TRACE_EEPROM_UPDATE, (uintptr_t)dest, memSize() );
+                    return Core::updateEeprom(dest);
+                  }
+
+    virtual bool  readEeprom(const uint8_t* src)
+                  {
+                    MAP_TRACE_POINT( TRACE_EEPROM_READ, (uintptr_t)src, memSize() );
+                    return Core::readEeprom(src);
+                  }
+#endif
+
+    virtual void  printTo( Print& p, const uint8_t tabsize = 4, const char delim = ' ' )
+                                        { Core::printTo( p, tabsize, delim ); }
+
+    virtual void  sendTo( ExtendedSerial& s)
+                                        { Core::sendTo(s);                 }
+
+    virtual size_t sendRange( ExtendedSerial& s, map_offset_t offset, size_t nr_bytes)
+                  {
+                    size_t sent = 0;
+
+                    s.beginSend();
+
+                    while( sent < nr_bytes )
+                    {
+                       size_t n = Core::sendAt( s, offset + sent );
+
+                       if( n ) sent += n;
+                       else break;      // past the end of the map
+                    }
+
+                    if( !s.endSend() ) return 0;   // short write of the transport
+
+                    return sent;
+                  }
+
+    virtual size_t elementSize( map_offset_t offset)
+                  {
+                    MapSizeOp op;
+                    return Core::visitAt( op, offset );
+                  }
+
+    virtual uint32_t crc( ExtendedSerial::ByteOrder order =
+                          ExtendedSerial::WIRE_LITTLE_ENDIAN)
+                  {
+                    if( !(Core::valid & VALID_CRC) || crcOrder != order )
+                    {
+                      CrcTransport   ct;
+                      ExtendedSerial s(ct);
+
+                      s.setByteOrder( order );
+                      Core::sendTo( s );
+
+                      crcValue     = ct.crc();
+                      crcOrder     = order;
+                      Core::valid |= VALID_CRC;
+                    }
+
+                    return crcValue;
+                  }
+
+    virtual bool  receiveFrom( ExtendedSerial& s, size_t maxBytes = 0) 
+                  {
+                    size_t slice = 0;
+
+                    while( !receiveDone() )
+                    {
+                       if( maxBytes && slice >= maxBytes ) return false; // time's up
+
+                       size_t recvd = Core::receiveAt( s, curOffset );
+
+                       if( recvd) { curOffset += recvd; bytesReceived += recvd; slice += recvd; }
+                       else return false; // avoid infinite loop when we receive nothing.
+                    }
+
+                    MAP_TRACE_POINT( TRACE_RECEIVE_DONE, curOffset, (uintptr_t)static_cast<Core*>(this) );
+                    return true;
+                  }
+
+    // Bytes per map spent on the Map interface (vptr and receive state).
+    static int    adapterOverhead()     { return sizeof(MapAdapter) - sizeof(Core); }
+};
+
+
+//-----------------------------------------------------------------------------
+// 2D and 3D maps with the Map interface, for use in e.g. lists of maps which
+// are sent to and received from a tuner.
+//-----------------------------------------------------------------------------
+
+template<int S, typename X, typename Y>
+class Map2D : public MapAdapter< Map2DCore<S,X,Y> >
+{};
+
+template<int R, int C, typename X1, typename Y, typename X2 = X1,
+         template<int,int> class L = RowMajor>
+class Map3D : public MapAdapter< Map3DCore<R,C,X1,Y,X2,L> >
+{};
+
+
+//-----------------------------------------------------------------------------
+// Dense cache for 2D maps with an 8 bit X type, such as TPS % or a raw
+// coolant temperature. On first use after a modification of the map, f(x) is
+// computed for each of the 256 possible xs, so a lookup becomes a single
+// indexed load. Modifications thru setters, readEeprom or receiveFrom
+// invalidate the cache automatically. M is a Map2DCore or a Map2D, e.g.:
+//
+//   Cached< Map2D<16, uint8_t, Fix16> >  tpsMap;
+//
+// With MAP_HEATMAP, each f() counts in the heatmap of the map, and with
+// MAP_TRACE it is traced, as a lookup of the map itself would. Building the
+// cache is neither counted nor traced.
+//-----------------------------------------------------------------------------
+
+template<class M>
+class Cached : public M
+{
+public:
+    typedef typename M::x_type  X;
+    typedef typename M::y_type  Y;
+
+    using         M::f;
+
+    Y             f( X x )              // approximate f(x)
+                  {
+                    if( !(this->valid & VALID_CACHE) ) build();
+
+                    const uint8_t k = index(x);
+
+                    MAP_HEAT( this->heat.hit( segment[k], heatU[k] ) );
+                    MAP_TRACE_POINT( TRACE_LOOKUP_2D, segment[k], (uintptr_t)this );
+
+                    return cache[k];
+                  }
+
+    int           cacheSize() const     { return sizeof(cache); }
+
+protected:
+
+    // 0..255, for both int8_t and uint8_t
+    static uint8_t index( X x )
+                  {
+                    return static_cast<uint8_t>(x) ^ ( X(-1) < X(0) ? 0x80 : 0 );
+                  }
+
+    void          build()
+                  {
+                    MapCursor c;
+
+                    for( int i=0; i<256; i++ )  // ascending xs, so walk
+                    {
+                      X x = static_cast<X>( i ^ index(0) );
+                      cache[i] = M::lookup( x, c );
+
+#if defined(MAP_HEATMAP) || defined(MAP_TRACE)
+                      segment[i] = c.i;
+#endif
+#ifdef MAP_HEATMAP
+                      // the hit of a lookup of x, outside the axis clamped
+                      const X lo = M::x(c.i);
+                      const X hi = M::x(c.i+1);
+
+                      heatU[i] = heatFraction( x < lo ? lo : x > hi ? hi : x, lo, hi );
+#endif
+                    }
+
+                    this->valid |= VALID_CACHE;
+                  }
+
+    Y             cache[256];
+
+#if defined(MAP_HEATMAP) || defined(MAP_TRACE)
+    uint8_t       segment[256];         // per x, as traced by f()
+#endif
+#ifdef MAP_HEATMAP
+    uint8_t       heatU[256];           // per x, see MapHeatmap::hit
+#endif
+
+private:
+
+    // Only 8 bit X types can be cached
+    typedef char  x_must_be_8_bit[ sizeof(X) == 1 ? 1 : -1 ];
+};
+
+
+//-----------------------------------------------------------------------------
+// Fused blending of maps with identical axes, for e.g. flex fuel or altitude
+// compensation:
+//
+//   y = (1-a)*mapA.f(x1,x2) + a*mapB.f(x1,x2)
+//
+// The axes of the first map are searched only once and the corner values of
+// the maps are blended before interpolating, so the cost is about that of a
+// single lookup. The weights are of type InterpolType<Y>::type.
+//-----------------------------------------------------------------------------
+
+template<int S, typename X, typename Y>
+inline Y blend( const Map2DCore<S,X,Y>& mapA, const Map2DCore<S,X,Y>& mapB,
+                typename InterpolType<Y>::type a, typename Map2DCore<S,X,Y>::x_type x )
+{
+  typedef typename InterpolType<Y>::type T;
+
+  T   one   = 1.0f; // avoid ambigious operator overload
+  T   b     = one - a;
+
+  int i; T dx;
+  mapA.locate( x, i, dx );
+
+  T   y_1   = b*castTo<T>(mapA.y(i))   + a*castTo<T>(mapB.y(i));
+  T   y_2   = b*castTo<T>(mapA.y(i+1)) + a*castTo<T>(mapB.y(i+1));
+
+  return castTo<Y>( lerp( dx, y_1, y_2 ) );
+}
+
+
+template<int R, int C, typename X1, typename Y, typename X2, template<int,int> class L>
+inline Y blend( const Map3DCore<R,C,X1,Y,X2,L>& mapA, const Map3DCore<R,C,X1,Y,X2,L>& mapB,
+                typename InterpolType<Y>::type a,
+                typename Map3DCore<R,C,X1,Y,X2,L>::x1_type x1,
+                typename Map3DCore<R,C,X1,Y,X2,L>::x2_type x2 )
+{
+  typedef typename InterpolType<Y>::type T;
+
+  T   one   = 1.0f; // avoid ambigious operator overload
+  T   b     = one - a;
+
+  int i, j; T dx1, dx2;
+  mapA.locate( x1, x2, i, j, dx1, dx2 );
+
+  T   y_1   = b*castTo<T>(mapA.y(i,j))     + a*castTo<T>(mapB.y(i,j));
+  T   y_2   = b*castTo<T>(mapA.y(i+1,j))   + a*castTo<T>(mapB.y(i+1,j));
+  T   y_3   = b*castTo<T>(mapA.y(i+1,j+1)) + a*castTo<T>(mapB.y(i+1,j+1));
+  T   y_4   = b*castTo<T>(mapA.y(i,j+1))   + a*castTo<T>(mapB.y(i,j+1));
+
+  return castTo<Y>( lerp( dx1, dx2, y_1, y_2, y_3, y_4 ) );
+}
+
+
+// n maps with weights w[0..n-1]: y = w[0]*maps[0]->f(x) + ... 
+
+template<int S, typename X, typename Y>
+inline Y blend( const Map2DCore<S,X,Y>* const* maps,
+                const typename InterpolType<Y>::type* w, int n,
+                typename Map2DCore<S,X,Y>::x_type x )
+{
+  typedef typename InterpolType<Y>::type T;
+
+  int i; T dx;
+  maps[0]->locate( x, i, dx );
+
+  T   y_1   = 0.0f;
+  T   y_2   = 0.0f;
+
+  for( int m=0; m<n; m++ )
+  {
+    y_1 += w[m]*castTo<T>(maps[m]->y(i));
+    y_2 += w[m]*castTo<T>(maps[m]->y(i+1));
+  }
+
+  return castTo<Y>( lerp( dx, y_1, y_2 ) );
+}
+
+
+template<int R, int C, typename X1, typename Y, typename X2, template<int,int> class L>
+inline Y blend( const Map3DCore<R,C,X1,Y,X2,L>* const* maps,
+                const typename InterpolType<Y>::type* w, int n,
+                typename Map3DCore<R,C,X1,Y,X2,L>::x1_type x1,
+                typename Map3DCore<R,C,X1,Y,X2,L>::x2_type x2 )
+{
+  typedef typename InterpolType<Y>::type T;
+
+  int i, j; T dx1, dx2;
+  maps[0]->locate( x1, x2, i, j, dx1, dx2 );
+
+  T   y_1   = 0.0f;
+  T   y_2   = 0.0f;
+  T   y_3   = 0.0f;
+  T   y_4   = 0.0f;
+
+  for( int m=0; m<n; m++ )
+  {
+    y_1 += w[m]*castTo<T>(maps[m]->y(i,j));
+    y_2 += w[m]*castTo<T>(maps[m]->y(i+1,j));
+    y_3 += w[m]*castTo<T>(maps[m]->y(i+1,j+1));
+    y_4 += w[m]*castTo<T>(maps[m]->y(i,j+1));
+  }
+
+  return castTo<Y>( lerp( dx1, dx2, y_1, y_2, y_3, y_4 ) );
+}
+
+
 //-----------------------------------------------------------------------------
 //
 //-----------------------------------------------------------------------------
@@ -0,0 +1,664 @@
+//-----------------------------------------------------------------------------
+// 2D and 3D Maps c.q. lookup tables with vector valued cells, and map banks
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2018 Arend Lammertink
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, version 3.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+// for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+//
+// Description:
+//
+// Maps sharing the same axes, such as VE, AFR target and spark advance, can
+// be stored as a single map with K outputs per cell:
+//
+//   ys[i][k]    = f_k( xs[i] )
+//   ys[i][j][k] = f_k( x1s[i], x2s[j] )
+//
+// One call to f() then returns all K interpolated values, for the price of a
+// single search. The weights are computed once and applied to each output.
+//
+// The cells can be stored interleaved (all K outputs of a cell next to each
+// other, the best choice on an MCU) or planar (K separate tables, which lets
+// the compiler vectorize the inner loop over K on the host). On the wire and
+// in EEPROM, the K outputs are always sent as K consecutive tables, just like
+// K separate maps would be.
+//
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// Multi-include protection
+//-----------------------------------------------------------------------------
+
+#ifndef _LOOKUP_TABLE_2D3D_VEC
+#define _LOOKUP_TABLE_2D3D_VEC
+
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+
+#include "Map2D3D.h"
+
+
+//-----------------------------------------------------------------------------
+// Cell layouts, for N cells with K outputs each.
+//-----------------------------------------------------------------------------
+
+template<int N, int K>
+struct CellsInterleaved                 // AoS: ys[N][K]
+{
+    static int    index( int n, int k ) { return n*K + k; }
+};
+
+template<int N, int K>
+struct CellsPlanar                      // SoA: ys[K][N]
+{
+    static int    index( int n, int k ) { return k*N + n; }
+};
+
+
+//-----------------------------------------------------------------------------
+// 2D lookup table with K outputs per cell. X axis must be sorted in ascending
+// order.
+//-----------------------------------------------------------------------------
+
+template<int S, int K, typename X, typename Y,  // S: size, K: nr of outputs
+         template<int,int> class L = CellsInterleaved>
+class Map2DVecCore
+{
+public:
+    typedef L<S,K>  Layout;
+
+                  Map2DVecCore() : valid(0)
+                  {
+                      for( int i=0; i<S;   i++ ) { xs[i] = 0; }
+                      for( int i=0; i<S*K; i++ ) { ys[i] = 0; }
+                  }
+
+    int           xSize()   const       { return S; }
+    int           ySize()   const       { return S; }
+    int           outputs() const       { return K; }
+    int           memSize() const       { return S*sizeof(X) + S*K*sizeof(Y); }
+    int           rowSize() const       { return sizeof(Y); }
+
+    // Call modified() after writing cells thru y(), so cached data such as
+    // the CRC is refreshed.
+    Y&            y( int i, int k )     { return ys[Layout::index(i,k)]; }
+    const Y&      y( int i, int k ) const
+                                        { return ys[Layout::index(i,k)]; }
+
+    void          setXs( const X* xss ) { memcpy( xs, xss, S*sizeof(X) ); modified(); }
+
+    void          setXsFromFloat( const float* xss )
+                  {
+                      for( int i=0; i<S; i++ ) { xs[i] = static_cast<X>(xss[i]); }
+                      modified();
+                  }
+
+    int           getXInt( int i )      { return i >= 0 && i < S ? static_cast<int>(xs[i])   : 0; }
+
+    float         getXFloat( int i )    { return i >= 0 && i < S ? static_cast<float>(xs[i]) : 0; }
+
+    // Set the S values of output k
+    void          setYs( int k, const Y* yss )
+                  {
+                      for( int i=0; i<S; i++ ) { y(i,k) = yss[i]; }
+                      modified();
+                  }
+
+    void          setYsFromFloat( int k, const float* yss )
+                  {
+                      for( int i=0; i<S; i++ ) { y(i,k) = static_cast<Y>(yss[i]); }
+                      modified();
+                  }
+
+    int           getYInt( int i, int k )
+                      { return i >= 0 && i < S && k >= 0 && k < K ? static_cast<int>(y(i,k))   : 0; }
+
+    float         getYFloat( int i, int k )
+                      { return i >= 0 && i < S && k >= 0 && k < K ? static_cast<float>(y(i,k)) : 0; }
+
+#ifdef AVR
+    bool          updateEeprom(uint8_t* dest) const
+                  {
+                    if( !eeprom_is_ready() ) return false;
+
+                    eeprom_update_block( xs, dest, sizeof(xs) );
+                    dest += sizeof(xs);
+
+                    for( int k=0; k<K; k++ )
+                      for( int i=0; i<S; i++, dest+=sizeof(Y) )
+                        { eeprom_update_block( &y(i,k), dest, sizeof(Y) ); }
+
+                    return true;
+                  }
+
+    bool          readEeprom(const uint8_t* src)
+                  {
+                    if( !eeprom_is_ready() ) return false;
+
+                    eeprom_read_block( xs, src, sizeof(xs) );
+                    src += sizeof(xs);
+
+                    for( int k=0; k<K; k++ )
+                      for( int i=0; i<S; i++, src+=sizeof(Y) )
+                        { eeprom_read_block( &y(i,k), src, sizeof(Y) ); }
+
+                    modified();
+                    return true;
+                  }
+#endif
+
+#ifdef ARDUINO    // Initialization from array in PROGMEM
+
+    void          setXs_P( const X* xss ) { memcpy_P( xs, xss, S*sizeof(X) ); modified(); }
+
+    void          setYsFromFloat_P( int k, const float* yss )
+                  {
+                      for( int i=0; i<S; i++ )
+                          { y(i,k) = static_cast<Y>( pgm_read_float_near(yss+i) ); }
+                      modified();
+                  }
+#endif
+
+    void          printTo( Print& p, const uint8_t tabsize = 4, const char delim = ' ' )
+                  {
+                    char buf[TO_STRING_SIZE];
+
+                    p.println();
+
+                    for (int x = 0; x < S; x++)
+                    {
+                      const char* _x = toString(buf, sizeof(buf), xs[x], tabsize);
+
+                      p.print(_x);// Vertical Bins
+                      p.write(delim);
+
+                      for (int k = 0; k < K; k++)
+                      {
+                        const char* value = toString(buf, sizeof(buf), y(x,k), tabsize);
+
+                        p.print(value);
+                        p.write(delim);
+                      }
+
+                      p.println();
+                    }
+
+                    p.println();
+                  }
+
+    void          sendTo( ExtendedSerial& s)
+                  {
+                    s.beginSend();
+                    s.send( xs, S );
+
+                    for (int k = 0; k < K; k++)
+                      for (int i = 0; i < S; i++) { s.send( y(i,k) ); }
+                    s.endSend();
+                  }
+
+    // Send or receive the element at byte offset 'offset' of the layout used
+    // by sendTo. Returns the number of bytes transferred, 0 if not available.
+    size_t        sendAt( ExtendedSerial& s, map_offset_t offset )
+                  {
+                    MapSendOp op(s);
+                    return visitAt( op, offset );
+                  }
+
+    size_t        receiveAt( ExtendedSerial& s, map_offset_t offset )
+                  {
+                    MapReceiveOp op(s);
+                    modified();
+                    return visitAt( op, offset );
+                  }
+
+    // Apply op to the element at byte offset 'offset' of the wire layout.
+    template<class Op>
+    size_t        visitAt( Op& op, map_offset_t offset )
+                  {
+                    const size_t xend = S*sizeof(X);
+                    const size_t yend = xend + S*K*sizeof(Y);
+
+                    if( offset < xend ) return op( xs[offset / sizeof(X)] );
+
+                    if( offset < yend )
+                    {
+                       int idx = (offset - xend) / sizeof(Y);
+
+                       return op( y( idx%S, idx/S ) );
+                    }
+
+                    return 0;
+                  }
+
+
+    // Find i, such that xs[i] <= x < xs[i+1], after clamping x to the axis,
+    // and the fraction dx of x between xs[i] and xs[i+1].
+    template<typename T>
+    void          locate( X x, int& i, T& dx ) const
+                  {
+                    if (x < xs[0])      { x = xs[0];   } // minimum
+                    if (x > xs[S-1])    { x = xs[S-1]; } // maximum
+
+                    i  = search( xs, S, x );
+                    dx = fraction<T>( x, xs[i], xs[i+1] );
+                  }
+
+    // approximate f_k(x) for all k, returned in out[0..K-1]
+    void          f( X x, Y* out )
+                  {
+                    typedef typename InterpolType<Y>::type T;
+
+                    int i; T dx;
+                    locate( x, i, dx );
+
+                    for( int k=0; k<K; k++ )
+                        { out[k] = castTo<Y>( lerp( dx, y(i,k), y(i+1,k) ) ); }
+                  }
+
+    void          modified()            { valid = 0; }
+
+protected:
+
+    X             xs[S];
+    Y             ys[S*K];
+
+    uint8_t       valid;                // MapValid bits
+
+};
+
+
+//-----------------------------------------------------------------------------
+// 3D lookup table with K outputs per cell. X axes must be sorted in ascending
+// order.
+//-----------------------------------------------------------------------------
+
+template<int R, int C, int K, typename X1, typename Y, typename X2 = X1,
+         template<int,int> class L = CellsInterleaved>
+class Map3DVecCore                      // R,C: size, K: nr of outputs
+{
+public:
+    typedef L<R*C,K>  Layout;
+
+                  Map3DVecCore() : valid(0)
+                  {
+                      for( int i=0; i<R;     i++ ) { x1s[i] = 0; }
+                      for( int i=0; i<C;     i++ ) { x2s[i] = 0; }
+                      for( int i=0; i<R*C*K; i++ ) { ys[i]  = 0; }
+                  }
+
+    int           x1Size()  const    { return R;   }
+    int           x2Size()  const    { return C;   }
+    int           ySize()   const    { return R*C; }
+    int           outputs() const    { return K;   }
+    int           memSize() const    { return R*sizeof(X1) + C*sizeof(X2) + R*C*K*sizeof(Y); }
+    int           rowSize() const    { return C*sizeof(Y); }
+
+    // Call modified() after writing cells thru y(), so cached data such as
+    // the CRC is refreshed.
+    Y&            y( int i, int j, int k )
+                                     { return ys[Layout::index(i*C+j,k)]; }
+    const Y&      y( int i, int j, int k ) const
+                                     { return ys[Layout::index(i*C+j,k)]; }
+
+    void          setX1s( const X1* x1ss )
+                        { memcpy( x1s, x1ss, R*sizeof(X1) ); modified(); }
+
+    void          setX2s( const X2* x2ss )
+                        { memcpy( x2s, x2ss, C*sizeof(X2) ); modified(); }
+
+    void          setX1sFromFloat( const float* xss )
+                  {
+                      for( int i=0; i<R; i++ )  { x1s[i] = static_cast<X1>(xss[i]); }
+                      modified();
+                  }
+
+    void          setX2sFromFloat( const float* xss )
+                  {
+                      for( int i=0; i<C; i++ )  { x2s[i] = static_cast<X2>(xss[i]); }
+                      modified();
+                  }
+
+    int           getX1Int( int i )   { return i >= 0 && i < R ? static_cast<int>(x1s[i])   : 0; }
+    int           getX2Int( int i )   { return i >= 0 && i < C ? static_cast<int>(x2s[i])   : 0; }
+
+    float         getX1Float( int i ) { return i >= 0 && i < R ? static_cast<float>(x1s[i]) : 0; }
+    float         getX2Float( int i ) { return i >= 0 && i < C ? static_cast<float>(x2s[i]) : 0; }
+
+    // Set the R*C values of output k, row by row
+    void          setYs( int k, const Y* yss )
+                  {
+                      for( int i=0; i<R*C; i++ ) { y(i/C,i%C,k) = yss[i]; }
+                      modified();
+                  }
+
+    void          setYsFromFloat( int k, const float* yss )
+                  {
+                      for( int i=0; i<R*C; i++ ) { y(i/C,i%C,k) = static_cast<Y>(yss[i]); }
+                      modified();
+                  }
+
+    int           getYInt( int i, int j, int k )
+                      { return i >= 0 && i < R && j >= 0 && j < C && k >= 0 && k < K ? static_cast<int>(y(i,j,k))   : 0; }
+
+    float         getYFloat( int i, int j, int k )
+                      { return i >= 0 && i < R && j >= 0 && j < C && k >= 0 && k < K ? static_cast<float>(y(i,j,k)) : 0; }
+
+#ifdef AVR
+    bool          updateEeprom(uint8_t* dest) const
+                  {
+                    if( !eeprom_is_ready() ) return false;
+
+                    eeprom_update_block( x1s, dest, sizeof(x1s) );
+                    eeprom_update_block( x2s, dest+sizeof(x1s), sizeof(x2s) );
+                    dest += sizeof(x1s) + sizeof(x2s);
+
+                    for( int k=0; k<K; k++ )
+                      for( int i=0; i<R*C; i++, dest+=sizeof(Y) )
+                        { eeprom_update_block( &y(i/C,i%C,k), dest, sizeof(Y) ); }
+
+                    return true;
+                  }
+
+    bool          readEeprom(const uint8_t* src)
+                  {
+                    if( !eeprom_is_ready() ) return false;
+
+                    eeprom_read_block( x1s, src, sizeof(x1s) );
+                    eeprom_read_block( x2s, src+sizeof(x1s), sizeof(x2s) );
+                    src += sizeof(x1s) + sizeof(x2s);
+
+                    for( int k=0; k<K; k++ )
+                      for( int i=0; i<R*C; i++, src+=sizeof(Y) )
+                        { eeprom_read_block( &y(i/C,i%C,k), src, sizeof(Y) ); }
+
+                    modified();
+                    return true;
+                  }
+#endif
+
+#ifdef ARDUINO    // Initialize from array in PROGMEM
+
+    void          setX1s_P( const X1* x1ss ) { memcpy_P( x1s, x1ss, R*sizeof(X1) ); modified(); }
+    void          setX2s_P( const X2* x2ss ) { memcpy_P( x2s, x2ss, C*sizeof(X2) ); modified(); }
+
+    void          setYsFromFloat_P( int k, const float* yss )
+                  {
+                      for( int i=0; i<R*C; i++ )
+                          { y(i/C,i%C,k) = static_cast<Y>( pgm_read_float_near(yss+i) ); }
+                      modified();
+                  }
+#endif
+
+    void          printTo( Print& p, const uint8_t tabsize = 4, const char delim = ' ' )
+                  {
+                    const char spaceChar=' ';
+                    char       buf[TO_STRING_SIZE];
+
+                    for( int k = 0; k < K; k++ )   // One table per output
+                    {
+                      p.println();
+                      for( int x = 0; x < R; x++ )
+                      {
+                        const char* _x1 = toString(buf, sizeof(buf), x1s[x], tabsize);
+
+                        p.print(_x1);             // Vertical
+                        p.write(delim);
+
+                        for (int j = 0; j < C; j++)
+                        {
+                          const char* value = toString(buf, sizeof(buf), y(x,j,k), tabsize);
+
+                          p.print(value);
+                          p.write(delim);
+                        }
+                        p.println();
+                      }
+
+                      for( int idx=0; idx<tabsize; idx++)                p.write(spaceChar);
+
+                      for (int x = 0; x < C; x++) // Horizontal
+                      {
+                        const char* _x2 = toString(buf, sizeof(buf), x2s[x], tabsize);
+
+                        p.print(_x2);
+                        p.write(delim);
+                      }
+                      p.println();
+                    }
+                  }
+
+    void          sendTo( ExtendedSerial& s)
+                  {
+                    s.beginSend();
+                    s.send( x1s, R );
+                    s.send( x2s, C );
+
+                    for (int k = 0; k < K; k++)
+                      for (int x = R-1; x >=0; x--)  // TS likes rows in reverse order
+                        for (int j = 0; j < C; j++)
+                          { s.send( y(x,j,k) ); }
+                    s.endSend();
+                  }
+
+    // Send or receive the element at byte offset 'offset' of the layout used
+    // by sendTo. Returns the number of bytes transferred, 0 if not available.
+    size_t        sendAt( ExtendedSerial& s, map_offset_t offset )
+                  {
+                    MapSendOp op(s);
+                    return visitAt( op, offset );
+                  }
+
+    size_t        receiveAt( ExtendedSerial& s, map_offset_t offset )
+                  {
+                    MapReceiveOp op(s);
+                    modified();
+                    return visitAt( op, offset );
+                  }
+
+    // Apply op to the element at byte offset 'offset' of the wire layout.
+    template<class Op>
+    size_t        visitAt( Op& op, map_offset_t offset )
+                  {
+                    const size_t x1end = R*sizeof(X1);
+                    const size_t x2end = x1end + C*sizeof(X2);
+                    const size_t yend  = x2end + R*C*K*sizeof(Y);
+
+                    if( offset < x1end ) return op( x1s[offset / sizeof(X1)] );
+                    if( offset < x2end ) return op( x2s[(offset - x1end) / sizeof(X2)] );
+
+                    if( offset < yend )
+                    {
+                       int idx  = (offset - x2end) / sizeof(Y);
+                       int k    = idx / (R*C);
+                       idx     %= R*C;
+
+                       int idx1 = R - 1 - idx/C;  // TS likes the rows in reverse order
+                       int idx2 = idx%C;
+
+                       return op( y(idx1,idx2,k) );
+                    }
+
+                    return 0;
+                  }
+
+
+    // Find the cell (i,j) containing (x1,x2), after clamping to the axes,
+    // and the fractions dx1 and dx2 within that cell.
+    template<typename T>
+    void          locate( X1 x1, X2 x2, int& i, int& j, T& dx1, T& dx2 ) const
+                  {
+                    if (x1 < x1s[0])      { x1 = x1s[0];   } // minimum
+                    if (x1 > x1s[R-1])    { x1 = x1s[R-1]; } // maximum
+                    if (x2 < x2s[0])      { x2 = x2s[0];   } // minimum
+                    if (x2 > x2s[C-1])    { x2 = x2s[C-1]; } // maximum
+
+                    i   = search( x1s, R, x1 );
+                    j   = search( x2s, C, x2 );
+                    dx1 = fraction<T>( x1, x1s[i], x1s[i+1] );
+                    dx2 = fraction<T>( x2, x2s[j], x2s[j+1] );
+                  }
+
+    // approximate f_k(x1,x2) for all k, returned in out[0..K-1]
+    void          f( X1 x1, X2 x2, Y* out )
+                  {
+                    typedef typename InterpolType<Y>::type T;
+
+                    int i, j; T dx1, dx2;
+                    locate( x1, x2, i, j, dx1, dx2 );
+
+                    for( int k=0; k<K; k++ )
+                    {
+                        out[k] = castTo<Y>( lerp( dx1, dx2, y(i,j,k),   y(i+1,j,k),
+                                                            y(i+1,j+1,k), y(i,j+1,k) ) );
+                    }
+                  }
+
+    void          modified()            { valid = 0; }
+
+protected:
+
+    X1            x1s[R];
+    X2            x2s[C];
+    Y             ys[R*C*K];
+
+    uint8_t       valid;                // MapValid bits
+
+};
+
+
+//-----------------------------------------------------------------------------
+// Map banks: N tables of the same shape sharing their axes, for maps that
+// depend on a discrete state such as the gear, the cam profile or the fuel.
+//
+// A bank is a planar vector valued map, with the tables stored one after the
+// other, so the whole bank is sent, received and stored as a single page.
+// Besides selecting a table by index, two adjacent tables can be blended,
+// for example for flex fuel:
+//
+//   y = (1-a)*table[bank] + a*table[bank+1]
+//
+// In both cases, the axes are searched only once.
+//-----------------------------------------------------------------------------
+
+template<int N, int S, typename X, typename Y>  // N: nr of tables, S: size
+class Map2DBankCore : public Map2DVecCore<S,N,X,Y,CellsPlanar>
+{
+public:
+    typedef typename InterpolType<Y>::type T;
+
+    int           banks()   const       { return N; }
+
+    using         Map2DVecCore<S,N,X,Y,CellsPlanar>::f;
+
+    Y             f( int bank, X x )    // approximate f_bank(x)
+                  {
+                    if (bank < 0)       { bank = 0;   }
+                    if (bank > N-1)     { bank = N-1; }
+
+                    int i; T dx;
+                    this->locate( x, i, dx );
+
+                    return castTo<Y>( lerp( dx, this->y(i,bank), this->y(i+1,bank) ) );
+                  }
+
+    Y             blend( int bank, T a, X x )   // 0 <= a <= 1
+                  {
+                    if (bank < 0)       { bank = 0;   }
+                    if (bank > N-2)     { return f( bank, x ); }
+
+                    T   one = 1.0f; // avoid ambigious operator overload
+
+                    int i; T dx;
+                    this->locate( x, i, dx );
+
+                    T   y_1 = lerp( dx, this->y(i,bank),   this->y(i+1,bank)   );
+                    T   y_2 = lerp( dx, this->y(i,bank+1), this->y(i+1,bank+1) );
+
+                    return castTo<Y>( (one-a)*y_1 + a*y_2 );
+                  }
+};
+
+
+template<int N, int R, int C, typename X1, typename Y, typename X2 = X1>
+class Map3DBankCore : public Map3DVecCore<R,C,N,X1,Y,X2,CellsPlanar>
+{
+public:
+    typedef typename InterpolType<Y>::type T;
+
+    int           banks()   const       { return N; }
+
+    using         Map3DVecCore<R,C,N,X1,Y,X2,CellsPlanar>::f;
+
+    Y             f( int bank, X1 x1, X2 x2 )   // approximate f_bank(x1,x2)
+                  {
+                    if (bank < 0)       { bank = 0;   }
+                    if (bank > N-1)     { bank = N-1; }
+
+                    int i, j; T dx1, dx2;
+                    this->locate( x1, x2, i, j, dx1, dx2 );
+
+                    return castTo<Y>( lerp( dx1, dx2, this->y(i,j,bank),     this->y(i+1,j,bank),
+                                                      this->y(i+1,j+1,bank), this->y(i,j+1,bank) ) );
+                  }
+
+    Y             blend( int bank, T a, X1 x1, X2 x2 )  // 0 <= a <= 1
+                  {
+                    if (bank < 0)       { bank = 0;   }
+                    if (bank > N-2)     { return f( bank, x1, x2 ); }
+
+                    T   one = 1.0f; // avoid ambigious operator overload
+
+                    int i, j; T dx1, dx2;
+                    this->locate( x1, x2, i, j, dx1, dx2 );
+
+                    T   y_1 = lerp( dx1, dx2, this->y(i,j,bank),       this->y(i+1,j,bank),
+                                              this->y(i+1,j+1,bank),   this->y(i,j+1,bank)   );
+                    T   y_2 = lerp( dx1, dx2, this->y(i,j,bank+1),     this->y(i+1,j,bank+1),
+                                              this->y(i+1,j+1,bank+1), this->y(i,j+1,bank+1) );
+
+                    return castTo<Y>( (one-a)*y_1 + a*y_2 );
+                  }
+};
+
+
+//-----------------------------------------------------------------------------
+// Vector valued maps and banks with the Map interface
+//-----------------------------------------------------------------------------
+
+template<int S, int K, typename X, typename Y,
+         template<int,int> class L = CellsInterleaved>
+class Map2DVec : public MapAdapter< Map2DVecCore<S,K,X,Y,L> >
+{};
+
+template<int R, int C, int K, typename X1, typename Y, typename X2 = X1,
+         template<int,int> class L = CellsInterleaved>
+class Map3DVec : public MapAdapter< Map3DVecCore<R,C,K,X1,Y,X2,L> >
+{};
+
+template<int N, int S, typename X, typename Y>
+class Map2DBank : public MapAdapter< Map2DBankCore<N,S,X,Y> >
+{};
+
+template<int N, int R, int C, typename X1, typename Y, typename X2 = X1>
+class Map3DBank : public MapAdapter< Map3DBankCore<N,R,C,X1,Y,X2> >
+{};
+
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+
+#endif // End multi-include protection
@@ -0,0 +1,389 @@
+//-----------------------------------------------------------------------------
+// Compressed transfers of maps: row delta and run length encoding
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2018 Arend Lammertink
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, version 3.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+// for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+//
+// Description:
+//
+// Calibration tables compress well: rows are often repeated verbatim and
+// neighbouring cells differ only slightly. The wire image of a map (see
+// Map::sendTo) is therefore optionally compressed in two steps:
+//
+//  1. Row delta: each byte is XOR-ed with the byte one row (Map::rowSize()
+//     bytes) earlier, so repeated rows become runs of zeros. XOR is exact for
+//     any cell type, including floats and Fix16s.
+//
+//  2. Run length encoding (PackBits like), with a control byte c:
+//
+//       c <  0x80:  c+1 literal bytes follow           (1..32)
+//       c >= 0x80:  the next byte is repeated c-0x7D times (3..130)
+//
+// A transfer starts with a mode byte, followed by the row size for mode
+// COMPRESS_DELTA_RLE as uint16_t (little endian). The sender may fall back
+// to a simpler mode than requested, e.g. when a row does not fit in its
+// history buffer, so the receiver takes the mode from the stream. A header
+// with an unknown mode, or a row size the receiver cannot hold, stops the
+// receiver, which then reports mode() COMPRESS_ERROR until start().
+//
+// Both sides work in streaming fashion, with buffers of a few dozen bytes
+// plus one row of history, so they fit on an 8 bit MCU. They are Transports,
+// used underneath an ExtendedSerial:
+//
+//   sendCompressed<64>( map, link, COMPRESS_DELTA_RLE );      // sender
+//
+//   DecompressingTransport<64> dt(link);                       // receiver
+//   ExtendedSerial             ds(dt);
+//
+//   map.initReceive( 0, map.memSize() );
+//   while( !map.receiveFrom(ds) ) { ... }
+//
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// Multi-include protection
+//-----------------------------------------------------------------------------
+
+#ifndef _MAP_COMPRESS_H
+#define _MAP_COMPRESS_H
+
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+
+#include "Map2D3D.h"
+#include "Transport.h"
+
+
+//-----------------------------------------------------------------------------
+// Defines
+//-----------------------------------------------------------------------------
+
+enum MapCompression
+{
+    COMPRESS_NONE       = 0,
+    COMPRESS_RLE        = 1,
+    COMPRESS_DELTA_RLE  = 2,
+
+    COMPRESS_ERROR      = 0xFF          // receiver: bad header, see mode()
+};
+
+#define RLE_MAX_LITERAL     32
+#define RLE_MIN_REPEAT      3
+#define RLE_MAX_REPEAT      130
+
+
+//-----------------------------------------------------------------------------
+// Compresses the bytes written to it and writes the result to 'link'. Rows of
+// up to D bytes can be delta encoded. Reads are passed thru.
+//-----------------------------------------------------------------------------
+
+template<uint16_t D>
+class CompressingTransport : public Transport
+{
+  public:
+                    CompressingTransport(Transport& link)
+                      : _link(link), _mode(COMPRESS_NONE), _dist(0), _pos(0),
+                        _nlit(0), _runLen(0), _bytesOut(0) {}
+
+    // Start a transfer, writing the header. Returns the mode used.
+    uint8_t         start(uint8_t mode, uint16_t rowSize)
+                    {
+                      if( mode == COMPRESS_DELTA_RLE && (rowSize == 0 || rowSize > D) )
+                        mode = COMPRESS_RLE;
+                      if( mode > COMPRESS_DELTA_RLE )
+                        mode = COMPRESS_NONE;
+
+                      _mode     = mode;
+                      _dist     = rowSize;
+                      _pos      = 0;
+                      _nlit     = 0;
+                      _runLen   = 0;
+                      _bytesOut = 0;
+
+                      out( mode );
+
+                      if( mode == COMPRESS_DELTA_RLE )
+                      {
+                        out( rowSize & 0xFF );
+                        out( rowSize >> 8 );
+
+                        memset( _hist, 0, rowSize );
+                      }
+
+                      return mode;
+                    }
+
+    // Flush the pending run and literals. Ends the transfer.
+    void            finish()
+                    {
+                      if( _mode == COMPRESS_NONE ) return;
+
+                      endRun();
+                      flushLiterals();
+                    }
+
+    // Bytes written to the link since start(), including the header.
+    size_t          bytesOut() const                  { return _bytesOut;         }
+
+    virtual size_t  write(uint8_t b)
+                    {
+                      if( _mode == COMPRESS_NONE ) { out(b); return 1; }
+
+                      if( _mode == COMPRESS_DELTA_RLE )
+                      {
+                        const uint8_t h = _hist[_pos];
+
+                        _hist[_pos] = b;
+                        if( ++_pos == _dist ) _pos = 0;
+
+                        b ^= h;
+                      }
+
+                      if( _runLen && b == _runByte && _runLen < RLE_MAX_REPEAT )
+                      {
+                        _runLen++;
+                        return 1;
+                      }
+
+                      endRun();
+
+                      _runByte = b;
+                      _runLen  = 1;
+
+                      return 1;
+                    }
+
+    virtual int     available(void)                   { return _link.available(); }
+    virtual int     peek(void)                        { return _link.peek();      }
+    virtual int     read(void)                        { return _link.read();      }
+    virtual void    flush(void)                       { _link.flush();            }
+
+  private:
+
+    void            out(uint8_t b)                    { _link.write(b); _bytesOut++; }
+
+    // Emit the current run as a repeat if it is long enough, else add it to
+    // the literals.
+    void            endRun()
+                    {
+                      if( _runLen >= RLE_MIN_REPEAT )
+                      {
+                        flushLiterals();
+                        out( 0x7D + _runLen );
+                        out( _runByte );
+                      }
+                      else
+                      {
+                        for( uint8_t i=0; i<_runLen; i++ )
+                        {
+                          if( _nlit == RLE_MAX_LITERAL ) flushLiterals();
+                          _lit[_nlit++] = _runByte;
+                        }
+                      }
+
+                      _runLen = 0;
+                    }
+
+    void            flushLiterals()
+                    {
+                      if( !_nlit ) return;
+
+                      out( _nlit - 1 );
+                      for( uint8_t i=0; i<_nlit; i++ ) out( _lit[i] );
+
+                      _nlit = 0;
+                    }
+
+    Transport&      _link;
+
+    uint8_t         _mode;
+    uint16_t        _dist;                // row size
+    uint16_t        _pos;                 // in _hist
+    uint8_t         _hist[D];             // last row, uncompressed
+
+    uint8_t         _lit[RLE_MAX_LITERAL];
+    uint8_t         _nlit;
+    uint8_t         _runByte;
+    uint8_t         _runLen;
+
+    size_t          _bytesOut;
+};
+
+
+//-----------------------------------------------------------------------------
+// Decompresses the bytes read from 'link'. Rows of up to D bytes can be delta
+// decoded. Writes are passed thru.
+//-----------------------------------------------------------------------------
+
+template<uint16_t D>
+class DecompressingTransport : public Transport
+{
+  public:
+    enum            { OUT_BUFFER = 16 };    // >= largest element on the wire
+
+                    DecompressingTransport(Transport& link) : _link(link) { start(); }
+
+    // Expect the header of a new transfer.
+    void            start()
+                    {
+                      _state = HEADER;
+                      _mode  = COMPRESS_NONE;
+                      _count = 0;
+                      _pos   = 0;
+                      _head  = 0;
+                      _tail  = 0;
+                    }
+
+    // Mode of the current transfer, once its header has been received.
+    // COMPRESS_ERROR if the header was bad; nothing is decoded then.
+    uint8_t         mode() const                      { return _mode;             }
+
+    virtual int     available(void)                   { pump(); return (uint8_t)(_head - _tail); }
+    virtual int     peek(void)                        { pump(); return _head != _tail ? _out[_tail % OUT_BUFFER] : -1; }
+    virtual int     read(void)                        { pump(); return _head != _tail ? _out[_tail++ % OUT_BUFFER] : -1; }
+
+    virtual size_t  write(uint8_t b)                  { return _link.write(b);    }
+    virtual size_t  write(const uint8_t* b,size_t sz) { return _link.write(b,sz); }
+    virtual void    flush(void)                       { _link.flush();            }
+
+  private:
+
+    enum            { HEADER, DIST_LO, DIST_HI, CONTROL, REPEAT_BYTE, LITERAL, REPEAT, RAW, FAILED };
+
+    // Decode as much as is available and fits in the output buffer.
+    void            pump()
+                    {
+                      while( _state != FAILED && (uint8_t)(_head - _tail) < OUT_BUFFER )
+                      {
+                        if( _state == REPEAT && _count )
+                        {
+                          emit( _repeat );
+                          _count--;
+                          continue;
+                        }
+
+                        const int c = _link.read();
+                        if( c < 0 ) return;
+
+                        switch( _state )
+                        {
+                          case HEADER:
+                            _mode  = c;
+                            _state = c == COMPRESS_DELTA_RLE ? DIST_LO :
+                                     c == COMPRESS_RLE       ? CONTROL :
+                                     c == COMPRESS_NONE      ? RAW     : FAILED;
+                            if( _state == FAILED ) _mode = COMPRESS_ERROR;
+                            break;
+
+                          case DIST_LO:
+                            _dist  = c;
+                            _state = DIST_HI;
+                            break;
+
+                          case DIST_HI:
+                            _dist |= c << 8;
+                            if( _dist == 0 || _dist > D )             // corrupt or too long
+                            {
+                              _mode  = COMPRESS_ERROR;
+                              _state = FAILED;
+                              break;
+                            }
+                            memset( _hist, 0, _dist );
+                            _state = CONTROL;
+                            break;
+
+                          case CONTROL:
+                          case REPEAT:
+                            if( c < 0x80 ) { _count = c + 1;  _state = LITERAL;     }
+                            else           { _count = c - 0x7D; _state = REPEAT_BYTE; }
+                            break;
+
+                          case REPEAT_BYTE:
+                            _repeat = c;
+                            _state  = REPEAT;
+                            break;
+
+                          case LITERAL:
+                            emit( c );
+                            if( !--_count ) _state = CONTROL;
+                            break;
+
+                          case RAW:
+                            _out[_head++ % OUT_BUFFER] = c;
+                            break;
+                        }
+                      }
+                    }
+
+    void            emit(uint8_t b)
+                    {
+                      if( _mode == COMPRESS_DELTA_RLE )
+                      {
+                        b ^= _hist[_pos];
+
+                        _hist[_pos] = b;
+                        if( ++_pos == _dist ) _pos = 0;
+                      }
+
+                      _out[_head++ % OUT_BUFFER] = b;
+                    }
+
+    Transport&      _link;
+
+    uint8_t         _state;
+    uint8_t         _mode;
+    uint8_t         _count;               // bytes left in the literal or repeat
+    uint8_t         _repeat;
+    uint16_t        _dist;                // row size
+    uint16_t        _pos;                 // in _hist
+    uint8_t         _hist[D];             // last row, uncompressed
+
+    uint8_t         _out[OUT_BUFFER];
+    uint8_t         _head;                // free running
+    uint8_t         _tail;
+};
+
+
+//-----------------------------------------------------------------------------
+// Send map m thru link, compressed with the given mode if possible. Returns
+// the number of bytes written to link.
+//-----------------------------------------------------------------------------
+
+template<uint16_t D>
+size_t sendCompressed( Map& m, Transport& link, uint8_t mode,
+                       ExtendedSerial::ByteOrder order = ExtendedSerial::WIRE_LITTLE_ENDIAN )
+{
+    CompressingTransport<D> ct(link);
+    ExtendedSerial          cs(ct);
+
+    cs.setByteOrder( order );
+
+    ct.start( mode, m.rowSize() );
+    m.sendTo( cs );
+    cs.flushTx();
+    ct.finish();
+
+    return ct.bytesOut();
+}
+
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+
+#endif // End multi-include protection
@@ -0,0 +1,604 @@
+//-----------------------------------------------------------------------------
+// 2D and 3D Maps c.q. lookup tables with sizes set at run time
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2018 Arend Lammertink
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, version 3.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+// for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+//
+// Description:
+//
+// Map2D and Map3D have their sizes fixed at compile time. Host side tools
+// which load calibrations of arbitrary dimensions use the maps in this file
+// instead. They share the search and interpolation code with the fixed size
+// maps, so both give the same results for the same tables.
+//
+// The axes and cells of the maps are not owned by the maps, but allocated
+// from a MapArena: a single block of memory which is carved up in order.
+// Loading a calibration of thousands of maps is one allocation, and freeing
+// it is one release of the arena:
+//
+//   MapArena arena( DynMap3DCore<int16_t,uint8_t>::arenaSize(16,16) * n );
+//
+//   for( int k=0; k<n; k++ ) maps[k].allocate( 16, 16, arena );
+//
+// A map must not be used after its arena was reset or released.
+//
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// Multi-include protection
+//-----------------------------------------------------------------------------
+
+#ifndef _LOOKUP_TABLE_2D3D_DYN
+#define _LOOKUP_TABLE_2D3D_DYN
+
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+
+#include <stdlib.h>
+#include "Map2D3D.h"
+
+
+//-----------------------------------------------------------------------------
+// Bump allocator for the axes and cells of run time sized maps. All blocks
+// are aligned to MapArena::ALIGN bytes.
+//-----------------------------------------------------------------------------
+
+class MapArena
+{
+public:
+    enum          { ALIGN = 8 };
+
+                  MapArena() : base(0), cap(0), top(0) {}
+
+    explicit      MapArena( size_t bytes ) : base(0), cap(0), top(0)
+                                        { reserve( bytes ); }
+
+                  ~MapArena()           { release(); }
+
+    // Allocate a block of 'bytes' bytes, releasing the current block (and
+    // thereby all maps allocated from it). Returns false when out of memory.
+    bool          reserve( size_t bytes )
+                  {
+                    release();
+
+                    base = static_cast<uint8_t*>( malloc( bytes ) );
+                    cap  = base ? bytes : 0;
+
+                    return base != 0;
+                  }
+
+    void          release()             { free( base ); base = 0; cap = 0; top = 0; }
+
+    // Make all memory available again, without releasing it.
+    void          reset()               { top = 0; }
+
+    // Returns space for n elements of type T, or 0 if the arena is full.
+    template<typename T>
+    T*            alloc( int n )
+                  {
+                    const size_t bytes = roundUp( n*sizeof(T) );
+
+                    if( top + bytes > cap ) return 0;
+
+                    T* p = reinterpret_cast<T*>( base + top );
+                    top += bytes;
+
+                    return p;
+                  }
+
+    size_t        used()     const      { return top; }
+    size_t        capacity() const      { return cap; }
+
+    static size_t roundUp( size_t bytes ) { return (bytes + ALIGN-1) & ~size_t(ALIGN-1); }
+
+private:
+                  MapArena( const MapArena& );              // not copyable
+    MapArena&     operator=( const MapArena& );
+
+    uint8_t*      base;
+    size_t        cap;
+    size_t        top;
+};
+
+
+//-----------------------------------------------------------------------------
+// 2D lookup table of S elements, with S set at run time. X axis must be
+// sorted in ascending order.
+//-----------------------------------------------------------------------------
+
+template<typename X, typename Y>        // X,Y: data types
+class DynMap2DCore
+{
+public:
+    typedef X     x_type;
+    typedef Y     y_type;
+
+                  DynMap2DCore() : S(0), xs(0), ys(0), valid(0) {}
+
+    // Bytes taken from the arena by a map of S elements.
+    static size_t arenaSize( int S )
+                  {
+                    return MapArena::roundUp( S*sizeof(X) ) + MapArena::roundUp( S*sizeof(Y) );
+                  }
+
+    // Allocate the axis and cells from the arena and clear them. Returns
+    // false if the arena is full, leaving the map empty and the arena as it
+    // was. S must be >= 2.
+    bool          allocate( int size, MapArena& arena )
+                  {
+                    if( arenaSize( size ) > arena.capacity() - arena.used() )
+                    {
+                      S = 0; xs = 0; ys = 0;
+                      return false;
+                    }
+
+                    xs = arena.alloc<X>( size );
+                    ys = arena.alloc<Y>( size );
+
+                    S = size;
+                    for( int i=0; i<S; i++ ) { xs[i] = 0; ys[i] = 0; }
+                    modified();
+
+                    return true;
+                  }
+
+    int           xSize()   const       { return S; }
+    int           ySize()   const       { return S; }
+    int           memSize() const       { return S*(sizeof(X)+sizeof(Y)); }
+    int           rowSize() const       { return sizeof(Y); }
+
+    void          setXs( const X* xss ) { memcpy( xs, xss, S*sizeof(X) ); modified(); }
+
+    void          setXsFromFloat( const float* xss )
+                  {
+                      for( int i=0; i<S; i++ ) { xs[i] = static_cast<X>(xss[i]); }
+                      modified();
+                  }
+
+    void          setYs( const Y* yss ) { memcpy( ys, yss, S*sizeof(Y) ); modified(); }
+
+    void          setYsFromFloat( const float* yss )
+                  {
+                      for( int i=0; i<S; i++ ) { ys[i] = static_cast<Y>(yss[i]); }
+                      modified();
+                  }
+
+#ifdef AVR
+    bool          updateEeprom(uint8_t* dest) const
+                  {
+                    if( !eeprom_is_ready() ) return false;
+
+                    eeprom_update_block( xs, dest, S*sizeof(X) );
+                    eeprom_update_block( ys, dest+ S*sizeof(X), S*sizeof(Y) );
+
+                    return true;
+                  }
+
+    bool          readEeprom(const uint8_t* src)
+                  {
+                    if( !eeprom_is_ready() ) return false;
+
+                    eeprom_read_block( xs, src, S*sizeof(X) );
+                    eeprom_read_block( ys, src+ S*sizeof(X), S*sizeof(Y) );
+
+                    modified();
+                    return true;
+                  }
+#endif
+
+    void          printTo( Print& p, const uint8_t tabsize = 4, const char delim = ' ' )
+                  {
+                    char buf[TO_STRING_SIZE];
+
+                    p.println();
+
+                    for (int x = 0; x < S; x++)
+                    {
+                      const char* _x = toString(buf, sizeof(buf), xs[x], tabsize);
+
+                      p.print(_x);
+                      p.write(delim);
+
+                      const char* value = toString(buf, sizeof(buf), ys[x], tabsize);
+
+                      p.print(value);
+
+                      p.println();
+                    }
+
+                    p.println();
+                  }
+
+    void          sendTo( ExtendedSerial& s)
+                  {
+                    s.beginSend();
+                    s.send( xs, S );
+                    s.send( ys, S );
+                    s.endSend();
+                  }
+
+    // Send or receive the element at byte offset 'offset' of the layout used
+    // by sendTo. Returns the number of bytes transferred, 0 if not available.
+    size_t        sendAt( ExtendedSerial& s, map_offset_t offset )
+                  {
+                    MapSendOp op(s);
+                    return visitAt( op, offset );
+                  }
+
+    size_t        receiveAt( ExtendedSerial& s, map_offset_t offset )
+                  {
+                    MapReceiveOp op(s);
+                    modified();
+                    return visitAt( op, offset );
+                  }
+
+    // Apply op to the element at byte offset 'offset' of the wire layout.
+    template<class Op>
+    size_t        visitAt( Op& op, map_offset_t offset )
+                  {
+                    const size_t xend = S*sizeof(X);
+                    const size_t yend = xend + S*sizeof(Y);
+
+                    if( offset < xend ) return op( xs[offset / sizeof(X)] );
+                    if( offset < yend ) return op( ys[(offset - xend) / sizeof(Y)] );
+
+                    return 0;
+                  }
+
+
+    const X&      x( int i ) const      { return xs[i]; }
+    const Y&      y( int i ) const      { return ys[i]; }
+
+    // Find i, such that xs[i] <= x < xs[i+1], after clamping x to the axis,
+    // and the fraction dx of x between xs[i] and xs[i+1].
+    template<typename T>
+    void          locate( X x, int& i, T& dx ) const
+                  {
+                    if (x < xs[0])      { x = xs[0];   } // minimum
+                    if (x > xs[S-1])    { x = xs[S-1]; } // maximum
+
+                    i  = search( xs, S, x );
+                    dx = fraction<T>( x, xs[i], xs[i+1] );
+                  }
+
+    Y             f( X x ) const        // approximate f(x)
+                  {
+                    if (x < xs[0])      { return ys[0];   } // minimum
+                    if (x > xs[S-1])    { return ys[S-1]; } // maximum
+
+                    int i = search( xs, S, x );
+
+                    return interpolate( x, xs[i], xs[i+1], ys[i], ys[i+1]);
+                  }
+
+    // approximate f(x) for a stream of (nearly) sorted xs, see Map2DCore.
+    Y             f( X x, MapCursor& c ) const
+                  {
+                    if (x < xs[0])      { c.i = 0; return ys[0];   } // minimum
+                    if (x > xs[S-1])    { c.i = S-2; return ys[S-1]; } // maximum
+
+                    int i = c.i = walk( xs, S, x, c.i );
+
+                    return interpolate( x, xs[i], xs[i+1], ys[i], ys[i+1]);
+                  }
+
+    // approximate y[k] = f(x[k]) for n (nearly) sorted xs
+    void          f( const X* x, Y* y, int n ) const
+                  {
+                    MapCursor c;
+
+                    for( int k=0; k<n; k++ ) { y[k] = f( x[k], c ); }
+                  }
+
+    void          modified()            { valid = 0; }
+
+protected:
+
+    int           S;                    // size
+    X*            xs;                   // in the arena
+    Y*            ys;
+
+    uint8_t       valid;                // MapValid bits
+};
+
+
+//-----------------------------------------------------------------------------
+// 3D lookup table of R x C cells, with R and C set at run time. X axes must
+// be sorted in ascending order. The cells are stored row major.
+//-----------------------------------------------------------------------------
+
+template<typename X1, typename Y, typename X2 = X1>
+class DynMap3DCore                      // X1,X2,Y: data type
+{
+public:
+    typedef X1    x1_type;
+    typedef X2    x2_type;
+    typedef Y     y_type;
+
+                  DynMap3DCore() : R(0), C(0), x1s(0), x2s(0), ys(0), valid(0) {}
+
+    // Bytes taken from the arena by a map of R x C cells.
+    static size_t arenaSize( int R, int C )
+                  {
+                    return MapArena::roundUp( R*sizeof(X1) ) + MapArena::roundUp( C*sizeof(X2) )
+                         + MapArena::roundUp( R*C*sizeof(Y) );
+                  }
+
+    // Allocate the axes and cells from the arena and clear them. Returns
+    // false if the arena is full, leaving the map empty and the arena as it
+    // was. R and C must be >= 2.
+    bool          allocate( int rows, int cols, MapArena& arena )
+                  {
+                    if( arenaSize( rows, cols ) > arena.capacity() - arena.used() )
+                    {
+                      R = 0; C = 0; x1s = 0; x2s = 0; ys = 0;
+                      return false;
+                    }
+
+                    x1s = arena.alloc<X1>( rows );
+                    x2s = arena.alloc<X2>( cols );
+                    ys  = arena.alloc<Y>( rows*cols );
+
+                    R = rows;
+                    C = cols;
+
+                    for( int i=0; i<R;   i++ ) { x1s[i] = 0; }
+                    for( int i=0; i<C;   i++ ) { x2s[i] = 0; }
+                    for( int i=0; i<R*C; i++ ) { ys[i]  = 0; }
+
+                    modified();
+                    return true;
+                  }
+
+    int           x1Size()  const       { return R;   }
+    int           x2Size()  const       { return C;   }
+    int           ySize()   const       { return R*C; }
+    int           memSize() const       { return R*sizeof(X1) + C*sizeof(X2) + R*C*sizeof(Y); }
+    int           rowSize() const       { return C*sizeof(Y); }
+
+    void          setX1s( const X1* x1ss ) { memcpy( x1s, x1ss, R*sizeof(X1) );  modified(); }
+    void          setX2s( const X2* x2ss ) { memcpy( x2s, x2ss, C*sizeof(X2) );  modified(); }
+    void          setYs(  const Y*  yss  ) { memcpy( ys,  yss,  R*C*sizeof(Y) ); modified(); }
+
+    void          setX1sFromFloat( const float* x1ss )
+                  {
+                      for( int i=0; i<R; i++ ) { x1s[i] = static_cast<X1>(x1ss[i]); }
+                      modified();
+                  }
+
+    void          setX2sFromFloat( const float* x2ss )
+                  {
+                      for( int i=0; i<C; i++ ) { x2s[i] = static_cast<X2>(x2ss[i]); }
+                      modified();
+                  }
+
+    void          setYsFromFloat( const float* yss )
+                  {
+                      for( int i=0; i<R*C; i++ ) { ys[i] = static_cast<Y>(yss[i]); }
+                      modified();
+                  }
+
+#ifdef AVR
+    bool          updateEeprom(uint8_t* dest) const
+                  {
+                    if( !eeprom_is_ready() ) return false;
+
+                    eeprom_update_block( x1s, dest, R*sizeof(X1) );
+                    eeprom_update_block( x2s, dest+R*sizeof(X1), C*sizeof(X2) );
+                    eeprom_update_block( ys,  dest+R*sizeof(X1)+C*sizeof(X2), R*C*sizeof(Y) );
+
+                    return true;
+                  }
+
+    bool          readEeprom(const uint8_t* src)
+                  {
+                    if( !eeprom_is_ready() ) return false;
+
+                    eeprom_read_block( x1s, src, R*sizeof(X1) );
+                    eeprom_read_block( x2s, src+R*sizeof(X1), C*sizeof(X2) );
+                    eeprom_read_block( ys,  src+R*sizeof(X1)+C*sizeof(X2), R*C*sizeof(Y) );
+
+                    modified();
+                    return true;
+                  }
+#endif
+
+    void          printTo( Print& p, const uint8_t tabsize = 4, const char delim = ' ' )
+                  {
+                    const char spaceChar=' ';
+                    char       buf[TO_STRING_SIZE];
+
+                    p.println();
+                    for( int x = 0; x < R; x++ )
+                    {
+                      const char* _x1 = toString(buf, sizeof(buf), x1s[x], tabsize);
+
+                      p.print(_x1);             // Vertical
+                      p.write(delim);
+
+                      for (int y = 0; y < C; y++)
+                      {
+                        const char* value = toString(buf, sizeof(buf), cell(x,y), tabsize);
+
+                        p.print(value);
+                        p.write(delim);
+                      }
+                      p.println();
+                    }
+
+                    for( int idx=0; idx<tabsize; idx++)                p.write(spaceChar);
+
+                    for (int x = 0; x < C; x++) // Horizontal
+                    {
+                      const char* _x2 = toString(buf, sizeof(buf), x2s[x], tabsize);
+
+                      p.print(_x2);
+                      p.write(delim);
+                    }
+                    p.println();
+                  }
+
+    void          sendTo( ExtendedSerial& s)
+                  {
+                    s.beginSend();
+                    s.send( x1s, R );
+                    s.send( x2s, C );
+
+                    for (int x = R-1; x >=0; x--)  // TS likes rows in reverse order
+                      { s.send( &cell(x,0), C ); }
+                    s.endSend();
+                  }
+
+    // Send or receive the element at byte offset 'offset' of the layout used
+    // by sendTo. Returns the number of bytes transferred, 0 if not available.
+    size_t        sendAt( ExtendedSerial& s, map_offset_t offset )
+                  {
+                    MapSendOp op(s);
+                    return visitAt( op, offset );
+                  }
+
+    size_t        receiveAt( ExtendedSerial& s, map_offset_t offset )
+                  {
+                    MapReceiveOp op(s);
+                    modified();
+                    return visitAt( op, offset );
+                  }
+
+    // Apply op to the element at byte offset 'offset' of the wire layout.
+    template<class Op>
+    size_t        visitAt( Op& op, map_offset_t offset )
+                  {
+                    const size_t x1end = R*sizeof(X1);
+                    const size_t x2end = x1end + C*sizeof(X2);
+                    const size_t yend  = x2end + R*C*sizeof(Y);
+
+                    if( offset < x1end ) return op( x1s[offset / sizeof(X1)] );
+                    if( offset < x2end ) return op( x2s[(offset - x1end) / sizeof(X2)] );
+
+                    if( offset < yend )
+                    {
+                       int idx = (offset - x2end) / sizeof(Y);
+
+                       int idx1 = R - 1 - idx/C;  // TS likes the rows in reverse order
+                       int idx2 = idx%C;
+
+                       return op( cell(idx1,idx2) );
+                    }
+
+                    return 0;
+                  }
+
+
+    const X1&     x1( int i ) const     { return x1s[i]; }
+    const X2&     x2( int j ) const     { return x2s[j]; }
+    // Call modified() after writing cells thru cell(), so cached data such
+    // as the CRC is refreshed.
+    Y&            cell( int i, int j )  { return ys[i*C + j]; }
+    const Y&      cell( int i, int j ) const
+                                        { return ys[i*C + j]; }
+    const Y&      y( int i, int j ) const
+                                        { return cell(i,j); }
+
+    // Find the cell (i,j) containing (x1,x2), after clamping to the axes,
+    // and the fractions dx1 and dx2 within that cell.
+    template<typename T>
+    void          locate( X1 x1, X2 x2, int& i, int& j, T& dx1, T& dx2 ) const
+                  {
+                    if (x1 < x1s[0])      { x1 = x1s[0];   } // minimum
+                    if (x1 > x1s[R-1])    { x1 = x1s[R-1]; } // maximum
+                    if (x2 < x2s[0])      { x2 = x2s[0];   } // minimum
+                    if (x2 > x2s[C-1])    { x2 = x2s[C-1]; } // maximum
+
+                    i   = search( x1s, R, x1 );
+                    j   = search( x2s, C, x2 );
+                    dx1 = fraction<T>( x1, x1s[i], x1s[i+1] );
+                    dx2 = fraction<T>( x2, x2s[j], x2s[j+1] );
+                  }
+
+    Y             f( X1 x1, X2 x2 ) const
+                  {
+                    if (x1 < x1s[0])      { x1 = x1s[0];   } // minimum
+                    if (x1 > x1s[R-1])    { x1 = x1s[R-1]; } // maximum
+                    if (x2 < x2s[0])      { x2 = x2s[0];   } // minimum
+                    if (x2 > x2s[C-1])    { x2 = x2s[C-1]; } // maximum
+
+                    int i = search( x1s, R, x1 );
+                    int j = search( x2s, C, x2 );
+
+                    return interpolate( x1,       x2,
+                                        x1s[i],   x1s[i+1],   x2s[j],       x2s[j+1],
+                                        cell(i,j), cell(i+1,j), cell(i+1,j+1), cell(i,j+1));
+                  }
+
+    // approximate f(x1,x2) for a stream of (nearly) sorted inputs, see
+    // Map3DCore.
+    Y             f( X1 x1, X2 x2, MapCursor& c ) const
+                  {
+                    if (x1 < x1s[0])      { x1 = x1s[0];   } // minimum
+                    if (x1 > x1s[R-1])    { x1 = x1s[R-1]; } // maximum
+                    if (x2 < x2s[0])      { x2 = x2s[0];   } // minimum
+                    if (x2 > x2s[C-1])    { x2 = x2s[C-1]; } // maximum
+
+                    int i = c.i = walk( x1s, R, x1, c.i );
+                    int j = c.j = walk( x2s, C, x2, c.j );
+
+                    return interpolate( x1,       x2,
+                                        x1s[i],   x1s[i+1],   x2s[j],       x2s[j+1],
+                                        cell(i,j), cell(i+1,j), cell(i+1,j+1), cell(i,j+1));
+                  }
+
+    // approximate y[k] = f(x1[k],x2[k]) for n (nearly) sorted inputs
+    void          f( const X1* x1, const X2* x2, Y* y, int n ) const
+                  {
+                    MapCursor c;
+
+                    for( int k=0; k<n; k++ ) { y[k] = f( x1[k], x2[k], c ); }
+                  }
+
+    void          modified()            { valid = 0; }
+
+protected:
+
+    int           R;                    // rows
+    int           C;                    // columns
+    X1*           x1s;                  // in the arena
+    X2*           x2s;
+    Y*            ys;
+
+    uint8_t       valid;                // MapValid bits
+};
+
+
+//-----------------------------------------------------------------------------
+// Run time sized 2D and 3D maps with the Map interface.
+//-----------------------------------------------------------------------------
+
+template<typename X, typename Y>
+class DynMap2D : public MapAdapter< DynMap2DCore<X,Y> >
+{};
+
+template<typename X1, typename Y, typename X2 = X1>
+class DynMap3D : public MapAdapter< DynMap3DCore<X1,Y,X2> >
+{};
+
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+
+#endif // End multi-include protection
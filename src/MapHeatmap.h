@@ -0,0 +1,234 @@
+//-----------------------------------------------------------------------------
+// Cell usage heatmaps of maps
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2018 Arend Lammertink
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, version 3.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+// for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+//
+// Description:
+//
+// To place breakpoints where the engine actually runs, and to spot cells that
+// are never used, Map2D and Map3D can count how often each cell is visited by
+// f(). Define MAP_HEATMAP before including Map2D3D.h to enable this:
+//
+//   #define MAP_HEATMAP
+//   #include "Map2D3D.h"
+//
+//   veMap.f( rpm, map );                     // counts the 4 corners used
+//   ...
+//   veMap.heatmap().sendTo( s );             // or printTo, writeTo a file
+//
+// Each lookup adds MAP_HEAT_ONE to the heatmap, divided over the cells used
+// according to their interpolation weights, so a lookup right on a break
+// point counts for that cell only. Weights are computed in 1/16 steps.
+//
+// The counters are MAP_HEAT_COUNTER, uint16_t by default, and saturate at
+// their maximum. decay() halves all counters, which keeps the picture while
+// making room for new counts.
+//
+// Without MAP_HEATMAP the maps have no heatmap, and f() is not changed. As it
+// changes the size of the maps, define it for the whole program, e.g. in the
+// build flags, rather than in a single source file.
+//
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// Multi-include protection
+//-----------------------------------------------------------------------------
+
+#ifndef _MAP_HEATMAP_H
+#define _MAP_HEATMAP_H
+
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <Print.h>
+#include "interpolate.h"
+#include "ExtendedSerial.h"
+
+#if defined(MAP_HEATMAP) && !defined(ARDUINO)
+#include <stdio.h>
+#endif
+
+
+//-----------------------------------------------------------------------------
+// Defines
+//-----------------------------------------------------------------------------
+
+#ifdef MAP_HEATMAP
+    #define MAP_HEAT(expression)    expression
+#else
+    #define MAP_HEAT(expression)
+#endif
+
+#define MAP_HEAT_ONE        16          // weight of a single lookup
+
+#ifndef MAP_HEAT_COUNTER
+#define MAP_HEAT_COUNTER    uint16_t
+#endif
+
+
+#ifdef MAP_HEATMAP
+//-----------------------------------------------------------------------------
+// Interpolation weights, in 1/MAP_HEAT_ONE steps, 0 .. MAP_HEAT_ONE.
+//-----------------------------------------------------------------------------
+
+// From a fraction dx, 0 <= dx <= 1, as computed by fraction().
+
+template<typename T>
+inline uint8_t heatWeight( T dx )
+{
+    return castTo<uint8_t>( dx * castTo<T>( (int16_t)MAP_HEAT_ONE ) );
+}
+
+// Of x between x_1 and x_2, x_1 <= x <= x_2.
+
+template<typename X>
+inline uint8_t heatFraction( X x, X x_1, X x_2 )
+{
+    return static_cast<uint8_t>( (int32_t)(x - x_1) * MAP_HEAT_ONE / (int32_t)(x_2 - x_1) );
+}
+
+inline uint8_t heatFraction( float x, float x_1, float x_2 )
+{
+    return static_cast<uint8_t>( (x - x_1) * MAP_HEAT_ONE / (x_2 - x_1) );
+}
+
+inline uint8_t heatFraction( double x, double x_1, double x_2 )
+{
+    return static_cast<uint8_t>( (x - x_1) * MAP_HEAT_ONE / (x_2 - x_1) );
+}
+
+#ifdef SUPPORT_INTEGER_ARITMETHIC
+inline uint8_t heatFraction( Fix16 x, Fix16 x_1, Fix16 x_2 )
+{
+    return heatWeight( (x - x_1) / (x_2 - x_1) );
+}
+#endif
+
+
+//-----------------------------------------------------------------------------
+// Weighted hit counters of the R x C cells of a map, C is 1 for a 2D map.
+// Cell (i,j) is counter i*C + j, regardless of the storage layout of the map.
+//-----------------------------------------------------------------------------
+
+template<int R, int C = 1>
+class MapHeatmap
+{
+public:
+    typedef MAP_HEAT_COUNTER  counter_type;
+
+                  MapHeatmap()          { clear(); }
+
+    void          clear()
+                  {
+                    for( int k=0; k<R*C; k++ ) counts[k] = 0;
+                    lookups = 0;
+                  }
+
+    // Halve all counters.
+    void          decay()
+                  {
+                    for( int k=0; k<R*C; k++ ) counts[k] >>= 1;
+                    lookups >>= 1;
+                  }
+
+    counter_type  count( int i, int j = 0 ) const   { return counts[i*C + j]; }
+
+    // Number of lookups counted since clear().
+    uint32_t      size() const                      { return lookups; }
+
+    // Lookup in segment i, u/16 of the way to i+1.
+    void          hit( int i, uint8_t u )
+                  {
+                    lookups++;
+                    add( i,   MAP_HEAT_ONE - u );
+                    add( i+1, u );
+                  }
+
+    // Lookup in cell (i,j), u/16 of the way to row i+1 and v/16 of the way
+    // to column j+1.
+    void          hit( int i, int j, uint8_t u, uint8_t v )
+                  {
+                    const uint8_t w = (u * v) / MAP_HEAT_ONE;   // (i+1,j+1)
+
+                    lookups++;
+                    add(  i   *C + j,   MAP_HEAT_ONE - u - v + w );
+                    add( (i+1)*C + j,   u - w );
+                    add(  i   *C + j+1, v - w );
+                    add( (i+1)*C + j+1, w );
+                  }
+
+    // Lookup exactly on cell k, e.g. outside the axis of a 2D map.
+    void          hitCell( int k )      { lookups++; add( k, MAP_HEAT_ONE ); }
+
+    // Send the R*C counters, row by row.
+    void          sendTo( ExtendedSerial& s )
+                  {
+                    s.beginSend();
+                    for( int k=0; k<R*C; k++ ) s.send( counts[k] );
+                    s.endSend();
+                  }
+
+    // Print the counters as a grid, one row per line.
+    void          printTo( Print& p, const char delim = ' ' ) const
+                  {
+                    for( int i=0; i<R; i++ )
+                    {
+                      for( int j=0; j<C; j++ )
+                      {
+                        if( j ) p.write( delim );
+                        p.print( (unsigned long)count(i,j) );
+                      }
+                      p.println();
+                    }
+                  }
+
+#ifndef ARDUINO
+    // Write the counters to f as comma separated values, one row per line.
+    bool          writeTo( FILE* f ) const
+                  {
+                    for( int i=0; i<R; i++ )
+                      for( int j=0; j<C; j++ )
+                        if( fprintf( f, j < C-1 ? "%lu," : "%lu\n",
+                                     (unsigned long)count(i,j) ) < 0 ) return false;
+
+                    return true;
+                  }
+#endif
+
+protected:
+
+    void          add( int k, uint8_t w )
+                  {
+                    const counter_type max = (counter_type)~(counter_type)0;
+
+                    counts[k] = w > max - counts[k] ? max : counts[k] + w;
+                  }
+
+    counter_type  counts[R*C];
+    uint32_t      lookups;
+};
+#endif // MAP_HEATMAP
+
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+
+#endif // End multi-include protection
@@ -0,0 +1,326 @@
+//-----------------------------------------------------------------------------
+// Lazy loading of maps from persistent storage
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2018 Arend Lammertink
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, version 3.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+// for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+//
+// Description:
+//
+// Not all maps are needed to start an engine. Maps such as launch control or
+// flat shift may not be used for minutes, so loading them at boot only delays
+// the first injection. A Lazy map is loaded on first use instead:
+//
+//   Lazy< Map3D<8, 8, int16_t, uint8_t> >  launchMap;
+//
+//   storage.add( veMap,     1 );             // loaded by boot()
+//   storage.add( launchMap, 1 );             // loaded on demand
+//
+// The first call of f(), of an accessor such as y() or cell(), or of sendTo,
+// printTo, crc or receiveFrom thru the Map interface loads the map from its
+// MapLoader, e.g. a MapStorage. After that, each call costs a single compare.
+//
+// Maps can also be loaded ahead of use, in slices of a bounded number of
+// bytes, from the main loop:
+//
+//   LazyLoader<4>  loader;
+//
+//   loader.add( launchMap );
+//   loader.add( flatShiftMap );
+//
+//   loader.hint( flatShiftMap );             // needed soon, load first
+//   loader.step( 64 );                       // in the main loop
+//
+// A loader verifies a map before changing it, so if a map cannot be loaded,
+// it keeps its previous contents, e.g. its compiled-in defaults.
+//
+// Functions taking the map core directly, such as rasterize(), do not load
+// the map; call load() first. Setters do not load the map either, so a later
+// load overwrites what they set. After setting the whole map, call
+// rewritten() to prevent this.
+//
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// Multi-include protection
+//-----------------------------------------------------------------------------
+
+#ifndef _MAP_LAZY_H
+#define _MAP_LAZY_H
+
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+
+#include "Map2D3D.h"
+
+
+//-----------------------------------------------------------------------------
+// Source of the contents of lazy maps.
+//-----------------------------------------------------------------------------
+
+// Progress of loading a map, kept by the map between calls of its loader.
+struct MapLoadProgress
+{
+    uint16_t      offset;               // bytes done in this pass
+    uint32_t      crc;                  // of the bytes verified so far
+    int8_t        source;               // e.g. a bank, -1 before the start
+    uint8_t       pass;                 // e.g. verifying or receiving
+};
+
+
+class MapLoader
+{
+  public:
+    virtual         ~MapLoader() {}
+
+    // Load the next part of map m, but at most about maxBytes (0: no limit),
+    // and update p. Returns 1 when the map is complete, 0 if there is more,
+    // -1 on failure. m must not be changed before its contents are verified,
+    // so on failure it is left as it was.
+    virtual int8_t  load( Map& m, MapLoadProgress& p, size_t maxBytes )   =0;
+};
+
+
+//-----------------------------------------------------------------------------
+// Load state of a lazy map, independent of its type.
+//-----------------------------------------------------------------------------
+
+class LazyBase
+{
+public:
+    enum          { LAZY_UNLOADED, LAZY_LOADING, LAZY_LOADED, LAZY_FAILED };
+
+                  LazyBase( Map& self )
+                    : self(self), loader(0), state(LAZY_LOADED) {}
+
+    // Load the map from l on first use. Until attached, the map behaves as a
+    // normal map.
+    void          attach( MapLoader& l )
+                  {
+                    loader          = &l;
+                    progress.offset = 0;
+                    progress.crc    = 0;
+                    progress.source = -1;
+                    progress.pass   = 0;
+                    state           = LAZY_UNLOADED;
+                  }
+
+    uint8_t       loadState() const     { return state; }
+    bool          loaded() const        { return state == LAZY_LOADED; }
+
+    // Load the rest of the map now. Returns false if it could not be loaded,
+    // in which case it keeps its previous contents. It is then not loaded
+    // again, and cannot be committed, until it is written as a whole.
+    bool          load()
+                  {
+                    while( state == LAZY_UNLOADED ) step( 0 );
+
+                    return state == LAZY_LOADED;
+                  }
+
+    // Load at most about maxBytes more of the map. Returns true when nothing
+    // is left to load.
+    bool          prefetch( size_t maxBytes )
+                  {
+                    if( state == LAZY_UNLOADED ) step( maxBytes );
+
+                    return state != LAZY_UNLOADED;
+                  }
+
+    // The whole map was written, e.g. thru its setters. It is no longer
+    // loaded, and a failed load is forgotten.
+    void          rewritten()           { state = LAZY_LOADED; }
+
+protected:
+
+    void          ensure()              { if( state == LAZY_UNLOADED ) load(); }
+
+    void          step( size_t maxBytes )
+                  {
+                    state = LAZY_LOADING;       // the loader uses the map too
+
+                    const int8_t r = loader->load( self, progress, maxBytes );
+
+                    state = r > 0 ? LAZY_LOADED : r < 0 ? LAZY_FAILED : LAZY_UNLOADED;
+                  }
+
+    Map&            self;
+    MapLoader*      loader;
+    MapLoadProgress progress;
+    uint8_t         state;
+};
+
+
+//-----------------------------------------------------------------------------
+// Map M, loaded on first use. M is a map with the Map interface, such as a
+// Map2D, Map3D or Map3DBank.
+//-----------------------------------------------------------------------------
+
+template<class M>
+class Lazy : public M, public LazyBase
+{
+public:
+                  Lazy() : LazyBase( static_cast<Map&>(*this) ) {}
+
+    // Lookups and accessors, forwarded to M after loading. MM defers the
+    // lookup, so M need not have all of them.
+    template<class MM = M, typename... A>
+    auto          f( A&&... a )   -> decltype( static_cast<MM*>(0)->f( static_cast<A&&>(a)... ) )
+                  { ensure(); return M::f( static_cast<A&&>(a)... ); }
+
+    template<class MM = M, typename... A>
+    auto          x( A&&... a )   -> decltype( static_cast<MM*>(0)->x( static_cast<A&&>(a)... ) )
+                  { ensure(); return M::x( static_cast<A&&>(a)... ); }
+
+    template<class MM = M, typename... A>
+    auto          x1( A&&... a )  -> decltype( static_cast<MM*>(0)->x1( static_cast<A&&>(a)... ) )
+                  { ensure(); return M::x1( static_cast<A&&>(a)... ); }
+
+    template<class MM = M, typename... A>
+    auto          x2( A&&... a )  -> decltype( static_cast<MM*>(0)->x2( static_cast<A&&>(a)... ) )
+                  { ensure(); return M::x2( static_cast<A&&>(a)... ); }
+
+    template<class MM = M, typename... A>
+    auto          y( A&&... a )   -> decltype( static_cast<MM*>(0)->y( static_cast<A&&>(a)... ) )
+                  { ensure(); return M::y( static_cast<A&&>(a)... ); }
+
+    template<class MM = M, typename... A>
+    auto          cell( A&&... a ) -> decltype( static_cast<MM*>(0)->cell( static_cast<A&&>(a)... ) )
+                  { ensure(); return M::cell( static_cast<A&&>(a)... ); }
+
+    // Map interface
+    virtual void  printTo( Print& p, const uint8_t tabsize = 4, const char delim = ' ' )
+                  { ensure(); M::printTo( p, tabsize, delim ); }
+
+    virtual void  sendTo( ExtendedSerial& s)
+                  { ensure(); M::sendTo( s ); }
+
+    virtual size_t sendRange( ExtendedSerial& s, map_offset_t offset, size_t nr_bytes)
+                  { ensure(); return M::sendRange( s, offset, nr_bytes ); }
+
+    virtual uint32_t crc( ExtendedSerial::ByteOrder order =
+                          ExtendedSerial::WIRE_LITTLE_ENDIAN)
+                  { ensure(); return M::crc( order ); }
+
+    // A partial write must not be overwritten by a later load, so the map is
+    // loaded first. Loading uses the receive state, which is kept. Receiving
+    // the whole map at once makes it loaded, also after a failed load.
+    virtual bool  receiveFrom( ExtendedSerial& s, size_t maxBytes = 0)
+                  {
+                    if( state == LAZY_UNLOADED )
+                    {
+                      const size_t       toReceive = this->bytesToReceive;
+                      const size_t       received  = this->bytesReceived;
+                      const map_offset_t cur       = this->curOffset;
+
+                      load();
+
+                      this->bytesToReceive = toReceive;
+                      this->bytesReceived  = received;
+                      this->curOffset      = cur;
+                    }
+
+                    const bool done = M::receiveFrom( s, maxBytes );
+
+                    if( done && state == LAZY_FAILED &&
+                        this->curOffset == this->bytesReceived &&       // from 0
+                        this->bytesReceived >= (size_t)M::memSize() ) rewritten();
+
+                    return done;
+                  }
+
+#ifdef AVR
+    // Storing a map which is not loaded would overwrite the stored contents
+    // with stale ones, so it is loaded first. A map which could not be loaded
+    // is not stored.
+    virtual bool  updateEeprom(uint8_t* dest) const
+                  {
+                    if( state == LAZY_UNLOADED ) const_cast<Lazy*>(this)->load();
+                    if( state != LAZY_LOADED )   return false;
+
+                    return M::updateEeprom( dest );
+                  }
+
+    virtual bool  readEeprom(const uint8_t* src)
+                  {
+                    if( !M::readEeprom( src ) ) return false;
+
+                    state = LAZY_LOADED;
+                    return true;
+                  }
+#endif
+};
+
+
+//-----------------------------------------------------------------------------
+// Loads up to N lazy maps in the background, in the order in which they are
+// added, unless hinted otherwise.
+//-----------------------------------------------------------------------------
+
+template<int N>
+class LazyLoader
+{
+public:
+                  LazyLoader() : n(0) {}
+
+    bool          add( LazyBase& m )
+                  {
+                    if( n >= N ) return false;
+
+                    queue[n++] = &m;
+                    return true;
+                  }
+
+    // Move m to the front of the queue, e.g. when it will be needed soon.
+    void          hint( LazyBase& m )
+                  {
+                    int i = 0;
+
+                    while( i < n && queue[i] != &m ) i++;
+                    if( i == n ) return;
+
+                    for( ; i > 0; i-- ) queue[i] = queue[i-1];
+                    queue[0] = &m;
+                  }
+
+    // Load at most about maxBytes of the first map in the queue which is not
+    // loaded yet. Returns true when all maps are loaded (or failed to).
+    bool          step( size_t maxBytes )
+                  {
+                    for( int i=0; i<n; i++ )
+                    {
+                      if( queue[i]->loadState() != LazyBase::LAZY_UNLOADED ) continue;
+
+                      queue[i]->prefetch( maxBytes );
+                      return false;
+                    }
+
+                    return true;
+                  }
+
+protected:
+
+    LazyBase*     queue[N];
+    int           n;
+};
+
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+
+#endif // End multi-include protection
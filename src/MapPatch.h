@@ -0,0 +1,391 @@
+//-----------------------------------------------------------------------------
+// Patches between snapshots of a calibration
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2018 Arend Lammertink
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, version 3.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+// for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+//
+// Description:
+//
+// After a tuning session, typically only a handful of cells in a few maps
+// have changed. Rather than sending every map in full, the differences
+// between two snapshots of a set of maps are sent as patches, each covering
+// a range of bytes of the wire image (see Map::sendTo) of one map:
+//
+//   MapSnapshot<8, 4096>  before, after;
+//   MapDiff<64, 1024>     diff;
+//
+//   before.take( maps, 8 );
+//   ...                                   // tune
+//   after.take( maps, 8 );
+//
+//   diff.diff( maps, 8, before, after );
+//   diff.sendTo( s );
+//
+// Ranges lie on element boundaries. Two ranges are merged when the bytes in
+// between are no more than the header of a patch, so the total number of
+// bytes on the wire is minimal.
+//
+// The receiving side writes the ranges thru initReceive/receiveFrom of the
+// maps, so caches of modified maps are invalidated as usual:
+//
+//   MapPatcher patcher( maps, 8 );
+//
+//   patcher.start();
+//   while( !patcher.receiveFrom(s, 64) ) { ... }
+//
+// On the wire, a patch is:
+//
+//   map     uint8_t     index of the map, MAP_PATCH_END ends the stream
+//   offset  uint16_t    in the wire image of the map
+//   size    uint16_t    number of bytes
+//   bytes   size bytes  as in the wire image
+//
+// Both snapshots and the receiver must use the same byte order.
+//
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// Multi-include protection
+//-----------------------------------------------------------------------------
+
+#ifndef _MAP_PATCH_H
+#define _MAP_PATCH_H
+
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+
+#include "Map2D3D.h"
+#include "Transport.h"
+
+
+//-----------------------------------------------------------------------------
+// Defines
+//-----------------------------------------------------------------------------
+
+#define MAP_PATCH_HEADER    5       // bytes per patch on the wire
+#define MAP_PATCH_END       0xFF
+
+
+//-----------------------------------------------------------------------------
+// Wire images of up to N maps, taken at the same moment, stored back to back
+// in SIZE bytes.
+//-----------------------------------------------------------------------------
+
+template<int N, uint16_t SIZE>
+class MapSnapshot
+{
+public:
+                  MapSnapshot() : n(0), used(0) {}
+
+    // Take the wire images of maps[0] .. maps[count-1]. Returns false if they
+    // do not fit.
+    bool          take( Map* const* maps, uint8_t count,
+                        ExtendedSerial::ByteOrder order = ExtendedSerial::WIRE_LITTLE_ENDIAN )
+                  {
+                    n    = 0;
+                    used = 0;
+
+                    if( count > N ) return false;
+
+                    for( uint8_t i=0; i<count; i++ )
+                    {
+                      const int size = maps[i]->memSize();
+
+                      if( size > SIZE - used ) return false;
+
+                      BufferTransport bt( data + used, size );
+                      ExtendedSerial  s(bt);
+
+                      s.setByteOrder( order );
+                      maps[i]->sendTo( s );
+
+                      start[i] = used;
+                      sizes[i] = size;
+                      used    += size;
+                      n++;
+                    }
+
+                    return true;
+                  }
+
+    int           size() const                  { return n;             }
+    const uint8_t* image( int i ) const         { return data + start[i]; }
+    uint16_t      imageSize( int i ) const      { return sizes[i];      }
+
+protected:
+
+    uint8_t       data[SIZE];
+    uint16_t      start[N];
+    uint16_t      sizes[N];
+    uint8_t       n;
+    uint16_t      used;
+};
+
+
+//-----------------------------------------------------------------------------
+// A range of bytes to be written in the wire image of a map.
+//-----------------------------------------------------------------------------
+
+struct MapPatch
+{
+    uint8_t       map;                  // index of the map
+    uint16_t      offset;               // in the wire image
+    uint16_t      size;                 // bytes
+    uint16_t      data;                 // start of the bytes in the data pool
+};
+
+
+//-----------------------------------------------------------------------------
+// Up to N patches, with their bytes stored in a pool of DATA bytes.
+//-----------------------------------------------------------------------------
+
+template<int N, uint16_t DATA>
+class MapDiff
+{
+public:
+                  MapDiff() : n(0), used(0) {}
+
+    void          clear()                       { n = 0; used = 0;      }
+
+    // Append the patches turning wire image 'from' of map m into image 'to'.
+    // 'id' is the index of the map on the receiving side. Returns false if
+    // the patches do not fit, in which case m should be sent in full.
+    bool          diff( Map& m, uint8_t id, const uint8_t* from, const uint8_t* to )
+                  {
+                    if( m.memSize() > 0xFFFF ) return false;          // offsets are 16 bit
+
+                    const uint16_t size = m.memSize();
+
+                    if( memcmp( from, to, size ) == 0 ) return true;   // unchanged
+
+                    uint16_t  begin = 0, end = 0;                     // open range
+                    bool      open  = false;
+
+                    for( uint16_t offset = 0; offset < size; )
+                    {
+                      const uint16_t es = m.elementSize( offset );
+
+                      if( es == 0 ) break;
+
+                      if( memcmp( from + offset, to + offset, es ) != 0 )
+                      {
+                        if( open && offset - end > MAP_PATCH_HEADER )
+                        {
+                          if( !add( id, begin, end - begin, to ) ) return false;
+                          open = false;
+                        }
+
+                        if( !open ) { begin = offset; open = true; }
+                        end = offset + es;
+                      }
+
+                      offset += es;
+                    }
+
+                    return !open || add( id, begin, end - begin, to );
+                  }
+
+    // Compare two snapshots of maps[0] .. maps[count-1].
+    template<int M, uint16_t SIZE>
+    bool          diff( Map* const* maps, uint8_t count,
+                        const MapSnapshot<M,SIZE>& from, const MapSnapshot<M,SIZE>& to )
+                  {
+                    if( count > from.size() || count > to.size() ) return false;
+
+                    for( uint8_t i=0; i<count; i++ )
+                    {
+                      if( from.imageSize(i) != maps[i]->memSize() ||
+                          to.imageSize(i)   != maps[i]->memSize() ) return false;
+
+                      if( !diff( *maps[i], i, from.image(i), to.image(i) ) ) return false;
+                    }
+
+                    return true;
+                  }
+
+    int           size() const                  { return n;             }
+    const MapPatch& patch( int i ) const        { return patches[i];    }
+    const uint8_t* bytes( int i ) const         { return data + patches[i].data; }
+
+    // Bytes sent by sendTo(), including the end marker.
+    size_t        wireSize() const              { return n*MAP_PATCH_HEADER + used + 1; }
+
+    void          sendTo( ExtendedSerial& s )
+                  {
+                    s.beginSend();
+
+                    for( int i=0; i<n; i++ )
+                    {
+                      const MapPatch& p = patches[i];
+
+                      s.send( p.map    );
+                      s.send( p.offset );
+                      s.send( p.size   );
+                      s.write( data + p.data, p.size );
+                    }
+
+                    s.send( (uint8_t)MAP_PATCH_END );
+                    s.endSend();
+                  }
+
+    // Apply the patches to maps directly, e.g. to a copy of the calibration
+    // on the host. Returns false if a patch refers to an unknown map.
+    bool          apply( Map* const* maps, uint8_t count,
+                         ExtendedSerial::ByteOrder order = ExtendedSerial::WIRE_LITTLE_ENDIAN )
+                  {
+                    for( int i=0; i<n; i++ )
+                    {
+                      const MapPatch& p = patches[i];
+
+                      if( p.map >= count ) return false;
+
+                      BufferTransport bt = BufferTransport::reader( bytes(i), p.size );
+                      ExtendedSerial  s(bt);
+
+                      s.setByteOrder( order );
+
+                      maps[p.map]->initReceive( p.offset, p.size );
+                      if( !maps[p.map]->receiveFrom( s ) ) return false;
+                    }
+
+                    return true;
+                  }
+
+protected:
+
+    bool          add( uint8_t id, uint16_t offset, uint16_t size, const uint8_t* to )
+                  {
+                    if( n >= N || size > DATA - used ) return false;
+
+                    MapPatch& p = patches[n++];
+
+                    p.map    = id;
+                    p.offset = offset;
+                    p.size   = size;
+                    p.data   = used;
+
+                    memcpy( data + used, to + offset, size );
+                    used += size;
+
+                    return true;
+                  }
+
+    MapPatch      patches[N];
+    uint8_t       data[DATA];
+    int           n;
+    uint16_t      used;
+};
+
+
+//-----------------------------------------------------------------------------
+// Receives a stream of patches, as sent by MapDiff::sendTo, into maps[0] ..
+// maps[count-1]. Patches for unknown maps are skipped.
+//-----------------------------------------------------------------------------
+
+class MapPatcher
+{
+public:
+                  MapPatcher( Map* const* maps, uint8_t count )
+                    : maps(maps), count(count)  { start(); }
+
+    // Expect a new stream of patches.
+    void          start()                       { state = HEADER; applied = 0; }
+
+    bool          done() const                  { return state == DONE; }
+
+    // Number of patches applied since start().
+    uint16_t      patches() const               { return applied;       }
+
+    // Receive the available data, but at most about maxBytes (0: no limit)
+    // per call, see Map::receiveFrom. Returns true when the end of the
+    // stream has been received.
+    bool          receiveFrom( ExtendedSerial& s, size_t maxBytes = 0 )
+                  {
+                    size_t slice = 0;
+
+                    while( state != DONE )
+                    {
+                      if( maxBytes && slice >= maxBytes ) return false;
+
+                      switch( state )
+                      {
+                        case HEADER:
+                        {
+                          if( s.peek() == MAP_PATCH_END ) { s.read(); state = DONE; break; }
+                          if( s.available() < MAP_PATCH_HEADER ) return false;
+
+                          uint16_t offset;
+
+                          s.receive( cur );
+                          s.receive( offset );
+                          s.receive( remaining );
+                          slice += MAP_PATCH_HEADER;
+
+                          if( cur < count )
+                          {
+                            maps[cur]->initReceive( offset, remaining );
+                            state = DATA;
+                          }
+                          else state = SKIP;
+
+                          break;
+                        }
+
+                        case DATA:
+                          if( !maps[cur]->receiveFrom( s, maxBytes ? maxBytes - slice : 0 ) )
+                            return false;
+
+                          slice += remaining;   // upper bound for this call
+                          applied++;
+                          state = HEADER;
+                          break;
+
+                        case SKIP:
+                          if( remaining == 0 )    { state = HEADER; break; }
+                          if( s.available() <= 0 ) return false;
+
+                          s.read();
+                          remaining--;
+                          slice++;
+                          break;
+                      }
+                    }
+
+                    return true;
+                  }
+
+protected:
+
+    enum          { HEADER, DATA, SKIP, DONE };
+
+    Map* const*   maps;
+    uint8_t       count;
+
+    // receive state
+    uint8_t       state;
+    uint8_t       cur;                  // map being patched
+    uint16_t      remaining;            // bytes of the patch
+    uint16_t      applied;
+};
+
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+
+#endif // End multi-include protection
@@ -0,0 +1,286 @@
+//-----------------------------------------------------------------------------
+// Latency histograms of map lookups
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2018 Arend Lammertink
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, version 3.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+// for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+//
+// Description:
+//
+// Code with hard deadlines, such as an ignition scheduler, needs to know the
+// worst case cost of a lookup, not just the average. The duration of each
+// lookup is measured with mapCycles() and recorded in a LatencyHistogram:
+//
+//   LatencyHistogram  h;
+//
+//   uint32_t t0 = mapCycles();
+//   y = veMap.f( rpm, load );
+//   h.add( mapCycles() - t0 );
+//   ...
+//   h.printTo( Serial );                     // n, p50, p99 and max
+//
+// or, for every lookup of a map, with the Profiled wrapper:
+//
+//   Profiled< Map3D<16, 16, int16_t, uint8_t> >  veMap;
+//
+//   veMap.latency().printTo( Serial );
+//
+// mapCycles() counts:
+//
+//   x86          TSC ticks, using rdtsc
+//   Cortex-M3/4  CPU cycles, using the DWT cycle counter, see mapCyclesInit()
+//   other MCUs   microseconds, using micros()
+//   other hosts  nanoseconds, using clock_gettime()
+//
+// The histogram has 4 buckets per power of 2, so a percentile is reported
+// within 25% (its upper bound is reported). The maximum is kept exactly.
+//
+// The search for the cell of a lookup takes a number of steps, and branches,
+// that depend on x. Define MAP_CONSTANT_TIME_SEARCH to use a fixed number of
+// steps per axis instead, see search() in Map2D3D.h, so the worst case equals
+// the typical case.
+//
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// Multi-include protection
+//-----------------------------------------------------------------------------
+
+#ifndef _MAP_PROFILE_H
+#define _MAP_PROFILE_H
+
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <Print.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#elif defined(ARDUINO)
+#include <Arduino.h>
+#else
+#include <time.h>
+#endif
+
+
+//-----------------------------------------------------------------------------
+// Cycle counter
+//-----------------------------------------------------------------------------
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#define MAP_CYCLE_UNIT      "ticks"
+
+inline void     mapCyclesInit()         {}
+inline uint32_t mapCycles()             { return (uint32_t)__rdtsc(); }
+
+#elif defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)
+
+#define MAP_CYCLE_UNIT      "cycles"
+
+#define MAP_DEMCR           (*(volatile uint32_t*)0xE000EDFC)
+#define MAP_DWT_CTRL        (*(volatile uint32_t*)0xE0001000)
+#define MAP_DWT_CYCCNT      (*(volatile uint32_t*)0xE0001004)
+
+// Enable the DWT cycle counter, once at startup.
+inline void     mapCyclesInit()
+{
+    MAP_DEMCR      |= 1UL << 24;        // TRCENA
+    MAP_DWT_CYCCNT  = 0;
+    MAP_DWT_CTRL   |= 1;                // CYCCNTENA
+}
+
+inline uint32_t mapCycles()             { return MAP_DWT_CYCCNT; }
+
+#elif defined(ARDUINO)
+
+#define MAP_CYCLE_UNIT      "us"
+
+inline void     mapCyclesInit()         {}
+inline uint32_t mapCycles()             { return micros(); }
+
+#else
+
+#define MAP_CYCLE_UNIT      "ns"
+
+inline void     mapCyclesInit()         {}
+inline uint32_t mapCycles()
+{
+    struct timespec t;
+    clock_gettime( CLOCK_MONOTONIC, &t );
+
+    return (uint32_t)( t.tv_sec * 1000000000UL + t.tv_nsec );
+}
+
+#endif
+
+
+//-----------------------------------------------------------------------------
+// Histogram of durations, in units of mapCycles(), with logarithmic buckets.
+// Values 0 .. 3 have a bucket each, above that there are 4 buckets per power
+// of 2.
+//-----------------------------------------------------------------------------
+
+#define LATENCY_BUCKETS     124         // up to 2^32
+
+class LatencyHistogram
+{
+public:
+                  LatencyHistogram() : offset(0) { clear(); }
+
+    void          clear()
+                  {
+                    for( int b=0; b<LATENCY_BUCKETS; b++ ) counts[b] = 0;
+
+                    n      = 0;
+                    maxVal = 0;
+                    minVal = 0xFFFFFFFFUL;
+                  }
+
+    void          add( uint32_t v )
+                  {
+                    counts[bucket(v)]++;
+                    n++;
+
+                    if( v > maxVal ) maxVal = v;
+                    if( v < minVal ) minVal = v;
+                  }
+
+    // Subtract the overhead of measuring, e.g. the minimum of a number of
+    // empty measurements, from each value added later.
+    void          setOffset( uint32_t o )               { offset = o; }
+    void          addRaw( uint32_t v )  { add( v > offset ? v - offset : 0 ); }
+
+    uint32_t      size() const                          { return n;      }
+    uint32_t      max() const                           { return maxVal; }
+    uint32_t      min() const                           { return n ? minVal : 0; }
+
+    // Upper bound of the value below which perMille/1000 of the values lie,
+    // e.g. 500 for the median and 990 for p99.
+    uint32_t      quantile( uint16_t perMille ) const
+                  {
+                    if( n == 0 ) return 0;
+
+                    uint32_t rank = (uint32_t)( ((uint64_t)n * perMille + 999) / 1000 );
+                    uint32_t seen = 0;
+
+                    if( rank == 0 ) rank = 1;
+
+                    for( int b=0; b<LATENCY_BUCKETS; b++ )
+                    {
+                      seen += counts[b];
+
+                      if( seen >= rank )
+                      {
+                        uint32_t upper = upperBound(b);
+                        return upper < maxVal ? upper : maxVal;
+                      }
+                    }
+
+                    return maxVal;
+                  }
+
+    // Print n, p50, p99 and max on a single line.
+    void          printTo( Print& p ) const
+                  {
+                    p.print( F("n ") );     p.print( (unsigned long)n );
+                    p.print( F(" p50 ") );  p.print( (unsigned long)quantile(500) );
+                    p.print( F(" p99 ") );  p.print( (unsigned long)quantile(990) );
+                    p.print( F(" max ") );  p.print( (unsigned long)maxVal );
+                    p.print( F(" " MAP_CYCLE_UNIT) );
+                    p.println();
+                  }
+
+    // Bucket of value v, and the largest value in bucket b.
+    static int    bucket( uint32_t v )
+                  {
+                    if( v < 4 ) return v;
+
+                    int e = 2;
+
+                    while( v >= 8 ) { v >>= 1; e++; }
+
+                    return (e-1)*4 + (v & 3);   // v is 4 .. 7 here
+                  }
+
+    static uint32_t upperBound( int b )
+                  {
+                    if( b < 4 ) return b;
+
+                    const int e = b/4 + 1;
+
+                    return ( (uint32_t)(4 + b%4 + 1) << (e-2) ) - 1;
+                  }
+
+protected:
+
+    uint32_t      counts[LATENCY_BUCKETS];
+    uint32_t      n;
+    uint32_t      maxVal;
+    uint32_t      minVal;
+    uint32_t      offset;
+};
+
+
+//-----------------------------------------------------------------------------
+// Adds the duration of its own lifetime to a histogram.
+//-----------------------------------------------------------------------------
+
+class LatencyTimer
+{
+public:
+                  LatencyTimer( LatencyHistogram& h ) : h(h), t0( mapCycles() ) {}
+                  ~LatencyTimer()       { h.addRaw( mapCycles() - t0 ); }
+
+protected:
+
+    LatencyHistogram& h;
+    const uint32_t    t0;
+};
+
+
+//-----------------------------------------------------------------------------
+// Map M, recording the duration of each call of f() in a histogram. For the
+// variants of f() taking arrays, a call covers all of its lookups.
+//-----------------------------------------------------------------------------
+
+template<class M>
+class Profiled : public M
+{
+public:
+    template<class MM = M, typename... A>
+    auto          f( A&&... a )   -> decltype( static_cast<MM*>(0)->f( static_cast<A&&>(a)... ) )
+                  {
+                    LatencyTimer t( hist );
+
+                    return M::f( static_cast<A&&>(a)... );
+                  }
+
+    LatencyHistogram& latency()         { return hist; }
+
+protected:
+
+    LatencyHistogram hist;
+};
+
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+
+#endif // End multi-include protection
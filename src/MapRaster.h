@@ -0,0 +1,295 @@
+//-----------------------------------------------------------------------------
+// Rasterization of 3D maps onto dense grids
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2018 Arend Lammertink
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, version 3.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+// for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+//
+// Description:
+//
+// For display and comparison of maps in calibration tools, a map is sampled
+// on a regular grid of rows x cols points:
+//
+//   out[r*cols + c] = f( x1lo + r*(x1hi-x1lo)/(rows-1),
+//                        x2lo + c*(x2hi-x2lo)/(cols-1) )
+//
+// Rather than calling f() for every point, each output row is first reduced
+// to a 1D table by interpolating between the two bracketing rows of the map.
+// Within each cell of that table, the values along the row are linear in x2,
+// so they are computed by forward differencing: one addition per point, with
+// no search and no division. On hosts, blocks of rows are distributed over
+// the threads of a RasterPool, which is started once and kept, so repeated
+// rasterization, e.g. on every edit in a tool, does not start threads anew.
+//
+// This is meant for host side tools. The results are computed in double and
+// are not rounded to the type of the map. For float and Fix16 maps they may
+// differ in the last bit(s) from f(). For integer maps f() truncates the
+// interpolated value toward zero, so the rasterized value differs from f()
+// by less than one unit; truncating it gives f(), up to the last bits of a
+// result that lies on an integer.
+//
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// Multi-include protection
+//-----------------------------------------------------------------------------
+
+#ifndef _MAP_RASTER_H
+#define _MAP_RASTER_H
+
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+
+#include "Map2D3D.h"
+
+#ifndef ARDUINO
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif
+
+
+#ifndef ARDUINO
+//-----------------------------------------------------------------------------
+// Persistent pool of worker threads. run() executes job(0) .. job(jobs-1) on
+// the workers and the calling thread, and returns when all are done. Calls of
+// run() from several threads are executed one after the other.
+//-----------------------------------------------------------------------------
+
+class RasterPool
+{
+public:
+    // With threads <= 0, one thread per hardware thread, the caller included.
+                  RasterPool( int threads = 0 ) : task(0), next(0), total(0), pending(0), stop(false)
+                  {
+                    if( threads <= 0 ) threads = std::thread::hardware_concurrency();
+
+                    for( int t=1; t<threads; t++ )
+                      workers.push_back( std::thread( &RasterPool::loop, this ) );
+                  }
+
+                  ~RasterPool()
+                  {
+                    {
+                      std::lock_guard<std::mutex> lock( m );
+                      stop = true;
+                    }
+                    wake.notify_all();
+
+                    for( size_t t=0; t<workers.size(); t++ ) workers[t].join();
+                  }
+
+    // Threads, the caller included.
+    int           size() const          { return (int)workers.size() + 1; }
+
+    void          run( int jobs, const std::function<void(int)>& job )
+                  {
+                    std::lock_guard<std::mutex> one( busy );
+
+                    {
+                      std::lock_guard<std::mutex> lock( m );
+                      task    = &job;
+                      next    = 0;
+                      total   = jobs;
+                      pending = jobs;
+                    }
+                    wake.notify_all();
+
+                    work();
+
+                    std::unique_lock<std::mutex> lock( m );
+                    done.wait( lock, [this] { return pending == 0; } );
+                    task = 0;
+                  }
+
+protected:
+
+    // Take jobs until none are left.
+    void          work()
+                  {
+                    for(;;)
+                    {
+                      int k;
+                      {
+                        std::lock_guard<std::mutex> lock( m );
+                        if( next >= total ) return;
+                        k = next++;
+                      }
+
+                      (*task)( k );
+
+                      std::lock_guard<std::mutex> lock( m );
+                      if( --pending == 0 ) done.notify_all();
+                    }
+                  }
+
+    void          loop()
+                  {
+                    for(;;)
+                    {
+                      {
+                        std::unique_lock<std::mutex> lock( m );
+                        wake.wait( lock, [this] { return stop || next < total; } );
+                        if( stop ) return;
+                      }
+                      work();
+                    }
+                  }
+
+    std::vector<std::thread>          workers;
+    std::mutex                        busy;       // one run() at a time
+    std::mutex                        m;          // guards the members below
+    std::condition_variable           wake;
+    std::condition_variable           done;
+
+    const std::function<void(int)>*   task;
+    int                               next;
+    int                               total;
+    int                               pending;
+    bool                              stop;
+};
+
+
+// A single pool for the whole program, started on first use.
+
+inline RasterPool& rasterPool()
+{
+  static RasterPool pool;
+
+  return pool;
+}
+#endif
+
+
+//-----------------------------------------------------------------------------
+// Rasterize rows [r0, r1) of the grid. See rasterize() below.
+//-----------------------------------------------------------------------------
+
+template<int R, int C, typename X1, typename Y, typename X2, template<int,int> class L>
+void rasterizeRows( const Map3DCore<R,C,X1,Y,X2,L>& map,
+                    double x1lo, double x1hi, int rows,
+                    double x2lo, double x2hi, int cols,
+                    float* out, int r0, int r1 )
+{
+  const double step1 = rows > 1 ? (x1hi - x1lo) / (rows - 1) : 0;
+  const double step2 = cols > 1 ? (x2hi - x2lo) / (cols - 1) : 0;
+
+  const double x1min = castTo<double>(map.x1(0));
+  const double x1max = castTo<double>(map.x1(R-1));
+
+  double a[C];                          // row of the map at x1
+  double x2s[C];
+
+  for( int j=0; j<C; j++ ) { x2s[j] = castTo<double>(map.x2(j)); }
+
+  int i = 0;
+
+  for( int r=r0; r<r1; r++ )
+  {
+    double x1 = x1lo + r*step1;
+
+    if (x1 < x1min)     { x1 = x1min; } // minimum
+    if (x1 > x1max)     { x1 = x1max; } // maximum
+
+    // The rows of the grid are ascending, so walk the x1 axis
+    while ( i < R-2 && x1 >= castTo<double>(map.x1(i+1)) ) i++;
+
+    const double x1_1 = castTo<double>(map.x1(i));
+    const double dx1  = (x1 - x1_1) / (castTo<double>(map.x1(i+1)) - x1_1);
+
+    for( int j=0; j<C; j++ )
+    {
+      a[j] = (1.0-dx1)*castTo<double>(map.y(i,j)) + dx1*castTo<double>(map.y(i+1,j));
+    }
+
+    float* o = out + (size_t)r*cols;
+    int    c = 0;
+
+    // Left of the x2 axis, f is constant
+    for( ; c < cols && x2lo + c*step2 <= x2s[0]; c++ )  { *o++ = a[0]; }
+
+    // Forward differencing within each cell of the x2 axis
+    for( int j=0; j<C-1 && c<cols; j++ )
+    {
+      const double slope = (a[j+1] - a[j]) / (x2s[j+1] - x2s[j]);
+      const double dv    = slope * step2;
+
+      double x2 = x2lo + c*step2;
+      double v  = a[j] + (x2 - x2s[j]) * slope;
+
+      for( ; c < cols && x2lo + c*step2 < x2s[j+1]; c++ )
+      {
+        *o++ = v;
+        v   += dv;
+      }
+    }
+
+    // Right of the x2 axis, f is constant
+    for( ; c < cols; c++ )                              { *o++ = a[C-1]; }
+  }
+}
+
+
+//-----------------------------------------------------------------------------
+// Rasterize a 3D map onto a grid of rows x cols points in out[rows*cols],
+// row by row, with x1 along the rows and x2 along the columns. The grid must
+// be ascending in both directions.
+//
+// The rows are split into 'threads' blocks, which are rasterized by the
+// threads of rasterPool(). With threads <= 0, one block per thread of the
+// pool is used.
+//-----------------------------------------------------------------------------
+
+template<int R, int C, typename X1, typename Y, typename X2, template<int,int> class L>
+void rasterize( const Map3DCore<R,C,X1,Y,X2,L>& map,
+                double x1lo, double x1hi, int rows,
+                double x2lo, double x2hi, int cols,
+                float* out, int threads = 0 )
+{
+#ifndef ARDUINO
+  RasterPool& pool = rasterPool();
+
+  if( threads <= 0 ) threads = pool.size();
+  if( threads > rows ) threads = rows;
+
+  if( threads > 1 )
+  {
+    const int block = (rows + threads - 1) / threads;
+
+    pool.run( threads, [&]( int t )
+    {
+      const int r0 = t*block;
+      const int r1 = r0+block < rows ? r0+block : rows;
+
+      if( r0 < r1 ) rasterizeRows( map, x1lo, x1hi, rows, x2lo, x2hi, cols, out, r0, r1 );
+    } );
+
+    return;
+  }
+#endif
+
+  rasterizeRows( map, x1lo, x1hi, rows, x2lo, x2hi, cols, out, 0, rows );
+}
+
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+
+#endif // End multi-include protection
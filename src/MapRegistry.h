@@ -0,0 +1,252 @@
+//-----------------------------------------------------------------------------
+// Registry of maps, addressed by page and offset as used by tuner protocols
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2018 Arend Lammertink
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, version 3.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+// for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+//
+// Description:
+//
+// Tuners such as TunerStudio read and write the calibration as a number of
+// pages of bytes, with commands like "read nr_bytes from page p at offset o".
+// The registry lays out the wire images (see Map::sendTo) of a number of maps
+// in such pages, back to back in the order in which they are added:
+//
+//   MapRegistry<8, 2, 1024>  registry;    // 8 maps, 2 pages of 1024 bytes
+//
+//   registry.add( veMap,  0 );
+//   registry.add( afrMap, 0 );
+//   registry.add( ignMap, 1 );
+//
+// Each page is divided in slots of 2^SLOT_SHIFT bytes. For each slot, the
+// first map overlapping it is stored in a page table, which is filled in as
+// the maps are added. A (page, offset) is thus resolved by a table lookup,
+// followed by at most a few steps over maps starting within that slot,
+// independent of the number of maps.
+//
+// Reads and writes may span several maps in a page. Bytes of a page which
+// are not covered by a map read as 0 and are ignored when written. Offsets
+// and lengths must lie on element boundaries of the maps.
+//
+// The CRC-32 of a page, as used by tuners to verify it, is combined from the
+// CRCs cached by its maps (see Map::crc), so only maps modified since the
+// previous request are scanned.
+//
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// Multi-include protection
+//-----------------------------------------------------------------------------
+
+#ifndef _MAP_REGISTRY_H
+#define _MAP_REGISTRY_H
+
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+
+#include "Map2D3D.h"
+
+
+//-----------------------------------------------------------------------------
+// Registry of up to N maps in P pages of PAGE_SIZE bytes. N must be < 255.
+//-----------------------------------------------------------------------------
+
+template<int N, int P, uint16_t PAGE_SIZE, uint8_t SLOT_SHIFT = 4>
+class MapRegistry
+{
+public:
+    enum          { SLOTS = (PAGE_SIZE + (1 << SLOT_SHIFT) - 1) >> SLOT_SHIFT,
+                    NONE  = 0xFF };
+
+                  MapRegistry() : n(0), cur(NONE), chunk(0), remaining(0)
+                  {
+                    memset( slots, NONE, sizeof(slots) );
+                    memset( last,  NONE, sizeof(last)  );
+                    memset( used,  0,    sizeof(used)  );
+                  }
+
+    // Append map m to page 'page'. Returns false if the registry is full or
+    // the map does not fit in the remainder of the page.
+    bool          add( Map& m, uint8_t page )
+                  {
+                    const int size = m.memSize();
+
+                    if( n >= N || page >= P || size <= 0 )  return false;
+                    if( size > PAGE_SIZE - used[page] )     return false;
+
+                    maps[n]   = &m;
+                    start[n]  = used[page];
+                    sizes[n]  = size;
+                    next[n]   = NONE;
+
+                    if( last[page] != NONE ) next[last[page]] = n;
+                    last[page] = n;
+
+                    // the maps of a page are added in ascending order, so a
+                    // slot which already has a map keeps it
+                    for( int k = start[n] >> SLOT_SHIFT; k <= (start[n]+size-1) >> SLOT_SHIFT; k++ )
+                      if( slots[page][k] == NONE ) slots[page][k] = n;
+
+                    used[page] += size;
+                    n++;
+
+                    return true;
+                  }
+
+    int           size() const          { return n; }
+    Map&          map( int i )          { return *maps[i]; }
+    uint16_t      pageUsed( uint8_t page ) const
+                                        { return page < P ? used[page] : 0; }
+
+    // Index of the map containing byte 'offset' of page 'page', -1 if none.
+    int           find( uint8_t page, uint16_t offset ) const
+                  {
+                    if( page >= P || offset >= used[page] ) return -1;
+
+                    uint8_t i = slots[page][offset >> SLOT_SHIFT];
+
+                    while( offset >= start[i] + sizes[i] ) i = next[i];
+
+                    return i;
+                  }
+
+    // Send nr_bytes of page 'page', starting at byte 'offset'. Returns the
+    // number of bytes sent.
+    size_t        sendTo( ExtendedSerial& s, uint8_t page, uint16_t offset, size_t nr_bytes )
+                  {
+                    const int f    = find( page, offset );
+                    uint8_t   i    = f < 0 ? NONE : f;
+                    size_t    sent = 0;
+
+                    while( sent < nr_bytes && i != NONE )
+                    {
+                      const uint16_t local = offset + sent - start[i];
+                      size_t         len   = sizes[i] - local;
+
+                      if( len > nr_bytes - sent ) len = nr_bytes - sent;
+
+                      size_t k = maps[i]->sendRange( s, local, len );
+
+                      sent += k;
+                      if( k < len ) return sent;
+
+                      i = next[i];
+                    }
+
+                    for( ; sent < nr_bytes; sent++ ) s.write( (uint8_t)0 );  // not mapped
+
+                    return sent;
+                  }
+
+    // CRC-32 of the PAGE_SIZE bytes of page 'page', as sent by sendTo in the
+    // given byte order.
+    uint32_t      crc( uint8_t page, ExtendedSerial::ByteOrder order =
+                                     ExtendedSerial::WIRE_LITTLE_ENDIAN )
+                  {
+                    if( page >= P ) return 0;
+
+                    uint32_t crc = 0;
+
+                    for( uint8_t i = used[page] ? slots[page][0] : NONE; i != NONE; i = next[i] )
+                      crc = crc32Combine( crc, maps[i]->crc(order), sizes[i] );
+
+                    return crc32Zeros( crc, PAGE_SIZE - used[page] );   // not mapped
+                  }
+
+    // Prepare to receive nr_bytes into page 'page', starting at byte
+    // 'offset'. The data is then received by calls to receiveFrom().
+    void          initReceive( uint8_t page, uint16_t offset, size_t nr_bytes )
+                  {
+                    const int i = find( page, offset );
+
+                    cur       = i < 0 ? NONE : i;
+                    remaining = nr_bytes;
+
+                    startChunk( i < 0 ? 0 : offset - start[i] );
+                  }
+
+    bool          receiveDone() const   { return remaining == 0; }
+
+    // Receive the available data, but at most about maxBytes (0: no limit)
+    // per call, see Map::receiveFrom. Returns true when all nr_bytes passed
+    // to initReceive have been received.
+    bool          receiveFrom( ExtendedSerial& s, size_t maxBytes = 0 )
+                  {
+                    size_t slice = 0;
+
+                    while( remaining )
+                    {
+                      if( maxBytes && slice >= maxBytes ) return false;
+
+                      if( cur == NONE )     // not mapped, skip
+                      {
+                        if( s.available() <= 0 ) return false;
+
+                        s.read();
+                        remaining--;
+                        slice++;
+                        continue;
+                      }
+
+                      if( !maps[cur]->receiveFrom( s, maxBytes ? maxBytes - slice : 0 ) )
+                        return false;
+
+                      slice     += chunk;   // upper bound for this call
+                      remaining -= chunk;
+                      cur        = next[cur];
+
+                      startChunk( 0 );
+                    }
+
+                    return true;
+                  }
+
+protected:
+
+    void          startChunk( uint16_t local )
+                  {
+                    if( cur == NONE ) { chunk = 0; return; }
+
+                    chunk = sizes[cur] - local;
+                    if( chunk > remaining ) chunk = remaining;
+
+                    maps[cur]->initReceive( local, chunk );
+                  }
+
+    Map*          maps[N];
+    uint16_t      start[N];             // offset of the map in its page
+    uint16_t      sizes[N];             // bytes on the wire
+    uint8_t       next[N];              // next map in the same page
+
+    uint8_t       slots[P][SLOTS];      // first map overlapping each slot
+    uint8_t       last[P];              // last map added to each page
+    uint16_t      used[P];              // bytes of each page in use
+
+    uint8_t       n;
+
+    // receive state
+    uint8_t       cur;                  // map being received, NONE if none
+    size_t        chunk;                // bytes to receive into cur
+    size_t        remaining;            // including chunk
+};
+
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+
+#endif // End multi-include protection
@@ -0,0 +1,707 @@
+//-----------------------------------------------------------------------------
+// Power fail safe storage of maps in two banks
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2018 Arend Lammertink
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, version 3.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+// for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+//
+// Description:
+//
+// Map::updateEeprom writes over the only copy of a map, so a brownout while
+// burning leaves a corrupt calibration. MapStorage keeps two banks instead.
+// A commit writes the inactive bank, leaving the active one untouched:
+//
+//   1. its commit byte is cleared
+//   2. the wire images (see Map::sendTo) of the maps are written
+//   3. a header per map (version, length, CRC-32) and the bank header, with
+//      a sequence number one higher than that of the active bank
+//   4. the commit byte is set
+//
+// At any moment, at least one bank is committed. At boot, the committed bank
+// with the highest sequence number is chosen, using its headers only: the
+// commit byte, a CRC over the headers, and the versions and lengths of the
+// maps. Before its maps are read, the CRCs of their stored images are
+// verified as well. If that fails, the other bank is used. If neither bank
+// is valid, the maps are left untouched, e.g. holding compiled-in defaults.
+//
+//   FileStorage       eeprom( "eeprom.bin", 4096 );   // EepromStorage on AVR
+//   MapStorage<8>     storage( eeprom, 0, 2048 );     // 2 banks of 2048 bytes
+//
+//   storage.add( veMap,  1 );                          // map, version
+//   storage.add( ignMap, 1 );
+//
+//   if( storage.boot() < 0 ) { ... }                   // no valid calibration
+//   ...
+//   storage.commit();                                  // e.g. on a burn command
+//
+// Lazy maps (see MapLazy.h) are not loaded by boot(), but on first use, from
+// the bank chosen at boot. Their stored image is verified first, also in
+// slices. If it does not match its CRC, the other bank is tried. The next
+// commit then writes the map as it was loaded.
+//
+// Writes skip bytes which are unchanged, as eeprom_update_block does, and a
+// commit is skipped when the CRCs of all maps equal those in the active bank.
+//
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// Multi-include protection
+//-----------------------------------------------------------------------------
+
+#ifndef _MAP_STORAGE_H
+#define _MAP_STORAGE_H
+
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+
+#include "Map2D3D.h"
+#include "MapLazy.h"
+#include "Transport.h"
+
+#ifndef ARDUINO
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+
+//-----------------------------------------------------------------------------
+// Defines
+//-----------------------------------------------------------------------------
+
+#define STORAGE_MAGIC       0x4D42  // "MB"
+#define STORAGE_COMMITTED   0xA5    // erased EEPROM reads 0xFF
+
+
+//-----------------------------------------------------------------------------
+// Non volatile memory, addressed by byte.
+//-----------------------------------------------------------------------------
+
+class Storage
+{
+  public:
+    virtual         ~Storage() {}
+
+    virtual size_t  size() const                                        =0;
+
+    virtual void    read(   uint16_t addr, uint8_t* dst, size_t n )     =0;
+
+    // Write n bytes at addr, skipping the bytes which are unchanged.
+    virtual void    update( uint16_t addr, const uint8_t* src, size_t n )=0;
+};
+
+
+#ifdef AVR
+//-----------------------------------------------------------------------------
+// The internal EEPROM of an AVR.
+//-----------------------------------------------------------------------------
+
+class EepromStorage : public Storage
+{
+  public:
+    virtual size_t  size() const            { return E2END + 1; }
+
+    virtual void    read( uint16_t addr, uint8_t* dst, size_t n )
+                    {
+                      MAP_TRACE_POINT( TRACE_EEPROM_READ, addr, n );
+                      eeprom_read_block( dst, (const void*)addr, n );
+                    }
+
+    virtual void    update( uint16_t addr, const uint8_t* src, size_t n )
+                    {
+                      MAP_TRACE_POINT( TRACE_EEPROM_UPDATE, addr, n );
+                      eeprom_update_block( src, (void*)addr, n );
+                    }
+};
+#endif
+
+
+#ifndef ARDUINO
+//-----------------------------------------------------------------------------
+// EEPROM emulation in a file, for running and measuring on a host. The bytes
+// read, and the bytes and runs of bytes actually written, are counted. A
+// power failure can be simulated by limiting the number of bytes that will
+// still be written.
+//-----------------------------------------------------------------------------
+
+class FileStorage : public Storage
+{
+  public:
+                    FileStorage( const char* path, size_t size )
+                      : _size(size), _read(0), _written(0), _writes(0), _limit(-1)
+                    {
+                      _fd = open( path, O_RDWR | O_CREAT, 0644 );
+
+                      // new bytes read as erased EEPROM
+                      uint8_t ff[64];
+                      memset( ff, 0xFF, sizeof(ff) );
+
+                      off_t len = _fd >= 0 ? lseek( _fd, 0, SEEK_END ) : size;
+
+                      for( ; len < (off_t)size; len += sizeof(ff) )
+                        pwrite( _fd, ff, size - len < sizeof(ff) ? size - len : sizeof(ff), len );
+                    }
+
+                    ~FileStorage()              { if( _fd >= 0 ) close( _fd ); }
+
+    bool            isOpen() const              { return _fd >= 0;  }
+
+    virtual size_t  size() const                { return _size;     }
+
+    virtual void    read( uint16_t addr, uint8_t* dst, size_t n )
+                    {
+                      MAP_TRACE_POINT( TRACE_EEPROM_READ, addr, n );
+
+                      if( _fd < 0 || pread( _fd, dst, n, addr ) != (ssize_t)n )
+                        memset( dst, 0xFF, n );
+
+                      _read += n;
+                    }
+
+    virtual void    update( uint16_t addr, const uint8_t* src, size_t n )
+                    {
+                      MAP_TRACE_POINT( TRACE_EEPROM_UPDATE, addr, n );
+
+                      uint8_t old[64];
+
+                      for( size_t done = 0; done < n; )
+                      {
+                        size_t len = n - done < sizeof(old) ? n - done : sizeof(old);
+
+                        if( _fd < 0 || pread( _fd, old, len, addr + done ) != (ssize_t)len )
+                          memset( old, 0xFF, len );
+
+                        for( size_t i = 0; i < len; )
+                        {
+                          if( old[i] == src[done+i] ) { i++; continue; }
+
+                          size_t j = i;
+                          while( j < len && old[j] != src[done+j] ) j++;
+
+                          write( addr + done + i, src + done + i, j - i );
+                          i = j;
+                        }
+
+                        done += len;
+                      }
+                    }
+
+    // Counters, since the last reset.
+    size_t          bytesRead() const           { return _read;     }
+    size_t          bytesWritten() const        { return _written;  }
+    size_t          writes() const              { return _writes;   }
+    void            resetCounters()             { _read = 0; _written = 0; _writes = 0; }
+
+    // Write only n more bytes, then fail silently. -1: no limit.
+    void            setWriteLimit( long n )     { _limit = n;       }
+
+  private:
+
+    void            write( size_t addr, const uint8_t* src, size_t n )
+                    {
+                      if( _limit >= 0 && (long)n > _limit ) n = _limit;
+                      if( _limit >= 0 ) _limit -= n;
+                      if( n == 0 || _fd < 0 ) return;
+
+                      pwrite( _fd, src, n, addr );
+
+                      _written += n;
+                      _writes++;
+                    }
+
+    int             _fd;
+    size_t          _size;
+    size_t          _read;
+    size_t          _written;
+    size_t          _writes;
+    long            _limit;
+};
+#endif
+
+
+//-----------------------------------------------------------------------------
+// Transport reading and writing the bytes of a Storage from addr up to end,
+// so maps can be stored and loaded using sendTo and receiveFrom. Reads are
+// done in blocks of RX_BUFFER bytes.
+//-----------------------------------------------------------------------------
+
+class StorageTransport : public Transport
+{
+  public:
+    enum            { RX_BUFFER = 16 };
+
+                    StorageTransport( Storage& st, uint16_t addr, uint16_t end )
+                      : _st(st), _addr(addr), _end(end), _bufAddr(addr), _bufLen(0) {}
+
+    uint16_t        position() const                  { return _addr;             }
+
+    virtual int     available(void)                   { return _end - _addr;      }
+
+    virtual int     peek(void)
+                    {
+                      if( _addr >= _end ) return -1;
+
+                      if( _addr - _bufAddr >= _bufLen )
+                      {
+                        _bufAddr = _addr;
+                        _bufLen  = _end - _addr < RX_BUFFER ? _end - _addr : RX_BUFFER;
+
+                        _st.read( _bufAddr, _buf, _bufLen );
+                      }
+
+                      return _buf[_addr - _bufAddr];
+                    }
+
+    virtual int     read(void)
+                    {
+                      const int c = peek();
+
+                      if( c >= 0 ) _addr++;
+
+                      return c;
+                    }
+
+    virtual size_t  write(uint8_t n)                  { return write(&n, 1);      }
+
+    virtual size_t  write(const uint8_t* b,size_t sz)
+                    {
+                      if( sz > (size_t)(_end - _addr) ) sz = _end - _addr;
+
+                      _st.update( _addr, b, sz );
+                      _addr  += sz;
+                      _bufLen = 0;
+
+                      return sz;
+                    }
+
+  private:
+
+    Storage&        _st;
+    uint16_t        _addr;
+    uint16_t        _end;
+
+    uint8_t         _buf[RX_BUFFER];
+    uint16_t        _bufAddr;
+    uint16_t        _bufLen;
+};
+
+
+//-----------------------------------------------------------------------------
+// Headers, stored in native byte order.
+//-----------------------------------------------------------------------------
+
+struct StorageBankHeader
+{
+    uint16_t      magic;                // STORAGE_MAGIC
+    uint16_t      seq;                  // higher is newer, wraps around
+    uint8_t       count;                // number of maps
+    uint8_t       commit;               // STORAGE_COMMITTED, written last
+    uint32_t      crc;                  // over the map headers and the above,
+                                        // with commit set to 0
+};
+
+struct StorageMapHeader
+{
+    uint16_t      version;              // of the layout of the map
+    uint16_t      length;               // bytes of the wire image
+    uint32_t      crc;                  // of the wire image
+};
+
+
+//-----------------------------------------------------------------------------
+// Two banks of BANK_SIZE bytes, at base and base+BANK_SIZE, holding up to N
+// maps.
+//-----------------------------------------------------------------------------
+
+template<int N>
+class MapStorage : public MapLoader
+{
+public:
+                  MapStorage( Storage& st, uint16_t base, uint16_t bankSize )
+                    : st(st), base(base), bankSize(bankSize), n(0), active(-1), seq(0) {}
+
+    // Add map m, with the version of its layout. Returns false if the maps
+    // no longer fit in a bank.
+    bool          add( Map& m, uint16_t version )
+                  {
+                    if( n >= N ) return false;
+
+                    size_t total = headerSize( n+1 );
+                    for( int i=0; i<n; i++ ) total += maps[i]->memSize();
+
+                    if( total + m.memSize() > bankSize ) return false;
+
+                    maps[n]     = &m;
+                    versions[n] = version;
+                    lazy[n]     = 0;
+                    n++;
+
+                    return true;
+                  }
+
+    // Add lazy map m, which is loaded on first use after boot().
+    template<class M>
+    bool          add( Lazy<M>& m, uint16_t version )
+                  {
+                    if( !add( static_cast<Map&>(m), version ) ) return false;
+
+                    lazy[n-1] = &m;
+                    return true;
+                  }
+
+    // Bank the maps were last loaded from or committed to, -1 if none.
+    int8_t        activeBank() const    { return active; }
+
+    // Choose the newest bank whose headers are valid. Nothing is loaded.
+    // Returns the bank, -1 if neither is valid.
+    int8_t        validBank( int8_t exclude = -1 )
+                  {
+                    int8_t   best = -1;
+                    uint16_t bestSeq = 0;
+
+                    for( int8_t b=0; b<2; b++ )
+                    {
+                      uint16_t s;
+
+                      if( b == exclude || !checkHeaders( b, s ) ) continue;
+
+                      if( best < 0 || (int16_t)(s - bestSeq) > 0 ) { best = b; bestSeq = s; }
+                    }
+
+                    return best;
+                  }
+
+    // Load the maps from bank b. Lazy maps are only attached, to be loaded
+    // from b on first use. The stored images are verified first, so if one
+    // does not match its CRC, false is returned and no map is changed.
+    bool          load( int8_t b )
+                  {
+                    StorageBankHeader bh;
+
+                    st.read( bankStart(b), (uint8_t*)&bh, sizeof(bh) );
+
+                    for( int i=0; i<n; i++ )
+                    {
+                      if( lazy[i] ) continue;
+
+                      uint16_t offset = 0;
+                      uint32_t crc    = 0;
+
+                      if( verifyMap( b, i, offset, crc, 0 ) <= 0 ) return false;
+                    }
+
+                    for( int i=0; i<n; i++ )
+                    {
+                      if( lazy[i] ) continue;
+
+                      uint16_t offset = 0;
+
+                      if( loadMap( b, i, offset, 0 ) <= 0 ) return false;
+                    }
+
+                    active = b;
+                    seq    = bh.seq;
+
+                    MAP_TRACE_POINT( TRACE_BOOT, b, seq );
+
+                    for( int i=0; i<n; i++ )
+                      if( lazy[i] ) lazy[i]->attach( *this );
+
+                    return true;
+                  }
+
+    // Load the maps from the newest valid bank, falling back to the other
+    // bank if a CRC does not match. Returns the bank, -1 if neither loads.
+    int8_t        boot()
+                  {
+                    int8_t b = validBank();
+
+                    if( b >= 0 && load(b) ) return b;
+
+                    b = validBank( b );
+
+                    if( b >= 0 && load(b) ) return b;
+
+                    active = -1;
+                    return -1;
+                  }
+
+    // MapLoader: load (part of) lazy map m, from the active bank or, if its
+    // image is corrupt, from the other bank. Each image is verified before
+    // it is received, so m is not changed if neither can be loaded.
+    virtual int8_t load( Map& m, MapLoadProgress& p, size_t maxBytes )
+                  {
+                    int i = 0;
+
+                    while( i < n && maps[i] != &m ) i++;
+
+                    if( i == n || active < 0 ) return -1;
+
+                    if( p.source < 0 )
+                    {
+                      p.source = active;
+                      p.pass   = LOAD_VERIFY;
+                      p.offset = 0;
+                      p.crc    = 0;
+                    }
+
+                    if( p.pass == LOAD_RECEIVE ) return loadMap( p.source, i, p.offset, maxBytes );
+
+                    const int8_t r = verifyMap( p.source, i, p.offset, p.crc, maxBytes );
+
+                    if( r == 0 ) return 0;
+
+                    if( r > 0 )
+                      p.pass = LOAD_RECEIVE;
+                    else
+                    {
+                      const int8_t other = p.source == active ? validBank( active ) : -1;
+
+                      if( other < 0 ) return -1;
+
+                      p.source = other;
+                    }
+
+                    p.offset = 0;
+                    p.crc    = 0;
+
+                    return maxBytes ? 0 : load( m, p, maxBytes );
+                  }
+
+    // Whether a map differs from the active bank, judged by its CRC. Lazy
+    // maps which are not loaded yet are not modified.
+    bool          modified()
+                  {
+                    if( active < 0 ) return true;
+
+                    for( int i=0; i<n; i++ )
+                    {
+                      if( lazy[i] && lazy[i]->loadState() == LazyBase::LAZY_UNLOADED ) continue;
+
+                      StorageMapHeader mh;
+                      readMapHeader( active, i, mh );
+
+                      if( mh.crc != maps[i]->crc() ) return true;
+                    }
+
+                    return false;
+                  }
+
+    // Write the maps to the inactive bank and make it the active one. Does
+    // nothing, and returns false, if no map was modified or a lazy map
+    // cannot be loaded.
+    bool          commit()
+                  {
+                    if( !modified() ) return false;
+
+                    for( int i=0; i<n; i++ )
+                      if( lazy[i] && !lazy[i]->load() ) return false;
+
+                    const int8_t   b     = active == 0 ? 1 : 0;
+                    const uint16_t start = bankStart(b);
+                    uint8_t        zero  = 0;
+
+                    // 1. invalidate the bank
+                    st.update( start + offsetof(StorageBankHeader, commit), &zero, 1 );
+
+                    // 2. the maps
+                    uint16_t addr = start + headerSize(n);
+
+                    for( int i=0; i<n; i++ )
+                    {
+                      const uint16_t len = maps[i]->memSize();
+
+                      StorageTransport t( st, addr, addr + len );
+                      ExtendedSerial   s(t);
+
+                      maps[i]->sendTo( s );
+                      addr += len;
+                    }
+
+                    // 3. the headers
+                    StorageBankHeader bh;
+
+                    bh.magic  = STORAGE_MAGIC;
+                    bh.seq    = active < 0 ? 0 : seq + 1;
+                    bh.count  = n;
+                    bh.commit = 0;
+                    bh.crc    = 0;
+
+                    uint32_t crc = 0;
+
+                    for( int i=0; i<n; i++ )
+                    {
+                      StorageMapHeader mh;
+
+                      mh.version = versions[i];
+                      mh.length  = maps[i]->memSize();
+                      mh.crc     = maps[i]->crc();
+
+                      st.update( mapHeaderAddr(b,i), (const uint8_t*)&mh, sizeof(mh) );
+                      crc = crc32Update( crc, (const uint8_t*)&mh, sizeof(mh) );
+                    }
+
+                    bh.crc = crc32Update( crc, (const uint8_t*)&bh, sizeof(bh) );
+                    st.update( start, (const uint8_t*)&bh, sizeof(bh) );
+
+                    // 4. commit
+                    uint8_t committed = STORAGE_COMMITTED;
+                    st.update( start + offsetof(StorageBankHeader, commit), &committed, 1 );
+
+                    active = b;
+                    seq    = bh.seq;
+
+                    MAP_TRACE_POINT( TRACE_COMMIT, b, seq );
+
+                    return true;
+                  }
+
+protected:
+
+    enum          { LOAD_VERIFY, LOAD_RECEIVE };   // passes of a lazy load
+
+    static size_t headerSize( int count )
+                  {
+                    return sizeof(StorageBankHeader) + count*sizeof(StorageMapHeader);
+                  }
+
+    uint16_t      bankStart( int8_t b ) const
+                                        { return base + b*bankSize; }
+
+    uint16_t      mapHeaderAddr( int8_t b, int i ) const
+                                        { return bankStart(b) + sizeof(StorageBankHeader)
+                                                 + i*sizeof(StorageMapHeader); }
+
+    void          readMapHeader( int8_t b, int i, StorageMapHeader& mh )
+                  {
+                    st.read( mapHeaderAddr(b,i), (uint8_t*)&mh, sizeof(mh) );
+                  }
+
+    uint16_t      mapAddr( int8_t b, int i ) const
+                  {
+                    uint16_t addr = bankStart(b) + headerSize(n);
+
+                    for( int k=0; k<i; k++ ) addr += maps[k]->memSize();
+
+                    return addr;
+                  }
+
+    // Continue crc, the CRC of the stored wire image of map i in bank b, from
+    // 'offset' on, but for at most about maxBytes (0: no limit), and advance
+    // offset. Returns 1 when the image is complete and matches its header,
+    // 0 if there is more, -1 if it does not match. The map is not changed.
+    int8_t        verifyMap( int8_t b, int i, uint16_t& offset, uint32_t& crc, size_t maxBytes )
+                  {
+                    StorageMapHeader mh;
+                    readMapHeader( b, i, mh );
+
+                    const uint16_t addr = mapAddr( b, i );
+                    uint8_t        buf[StorageTransport::RX_BUFFER];
+                    size_t         done = 0;
+
+                    while( offset < mh.length && ( !maxBytes || done < maxBytes ) )
+                    {
+                      uint16_t len = mh.length - offset;
+
+                      if( len > sizeof(buf) ) len = sizeof(buf);
+
+                      st.read( addr + offset, buf, len );
+
+                      crc     = crc32Update( crc, buf, len );
+                      offset += len;
+                      done   += len;
+                    }
+
+                    if( offset < mh.length ) return 0;
+
+                    return crc == mh.crc ? 1 : -1;
+                  }
+
+    // Load the wire image of map i from bank b from 'offset' on, but at most
+    // about maxBytes (0: no limit), and advance offset. The image must have
+    // been verified by verifyMap. Returns 1 when the map is complete, else 0.
+    int8_t        loadMap( int8_t b, int i, uint16_t& offset, size_t maxBytes )
+                  {
+                    StorageMapHeader mh;
+                    readMapHeader( b, i, mh );
+
+                    const uint16_t   addr = mapAddr( b, i );
+                    StorageTransport t( st, addr + offset, addr + mh.length );
+                    ExtendedSerial   s(t);
+
+                    maps[i]->initReceive( offset, mh.length - offset );
+
+                    const bool done = maps[i]->receiveFrom( s, maxBytes );
+
+                    offset = t.position() - addr;
+
+                    return done ? 1 : 0;
+                  }
+
+    // Check the headers of bank b against the maps, without reading the maps.
+    bool          checkHeaders( int8_t b, uint16_t& s )
+                  {
+                    StorageBankHeader bh;
+
+                    st.read( bankStart(b), (uint8_t*)&bh, sizeof(bh) );
+
+                    if( bh.magic != STORAGE_MAGIC || bh.commit != STORAGE_COMMITTED ||
+                        bh.count != n ) return false;
+
+                    uint32_t crc = 0;
+
+                    for( int i=0; i<n; i++ )
+                    {
+                      StorageMapHeader mh;
+                      readMapHeader( b, i, mh );
+
+                      if( mh.version != versions[i] || mh.length != maps[i]->memSize() )
+                        return false;
+
+                      crc = crc32Update( crc, (const uint8_t*)&mh, sizeof(mh) );
+                    }
+
+                    const uint32_t stored = bh.crc;
+
+                    bh.commit = 0;
+                    bh.crc    = 0;
+
+                    if( crc32Update( crc, (const uint8_t*)&bh, sizeof(bh) ) != stored )
+                      return false;
+
+                    s = bh.seq;
+                    return true;
+                  }
+
+    Storage&      st;
+    uint16_t      base;
+    uint16_t      bankSize;
+
+    Map*          maps[N];
+    uint16_t      versions[N];
+    LazyBase*     lazy[N];              // 0 if loaded at boot
+    uint8_t       n;
+
+    int8_t        active;               // bank, -1 if none
+    uint16_t      seq;                  // of the active bank
+};
+
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+
+#endif // End multi-include protection
@@ -0,0 +1,244 @@
+//-----------------------------------------------------------------------------
+// Binary trace points
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2018 Arend Lammertink
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, version 3.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+// for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+//
+// Description:
+//
+// Printing text while looking up maps is too slow to leave on, and changes
+// the timing it is meant to observe. Instead, trace points write a record of
+// 12 bytes into a ring in RAM, which is dumped later:
+//
+//   time    uint32_t    mapCycles(), see MapProfile.h
+//   id      uint16_t    one of MapTraceId
+//   a       uint16_t    arguments, see MapTraceId
+//   b       uint32_t
+//
+// Define MAP_TRACE for the whole program, e.g. in the build flags, to enable
+// the trace points. Without it, they compile to nothing. User code can add
+// its own, with ids from TRACE_USER on:
+//
+//   MAP_TRACE_POINT( TRACE_USER + 1, cylinder, advance );
+//
+// The ring holds the last MAP_TRACE_SIZE records, older ones are overwritten,
+// so tracing never blocks. A slot is claimed with a single atomic increment
+// (on AVR, with interrupts disabled for a few cycles), so trace points may
+// also be used in interrupt handlers and threads.
+//
+// The ring is dumped thru ExtendedSerial, e.g. on a host to a file with an
+// FdTransport, and decoded with decode_trace.py:
+//
+//   mapTrace().sendTo( s );
+//
+// A dump is a header followed by the records, oldest first:
+//
+//   magic   uint16_t    MAP_TRACE_MAGIC
+//   unit    uint8_t     of time: 0 ticks, 1 cycles, 2 us, 3 ns
+//   size    uint8_t     of a record, 12
+//   total   uint32_t    records written since clear()
+//   count   uint16_t    records that follow
+//
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// Multi-include protection
+//-----------------------------------------------------------------------------
+
+#ifndef _MAP_TRACE_H
+#define _MAP_TRACE_H
+
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>
+
+#ifdef MAP_TRACE
+#include "MapProfile.h"
+#include "ExtendedSerial.h"
+
+#ifdef AVR
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#endif
+#endif
+
+
+//-----------------------------------------------------------------------------
+// Defines
+//-----------------------------------------------------------------------------
+
+#ifdef MAP_TRACE
+    #define MAP_TRACE_POINT(id, a, b)   mapTrace().add( (id), (uint16_t)(a), (uint32_t)(b) )
+#else
+    #define MAP_TRACE_POINT(id, a, b)
+#endif
+
+#define MAP_TRACE_MAGIC     0x544D      // "MT" on the wire, little endian
+
+#ifndef MAP_TRACE_SIZE                  // records, a power of 2
+#ifdef AVR
+#define MAP_TRACE_SIZE      32
+#elif defined(ARDUINO)
+#define MAP_TRACE_SIZE      256
+#else
+#define MAP_TRACE_SIZE      4096
+#endif
+#endif
+
+
+//-----------------------------------------------------------------------------
+// Trace point ids. Keep in sync with decode_trace.py.
+//-----------------------------------------------------------------------------
+
+enum MapTraceId
+{
+    TRACE_LOOKUP_2D     = 1,            // a: i,           b: map
+    TRACE_LOOKUP_3D     = 2,            // a: i + 256*j,   b: map
+    TRACE_RECEIVE       = 3,            // a: offset,      b: bytes, on initReceive
+    TRACE_RECEIVE_DONE  = 4,            // a: offset,      b: map
+    TRACE_EEPROM_READ   = 5,            // a: address,     b: bytes
+    TRACE_EEPROM_UPDATE = 6,            // a: address,     b: bytes
+    TRACE_BOOT          = 7,            // a: bank,        b: sequence number
+    TRACE_COMMIT        = 8,            // a: bank,        b: sequence number
+
+    TRACE_USER          = 0x100
+};
+
+
+#ifdef MAP_TRACE
+//-----------------------------------------------------------------------------
+// Ring of the last N trace records.
+//-----------------------------------------------------------------------------
+
+struct MapTraceRecord
+{
+    uint32_t      time;
+    uint16_t      id;
+    uint16_t      a;
+    uint32_t      b;
+};
+
+
+template<uint16_t N>
+class MapTraceRing
+{
+public:
+                  MapTraceRing()        { clear(); }
+
+    void          clear()               { head = 0; }
+
+    void          add( uint16_t id, uint16_t a, uint32_t b )
+                  {
+                    MapTraceRecord& r = records[ claim() & (N-1) ];
+
+                    r.time = mapCycles();
+                    r.id   = id;
+                    r.a    = a;
+                    r.b    = b;
+                  }
+
+    // Records written since clear(), including overwritten ones.
+    uint32_t      total() const         { return head; }
+
+    // Records in the ring.
+    uint16_t      size() const          { return head < N ? head : N; }
+
+    // Record k, 0 being the oldest in the ring.
+    const MapTraceRecord& record( uint16_t k ) const
+                  {
+                    return records[ (head - size() + k) & (N-1) ];
+                  }
+
+    void          sendTo( ExtendedSerial& s )
+                  {
+                    // Records added meanwhile may be sent torn.
+                    const uint32_t t = head;
+                    const uint16_t n = t < N ? t : N;
+
+                    s.beginSend();
+
+                    s.send( (uint16_t)MAP_TRACE_MAGIC );
+                    s.send( (uint8_t)unit() );
+                    s.send( (uint8_t)sizeof(MapTraceRecord) );
+                    s.send( t );
+                    s.send( n );
+
+                    for( uint16_t k=0; k<n; k++ )
+                    {
+                      const MapTraceRecord& r = records[ (t - n + k) & (N-1) ];
+
+                      s.send( r.time );
+                      s.send( r.id   );
+                      s.send( r.a    );
+                      s.send( r.b    );
+                    }
+
+                    s.endSend();
+                  }
+
+protected:
+
+    uint32_t      claim()
+                  {
+#ifdef AVR
+                    const uint8_t sreg = SREG;
+                    cli();
+                    const uint32_t h = head++;
+                    SREG = sreg;
+                    return h;
+#else
+                    return __atomic_fetch_add( &head, 1, __ATOMIC_RELAXED );
+#endif
+                  }
+
+    static uint8_t unit()
+                  {
+                    const char* u = MAP_CYCLE_UNIT;
+
+                    return u[0] == 't' ? 0 : u[0] == 'c' ? 1 : u[0] == 'u' ? 2 : 3;
+                  }
+
+    MapTraceRecord  records[N];
+    uint32_t        head;               // free running
+
+    typedef char    n_must_be_power_of_2[ (N & (N-1)) == 0 ? 1 : -1 ];
+};
+
+
+// A single ring for the whole program, without a guard on each access.
+
+template<int I = 0>
+struct MapTraceGlobal
+{
+    static MapTraceRing<MAP_TRACE_SIZE> ring;
+};
+
+template<int I>
+MapTraceRing<MAP_TRACE_SIZE> MapTraceGlobal<I>::ring;
+
+inline MapTraceRing<MAP_TRACE_SIZE>& mapTrace()   { return MapTraceGlobal<>::ring; }
+
+#endif // MAP_TRACE
+
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+
+#endif // End multi-include protection
@@ -0,0 +1,504 @@
+//-----------------------------------------------------------------------------
+// Byte transports for ExtendedSerial
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2018 Arend Lammertink
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, version 3.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+// for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+//
+// Description:
+//
+// ExtendedSerial reads and writes its bytes thru a Transport. Implemented are:
+//
+//   HardwareSerialTransport  Serial, Serial1, etc.
+//   RingTransport<N>         in memory loopback of N bytes, for tests
+//   BufferTransport          byte buffer in memory, e.g. a wire image of a map
+//   CrcTransport             computes the CRC-32 of what is written to it
+//   FdTransport              POSIX file descriptor, such as a pty, pipe or
+//                            Unix socket (not on Arduino)
+//   RxRingTransport<N>       another transport, with received bytes queued
+//                            in a ring of N bytes by an ISR or reader thread
+//
+// so the protocol code, e.g. Map::sendTo and Map::receiveFrom, can be run
+// and measured on a host:
+//
+//   int fds[2];
+//   pipe(fds);
+//
+//   FdTransport     rxt(fds[0]), txt(fds[1]);
+//   ExtendedSerial  rx(rxt),     tx(txt);
+//
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// Multi-include protection
+//-----------------------------------------------------------------------------
+
+#ifndef _TRANSPORT_H
+#define _TRANSPORT_H
+
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+
+#include <HardwareSerial.h>
+#include "Crc32.h"
+
+#ifndef ARDUINO
+#include <atomic>
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#endif
+
+
+//-----------------------------------------------------------------------------
+// Abstract base class. The methods have the semantics of their namesakes in
+// Arduino's Stream class.
+//-----------------------------------------------------------------------------
+
+class Transport
+{
+  public:
+    virtual         ~Transport() {}
+
+    virtual void    begin(unsigned long /*baud*/)     {}
+#ifdef AVR
+    virtual void    begin(unsigned long b, uint8_t m) { begin(b);                 }
+    virtual int     availableForWrite(void)           { return 0;                 }
+#endif
+    virtual void    end()                             {}
+
+    virtual int     available(void)                   =0;
+    virtual int     peek(void)                        =0;
+    virtual int     read(void)                        =0;
+    virtual void    flush(void)                       {}
+    virtual size_t  write(uint8_t n)                  =0;
+
+    virtual size_t  write(const uint8_t* b,size_t sz)
+                    {
+                      size_t n = 0;
+
+                      while( n < sz && write(b[n]) ) n++;
+
+                      return n;
+                    }
+};
+
+
+//-----------------------------------------------------------------------------
+// Transport thru an Arduino HardwareSerial, such as Serial.
+//
+// of() returns a transport for a port from a static table, so objects which
+// may be constructed with a HardwareSerial& need not each hold one. The table
+// has HARDWARE_SERIAL_TRANSPORTS entries; with more ports than that, the last
+// entry is taken over by each further port.
+//-----------------------------------------------------------------------------
+
+#ifndef HARDWARE_SERIAL_TRANSPORTS
+#define HARDWARE_SERIAL_TRANSPORTS  4
+#endif
+
+class HardwareSerialTransport : public Transport
+{
+  public:
+                    HardwareSerialTransport()                  : _s(0)  {}
+                    HardwareSerialTransport(HardwareSerial& s) : _s(&s) {}
+
+    static HardwareSerialTransport& of(HardwareSerial& s)
+                    {
+                      static HardwareSerialTransport t[HARDWARE_SERIAL_TRANSPORTS];
+
+                      int i = 0;
+                      while( i < HARDWARE_SERIAL_TRANSPORTS-1 && t[i]._s && t[i]._s != &s ) i++;
+
+                      t[i]._s = &s;
+                      return t[i];
+                    }
+
+#ifdef AVR
+    virtual void    begin(unsigned long baud)         { begin(baud, SERIAL_8N1);  }
+    virtual void    begin(unsigned long b, uint8_t m) { _s->begin(b,m);           }
+    virtual int     availableForWrite(void)           { return _s->availableForWrite(); }
+#else
+    virtual void    begin(unsigned long baud)         { _s->begin(baud);          }
+#endif
+    virtual void    end()                             { _s->end();                }
+    virtual int     available(void)                   { return _s->available();   }
+    virtual int     peek(void)                        { return _s->peek();        }
+    virtual int     read(void)                        { return _s->read();        }
+    virtual void    flush(void)                       { _s->flush();              }
+    virtual size_t  write(uint8_t n)                  { return _s->write(n);      }
+    virtual size_t  write(const uint8_t* b,size_t sz) { return _s->write(b,sz);   }
+
+  private:
+
+    HardwareSerial* _s;
+};
+
+
+//-----------------------------------------------------------------------------
+// In memory loopback: what is written can be read back. N must be a power of
+// two. Writes to a full ring are dropped.
+//-----------------------------------------------------------------------------
+
+template<uint16_t N>
+class RingTransport : public Transport
+{
+  public:
+                    RingTransport() : _head(0), _tail(0) {}
+
+    virtual int     available(void)                   { return (uint16_t)(_head - _tail); }
+    virtual int     peek(void)                        { return available() ? _buf[_tail & (N-1)]   : -1; }
+    virtual int     read(void)                        { return available() ? _buf[_tail++ & (N-1)] : -1; }
+
+    virtual size_t  write(uint8_t n)
+                    {
+                      if( available() == N ) return 0;
+
+                      _buf[_head++ & (N-1)] = n;
+
+                      return 1;
+                    }
+
+  private:
+
+    uint8_t         _buf[N];
+    uint16_t        _head;      // free running, masked on access
+    uint16_t        _tail;
+
+    typedef char    n_must_be_power_of_2[ (N & (N-1)) == 0 ? 1 : -1 ];
+};
+
+
+//-----------------------------------------------------------------------------
+// Transport over a byte buffer of 'size' bytes, which is not owned. Writes are
+// appended to the first 'len' bytes, as far as they fit. Reads consume these
+// from the start. A buffer which is only read from may be const, and is
+// wrapped with reader(), which takes 'len' bytes of data and accepts no
+// writes:
+//
+//   BufferTransport out( image, sizeof(image) );                // empty
+//   BufferTransport in = BufferTransport::reader( image, len ); // full
+//-----------------------------------------------------------------------------
+
+class BufferTransport : public Transport
+{
+  public:
+                    BufferTransport(uint8_t* buf, size_t size, size_t len = 0)
+                      : _buf(buf), _size(size), _len(len), _pos(0) {}
+
+    static BufferTransport reader(const uint8_t* buf, size_t len)
+                    {
+                      return BufferTransport( const_cast<uint8_t*>(buf), len, len );
+                    }
+
+    size_t          length() const                    { return _len;              }
+
+    virtual int     available(void)                   { return _len - _pos;       }
+    virtual int     peek(void)                        { return _pos < _len ? _buf[_pos]   : -1; }
+    virtual int     read(void)                        { return _pos < _len ? _buf[_pos++] : -1; }
+
+    virtual size_t  write(uint8_t n)                  { return write(&n, 1);      }
+
+    virtual size_t  write(const uint8_t* b,size_t sz)
+                    {
+                      if( sz > _size - _len ) sz = _size - _len;
+
+                      memcpy( _buf + _len, b, sz );
+                      _len += sz;
+
+                      return sz;
+                    }
+
+  private:
+
+    uint8_t*        _buf;
+    size_t          _size;
+    size_t          _len;       // bytes written
+    size_t          _pos;       // bytes read
+};
+
+
+//-----------------------------------------------------------------------------
+// Sink computing the CRC-32 of the bytes written to it, e.g. of the wire
+// image of a map. Nothing can be read.
+//-----------------------------------------------------------------------------
+
+class CrcTransport : public Transport
+{
+  public:
+                    CrcTransport() : _crc(0), _len(0) {}
+
+    uint32_t        crc() const                       { return _crc;              }
+    size_t          length() const                    { return _len;              }
+
+    virtual int     available(void)                   { return 0;                 }
+    virtual int     peek(void)                        { return -1;                }
+    virtual int     read(void)                        { return -1;                }
+
+    virtual size_t  write(uint8_t n)                  { return write(&n, 1);      }
+
+    virtual size_t  write(const uint8_t* b,size_t sz)
+                    {
+                      _crc  = crc32Update( _crc, b, sz );
+                      _len += sz;
+
+                      return sz;
+                    }
+
+  private:
+
+    uint32_t        _crc;
+    size_t          _len;
+};
+
+
+#ifndef ARDUINO
+//-----------------------------------------------------------------------------
+// Transport thru a POSIX file descriptor, e.g. a pty, pipe or Unix socket.
+// The descriptor is not owned. Reads are buffered, so read() is not a
+// system call per byte. Writes block until all bytes are written.
+//-----------------------------------------------------------------------------
+
+class FdTransport : public Transport
+{
+  public:
+    enum            { RX_BUFFER = 256 };
+
+                    FdTransport(int fd) : _fd(fd), _head(0), _tail(0) {}
+
+    int             fd() const                        { return _fd;               }
+
+    // Wait at most timeout ms until data is available. For reader threads.
+    bool            waitReadable(int timeout)
+                    {
+                      if( _tail < _head ) return true;
+
+                      struct pollfd p = { _fd, POLLIN, 0 };
+
+                      return poll( &p, 1, timeout ) > 0;
+                    }
+
+    virtual int     available(void)
+                    {
+                      int n = 0;
+
+                      if( ioctl( _fd, FIONREAD, &n ) < 0 ) n = 0;
+
+                      return n + (_head - _tail);
+                    }
+
+    virtual int     peek(void)                        { return fill() ? _rx[_tail]   : -1; }
+    virtual int     read(void)                        { return fill() ? _rx[_tail++] : -1; }
+
+    virtual size_t  write(uint8_t n)                  { return write(&n, 1);      }
+
+    virtual size_t  write(const uint8_t* b,size_t sz)
+                    {
+                      size_t done = 0;
+
+                      while( done < sz )
+                      {
+                        ssize_t k = ::write( _fd, b + done, sz - done );
+
+                        if( k > 0 )                 done += k;
+                        else if( errno != EINTR )   break;
+                      }
+
+                      return done;
+                    }
+
+  private:
+
+    // Make sure the rx buffer holds at least one byte, if any is available.
+    bool            fill()
+                    {
+                      if( _tail < _head ) return true;
+
+                      int n = 0;
+                      if( ioctl( _fd, FIONREAD, &n ) < 0 || n <= 0 ) return false;
+                      if( n > RX_BUFFER ) n = RX_BUFFER;
+
+                      ssize_t k = ::read( _fd, _rx, n );
+
+                      _tail = 0;
+                      _head = k > 0 ? k : 0;
+
+                      return _head > 0;
+                    }
+
+    int             _fd;
+    uint8_t         _rx[RX_BUFFER];
+    int             _head;
+    int             _tail;
+};
+#endif
+
+
+//-----------------------------------------------------------------------------
+// Lock free single producer, single consumer ring of N bytes, N a power of
+// two. One side may be an interrupt service routine or another thread. Holds
+// up to N-1 bytes. On Arduino, the indices are single bytes, so they are read
+// and written atomically, and N must be <= 256.
+//-----------------------------------------------------------------------------
+
+template<uint16_t N>
+class SpscRing
+{
+  public:
+                    SpscRing() : _head(0), _tail(0) {}
+
+    // Producer side
+    bool            push(uint8_t c)
+                    {
+                      const index_t h = load(_head);
+
+                      if( (index_t)(h - load(_tail)) >= N-1 ) return false;  // full
+
+                      _buf[h & (N-1)] = c;
+                      store( _head, h+1 );
+
+                      return true;
+                    }
+
+    int             space() const                     { return N-1 - available(); }
+
+    // Consumer side
+    int             available() const                 { return (index_t)(load(_head) - load(_tail)); }
+
+    int             peek() const
+                    {
+                      const index_t t = load(_tail);
+
+                      return t != load(_head) ? _buf[t & (N-1)] : -1;
+                    }
+
+    int             read()
+                    {
+                      const index_t t = load(_tail);
+
+                      if( t == load(_head) ) return -1;                      // empty
+
+                      const uint8_t c = _buf[t & (N-1)];
+                      store( _tail, t+1 );
+
+                      return c;
+                    }
+
+  private:
+
+#ifdef ARDUINO
+    typedef uint8_t                 index_t;
+    typedef volatile uint8_t        atomic_t;
+
+    static index_t  load(const atomic_t& a)           { return a;                 }
+    static void     store(atomic_t& a, index_t v)     { a = v;                    }
+
+    typedef char    n_must_fit_index[ N <= 256 ? 1 : -1 ];
+#else
+    typedef uint16_t                index_t;
+    typedef std::atomic<uint16_t>   atomic_t;
+
+    // The data is written before and read after the index is updated
+    static index_t  load(const atomic_t& a)       { return a.load(std::memory_order_acquire); }
+    static void     store(atomic_t& a, index_t v) { a.store(v, std::memory_order_release);   }
+
+    typedef char    n_must_fit_index[ N <= 32768 ? 1 : -1 ];
+#endif
+
+    uint8_t         _buf[N];
+    atomic_t        _head;      // free running, written by the producer only
+    atomic_t        _tail;      // free running, written by the consumer only
+
+    typedef char    n_must_be_power_of_2[ (N & (N-1)) == 0 ? 1 : -1 ];
+};
+
+
+//-----------------------------------------------------------------------------
+// Transport whose received bytes are queued in an SpscRing, so they are
+// collected while the main loop is busy. Bytes are sent thru the underlying
+// transport directly.
+//
+// The ring is filled by the producer: either an RX interrupt service routine
+// calling push(), or a reader thread calling pump(), e.g. on a host:
+//
+//   FdTransport           link(fd);
+//   RxRingTransport<4096> rx(link);
+//
+//   while( running ) { link.waitReadable(10); rx.pump(); }   // reader thread
+//
+// Everything else, including all reads, is done by the consumer.
+//-----------------------------------------------------------------------------
+
+template<uint16_t N>
+class RxRingTransport : public Transport
+{
+  public:
+                    RxRingTransport(Transport& link) : _link(link), _dropped(0) {}
+
+    // Producer side. Bytes pushed to a full ring are dropped and counted.
+    bool            push(uint8_t c)
+                    {
+                      if( _ring.push(c) ) return true;
+
+                      _dropped++;
+                      return false;
+                    }
+
+    // Move the bytes available from the underlying transport into the ring,
+    // as far as they fit. Returns the number of bytes moved.
+    size_t          pump()
+                    {
+                      size_t n = 0;
+
+                      while( _ring.space() > 0 && _link.available() > 0 )
+                      {
+                        int c = _link.read();
+                        if( c < 0 ) break;
+
+                        _ring.push( (uint8_t)c );
+                        n++;
+                      }
+
+                      return n;
+                    }
+
+    uint16_t        dropped() const                   { return _dropped;          }
+
+    // Consumer side
+    virtual void    begin(unsigned long baud)         { _link.begin(baud);        }
+    virtual void    end()                             { _link.end();              }
+    virtual int     available(void)                   { return _ring.available(); }
+    virtual int     peek(void)                        { return _ring.peek();      }
+    virtual int     read(void)                        { return _ring.read();      }
+    virtual void    flush(void)                       { _link.flush();            }
+    virtual size_t  write(uint8_t n)                  { return _link.write(n);    }
+    virtual size_t  write(const uint8_t* b,size_t sz) { return _link.write(b,sz); }
+
+  private:
+
+    Transport&      _link;
+    SpscRing<N>     _ring;
+    volatile uint16_t _dropped;
+};
+
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+
+#endif // End multi-include protection
@@ -0,0 +1,102 @@
+#!/usr/bin/python
+#
+# Decode a dump of the trace ring, as sent by MapTraceRing::sendTo, see
+# MapTrace.h.
+#
+# Usage: decode_trace.py [-b] [dump]
+#
+#   -b    the dump is big endian, see ExtendedSerial::setByteOrder
+#
+# Reads stdin if no dump is given. Prints a record per line, with the time
+# relative to the first record.
+
+from __future__ import print_function
+
+import struct
+import sys
+
+MAGIC  = 0x544D
+UNITS  = [ "ticks", "cycles", "us", "ns" ]
+USER   = 0x100
+
+# Keep in sync with MapTraceId in MapTrace.h.
+IDS = {
+  1: ( "lookup 2D",     lambda a, b: "i %d, map %08x"       % ( a, b ) ),
+  2: ( "lookup 3D",     lambda a, b: "i %d, j %d, map %08x" % ( a & 0xFF, a >> 8, b ) ),
+  3: ( "receive",       lambda a, b: "offset %d, %d bytes"  % ( a, b ) ),
+  4: ( "receive done",  lambda a, b: "offset %d, map %08x"  % ( a, b ) ),
+  5: ( "eeprom read",   lambda a, b: "address %d, %d bytes" % ( a, b ) ),
+  6: ( "eeprom update", lambda a, b: "address %d, %d bytes" % ( a, b ) ),
+  7: ( "boot",          lambda a, b: "bank %d, seq %d"      % ( a, b ) ),
+  8: ( "commit",        lambda a, b: "bank %d, seq %d"      % ( a, b ) ),
+}
+
+
+def decode( data, order ):
+    header = order + "HBBIH"
+    hsize  = struct.calcsize( header )
+
+    if len(data) < hsize:
+      raise ValueError( "dump too short" )
+
+    magic, unit, size, total, count = struct.unpack_from( header, data )
+
+    if magic != MAGIC:
+      raise ValueError( "not a trace dump, or wrong byte order" )
+
+    unit = UNITS[unit] if unit < len(UNITS) else "?"
+
+    print( "%d records, %d written, %d overwritten" % ( count, total, total - count ) )
+    print()
+    print( "%12s  %-14s %s" % ( "time (" + unit + ")", "id", "arguments" ) )
+
+    first = None
+
+    for k in range(count):
+      offset = hsize + k*size
+
+      if offset + size > len(data):
+        print( "truncated after %d records" % k )
+        break
+
+      time, id, a, b = struct.unpack_from( order + "IHHI", data, offset )
+
+      if first is None:
+        first = time
+
+      dt = (time - first) & 0xFFFFFFFF
+
+      if id in IDS:
+        name, args = IDS[id]
+        print( "%12d  %-14s %s" % ( dt, name, args( a, b ) ) )
+      elif id >= USER:
+        print( "%12d  %-14s a %d, b %d" % ( dt, "user %d" % (id - USER), a, b ) )
+      else:
+        print( "%12d  %-14s a %d, b %d" % ( dt, "id %d" % id, a, b ) )
+
+
+def main( argv ):
+    order = "<"
+    args  = argv[1:]
+
+    if args and args[0] == "-b":
+      order = ">"
+      args  = args[1:]
+
+    if args:
+      with open( args[0], "rb" ) as f:
+        data = f.read()
+    else:
+      data = getattr( sys.stdin, "buffer", sys.stdin ).read()
+
+    try:
+      decode( data, order )
+    except ValueError as e:
+      print( "decode_trace: %s" % e, file=sys.stderr )
+      return 1
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit( main( sys.argv ) )
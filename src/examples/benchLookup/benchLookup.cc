@@ -0,0 +1,186 @@
+//-----------------------------------------------------------------------------
+// Benchmark of the latency of single lookups of 3D maps of various types
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2018 Arend Lammertink
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by the Free
+// Software Foundation, version 3.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+// more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+//
+// 16x16 maps of several axis and cell types are looked up at random points.
+// The duration of every single lookup is measured with mapCycles(), less the
+// overhead of measuring, and recorded in a LatencyHistogram per map. For each
+// map, p50, p99, p99.9 and the maximum are reported.
+//
+// benchLookupCT is the same program, built with MAP_CONSTANT_TIME_SEARCH.
+//
+// Usage: benchLookup [lookups]
+//
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+
+#include "Map2D3D.h"
+#include "MapProfile.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+//-----------------------------------------------------------------------------
+// Globals
+//-----------------------------------------------------------------------------
+
+#define MAX_LOOKUPS     1000000
+#define SIZE            16
+
+static float   in1[MAX_LOOKUPS], in2[MAX_LOOKUPS];
+
+//-----------------------------------------------------------------------------
+// Functions
+//-----------------------------------------------------------------------------
+
+// Make the compiler assume that *p is used, and that all memory may have
+// changed, so the lookup stays between the two mapCycles() calls.
+static inline void escape( void* p )    { asm volatile( "" : : "g"(p) : "memory" ); }
+static inline void clobber()            { asm volatile( "" : : : "memory" );        }
+
+
+// Minimum of a number of empty measurements.
+static uint32_t overhead()
+{
+    uint32_t best = 0xFFFFFFFFUL;
+
+    for( int k=0; k<10000; k++ )
+    {
+      uint32_t t0 = mapCycles();
+      uint32_t t1 = mapCycles();
+
+      if( t1 - t0 < best ) best = t1 - t0;
+    }
+
+    return best;
+}
+
+
+// Fill the axes of m evenly, from 0 to max1 and 0 to max2, and the cells with
+// a ramp.
+template<class M>
+static void init( M& m, float max1, float max2 )
+{
+    typedef typename M::x1_type X1;
+    typedef typename M::x2_type X2;
+    typedef typename M::y_type  Y;
+
+    X1 x1s[SIZE];
+    X2 x2s[SIZE];
+    Y  ys[SIZE*SIZE];
+
+    for( int i=0; i<SIZE; i++ )
+    {
+      x1s[i] = static_cast<X1>( max1 * i / (SIZE-1) );
+      x2s[i] = static_cast<X2>( max2 * i / (SIZE-1) );
+    }
+
+    for( int i=0; i<SIZE*SIZE; i++ ) ys[i] = static_cast<Y>( (float)(i % 200) );
+
+    m.setX1s( x1s );
+    m.setX2s( x2s );
+    m.setYs( ys );
+}
+
+
+template<class M>
+static void bench( const char* name, M& m, float max1, float max2, int n,
+                   uint32_t offset )
+{
+    typedef typename M::x1_type X1;
+    typedef typename M::x2_type X2;
+    typedef typename M::y_type  Y;
+
+    LatencyHistogram   h;
+
+    init( m, max1, max2 );
+    h.setOffset( offset );
+
+    for( int k=0; k<n; k++ )
+    {
+      in1[k] = max1 * (float)rand() / RAND_MAX;
+      in2[k] = max2 * (float)rand() / RAND_MAX;
+    }
+
+    for( int k=0; k<n; k++ )
+    {
+      X1 x1 = static_cast<X1>( in1[k] );
+      X2 x2 = static_cast<X2>( in2[k] );
+
+      escape( &x1 );
+      escape( &x2 );
+
+      uint32_t t0 = mapCycles();
+      clobber();
+
+      Y y = m.f( x1, x2 );
+
+      escape( &y );
+      h.addRaw( mapCycles() - t0 );
+    }
+
+    printf( "%-32s %8lu %8lu %8lu %8lu\n", name,
+            (unsigned long)h.quantile(500), (unsigned long)h.quantile(990),
+            (unsigned long)h.quantile(999), (unsigned long)h.max() );
+}
+
+
+int main( int argc, char** argv )
+{
+    int n = argc > 1 ? atoi( argv[1] ) : 100000;
+
+    if( n < 1 || n > MAX_LOOKUPS ) n = MAX_LOOKUPS;
+
+    static Map3D<SIZE, SIZE, int16_t,  uint8_t,  uint8_t>  m1;
+    static Map3D<SIZE, SIZE, uint16_t, uint16_t>           m2;
+    static Map3D<SIZE, SIZE, float,    float>              m3;
+    static Map3D<SIZE, SIZE, Fix16,    Fix16>              m4;
+    static Map3D<SIZE, SIZE, int16_t,  Fix16>              m5;
+
+    mapCyclesInit();
+
+    const uint32_t offset = overhead();
+
+#ifdef MAP_CONSTANT_TIME_SEARCH
+    const char* mode = "constant time search";
+#else
+    const char* mode = "bisection";
+#endif
+
+    printf( "%d lookups per map, %s, overhead %lu %s subtracted\n\n", n, mode,
+            (unsigned long)offset, MAP_CYCLE_UNIT );
+
+    printf( "%-32s %8s %8s %8s %8s  (%s)\n", "map (x1, y, x2)", "p50", "p99",
+            "p99.9", "max", MAP_CYCLE_UNIT );
+
+    bench( "int16_t, uint8_t, uint8_t",  m1, 8000,  250,  n, offset );
+    bench( "uint16_t, uint16_t",         m2, 60000, 60000, n, offset );
+    bench( "float, float",               m3, 8000,  250,  n, offset );
+    bench( "Fix16, Fix16",               m4, 8000,  250,  n, offset );
+    bench( "int16_t, Fix16",             m5, 8000,  250,  n, offset );
+
+    return 0;
+}
+
+
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
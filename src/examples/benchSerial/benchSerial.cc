@@ -0,0 +1,249 @@
+//-----------------------------------------------------------------------------
+// Benchmark of burst reads and writes of maps over host transports
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2018 Arend Lammertink
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by the Free
+// Software Foundation, version 3.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+// more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+//
+// A 16x16 Fix16 map is sent with sendTo() and received into a second map
+// with receiveFrom(), over an in memory ring, a pipe, a Unix socket and a
+// pty. The pipe is also run with a reader thread which queues the received
+// bytes in an RxRingTransport, from which the map is received in slices of
+// SLICE bytes. For each transport, the latency of a burst and the throughput
+// are measured. The time a burst would take over a real serial link is then
+// estimated for a number of baud rates, as the time on the wire (10 bits per
+// byte) plus the measured overhead.
+//
+// Usage: benchSerial [iterations]
+//
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+
+#include "Map2D3D.h"
+#include "Transport.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <termios.h>
+#include <time.h>
+#include <sys/socket.h>
+#include <thread>
+
+//-----------------------------------------------------------------------------
+// Globals
+//-----------------------------------------------------------------------------
+
+#define MAX_ITERATIONS  100000
+#define SLICE           64
+
+typedef Map3D<16, 16, int16_t, Fix16>  BenchMap;
+
+static const long baudRates[] = { 9600, 57600, 115200, 460800, 1000000 };
+
+//-----------------------------------------------------------------------------
+// Functions
+//-----------------------------------------------------------------------------
+
+static double now()
+{
+    struct timespec t;
+    clock_gettime( CLOCK_MONOTONIC, &t );
+
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+
+static int compareDouble( const void* a, const void* b )
+{
+    double d = *(const double*)a - *(const double*)b;
+
+    return d < 0 ? -1 : d > 0 ? 1 : 0;
+}
+
+
+// Send map 'src' thru tx and receive it into 'dst' thru rx, n times, in
+// slices of at most 'slice' bytes (0: no limit).
+static void bench( const char* name, Transport& txt, Transport& rxt,
+                   BenchMap& src, BenchMap& dst, int n, int slice = 0 )
+{
+    ExtendedSerial  tx(txt);
+    ExtendedSerial  rx(rxt);
+
+    const int       bytes = src.memSize();
+    static double   lat[MAX_ITERATIONS];
+
+    double start = now();
+
+    for( int k=0; k<n; k++ )
+    {
+      double t0 = now();
+
+      src.sendTo(tx);
+
+      dst.initReceive( 0, bytes );
+      while( !dst.receiveFrom(rx, slice) ) std::this_thread::yield();
+
+      lat[k] = now() - t0;
+    }
+
+    double total = now() - start;
+
+    qsort( lat, n, sizeof(double), compareDouble );
+
+    const double avg = total / n;
+
+    printf( "%-8s %8.2f %8.2f %8.2f %10.2f", name,
+            avg*1e6, lat[n/2]*1e6, lat[n*99/100]*1e6, bytes*n / total / 1e6 );
+
+    for( unsigned b=0; b<sizeof(baudRates)/sizeof(baudRates[0]); b++ )
+    {
+      printf( " %8.2f", (bytes*10.0/baudRates[b] + avg) * 1e3 );
+    }
+
+    printf( "\n" );
+
+    for( int i=0; i<16; i++ )
+      for( int j=0; j<16; j++ )
+        if( !(src.y(i,j) == dst.y(i,j)) ) { printf( "%s: maps differ\n", name ); return; }
+}
+
+
+int main( int argc, char** argv )
+{
+    int n = argc > 1 ? atoi(argv[1]) : 2000;
+
+    if( n < 1 )              n = 1;
+    if( n > MAX_ITERATIONS ) n = MAX_ITERATIONS;
+
+    BenchMap src, dst;
+
+    int16_t  x1s[16], x2s[16];
+    float    ys[256];
+
+    for( int i=0; i<16;  i++ ) { x1s[i] = 500*i; x2s[i] = 10*i; }
+    for( int i=0; i<256; i++ ) { ys[i]  = 0.25f*i - 20.0f;      }
+
+    src.setX1s(x1s);
+    src.setX2s(x2s);
+    src.setYsFromFloat(ys);
+
+    printf( "Burst of %d bytes, %d iterations\n\n", src.memSize(), n );
+    printf( "                latency [us]          MB/s     burst at baud rate [ms]\n" );
+    printf( "         %8s %8s %8s %10s", "avg", "median", "p99", "" );
+
+    for( unsigned b=0; b<sizeof(baudRates)/sizeof(baudRates[0]); b++ )
+    {
+      printf( " %8ld", baudRates[b] );
+    }
+    printf( "\n" );
+
+    // In memory
+    {
+      static RingTransport<2048> ring;
+
+      bench( "ring", ring, ring, src, dst, n );
+    }
+
+    // Pipe
+    {
+      int fds[2];
+
+      if( pipe(fds) == 0 )
+      {
+        FdTransport rxt(fds[0]), txt(fds[1]);
+
+        bench( "pipe", txt, rxt, src, dst, n );
+
+        close(fds[0]);
+        close(fds[1]);
+      }
+    }
+
+    // Pipe, with a reader thread
+    {
+      int fds[2];
+
+      if( pipe(fds) == 0 )
+      {
+        static FdTransport           link(fds[0]);
+        static RxRingTransport<4096> rxt(link);
+        FdTransport                  txt(fds[1]);
+
+        static volatile bool running = true;
+
+        std::thread reader( []() {
+          while( running ) { if( link.waitReadable(10) ) rxt.pump(); }
+        } );
+
+        bench( "thread", txt, rxt, src, dst, n, SLICE );
+
+        running = false;
+        reader.join();
+
+        close(fds[0]);
+        close(fds[1]);
+      }
+    }
+
+    // Unix socket
+    {
+      int fds[2];
+
+      if( socketpair( AF_UNIX, SOCK_STREAM, 0, fds ) == 0 )
+      {
+        FdTransport rxt(fds[0]), txt(fds[1]);
+
+        bench( "socket", txt, rxt, src, dst, n );
+
+        close(fds[0]);
+        close(fds[1]);
+      }
+    }
+
+    // pty, in raw mode
+    {
+      int master = posix_openpt( O_RDWR | O_NOCTTY );
+
+      if( master >= 0 && grantpt(master) == 0 && unlockpt(master) == 0 )
+      {
+        int slave = open( ptsname(master), O_RDWR | O_NOCTTY );
+
+        struct termios t;
+        tcgetattr( slave, &t );
+        cfmakeraw( &t );
+        tcsetattr( slave, TCSANOW, &t );
+
+        FdTransport rxt(slave), txt(master);
+
+        bench( "pty", txt, rxt, src, dst, n );
+
+        close(slave);
+      }
+
+      if( master >= 0 ) close(master);
+    }
+
+    return 0;
+}
+
+
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
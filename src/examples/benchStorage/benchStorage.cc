@@ -0,0 +1,375 @@
+//-----------------------------------------------------------------------------
+// Benchmark of A/B bank storage of maps in an emulated EEPROM
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2018 Arend Lammertink
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by the Free
+// Software Foundation, version 3.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+// more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+//
+// A calibration of a few maps is committed to a 4 kB EEPROM, emulated in a
+// file, as on an ATmega2560. For a number of typical commits, the bytes
+// actually written are counted, and the time the commit would take on the
+// EEPROM (3.4 ms per byte) is estimated. The bytes read for the header only
+// validation at boot are compared to those of a full load, and to those of a
+// boot with a lazy ignition map, loaded on first use.
+//
+// Then, power failures are simulated at every byte of a commit. After each,
+// a boot must yield either the old or the new calibration. Finally, bytes of
+// the stored maps are corrupted. A boot, or the load of the lazy ignition
+// map, must then use the other bank, or, if both are corrupt, fail and leave
+// the maps untouched. A commit must be possible again once the failed lazy
+// map is received in full.
+//
+// Usage: benchStorage [file]
+//
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+
+#include "MapStorage.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+//-----------------------------------------------------------------------------
+// Globals
+//-----------------------------------------------------------------------------
+
+#define EEPROM_SIZE     4096
+#define BANK_SIZE       2048
+#define EEPROM_WRITE_MS 3.4             // per byte, ATmega2560
+
+typedef Map3D<16, 16, int16_t, uint8_t, uint8_t>  Table;
+typedef Map2D<8, uint8_t, Fix16>                  Curve;
+
+static Table   veMap, ignMap;
+static Curve   wueCurve;
+static Lazy<Table>  ignLazy;
+
+static Map*    maps[] = { &veMap, &ignMap, &wueCurve };
+
+#define NR_MAPS  (int)(sizeof(maps)/sizeof(maps[0]))
+
+//-----------------------------------------------------------------------------
+// Functions
+//-----------------------------------------------------------------------------
+
+static double now()
+{
+    struct timespec t;
+    clock_gettime( CLOCK_MONOTONIC, &t );
+
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+
+static void initMaps()
+{
+    int16_t x1s[16];
+    uint8_t x2s[16], ys[256];
+
+    for( int i=0; i<16;  i++ ) { x1s[i] = 500*i; x2s[i] = 6*i;     }
+    for( int i=0; i<256; i++ ) { ys[i]  = 40 + i/4;                }
+
+    veMap.setX1s(x1s);  veMap.setX2s(x2s);  veMap.setYs(ys);
+    ignMap.setX1s(x1s); ignMap.setX2s(x2s); ignMap.setYs(ys);
+
+    uint8_t xs[8];
+    float   cs[8];
+
+    for( int i=0; i<8; i++ ) { xs[i] = 20*i; cs[i] = 1.8f - 0.1f*i; }
+
+    wueCurve.setXs(xs);
+    wueCurve.setYsFromFloat(cs);
+}
+
+
+static void addMaps( MapStorage<NR_MAPS>& storage )
+{
+    for( int i=0; i<NR_MAPS; i++ ) storage.add( *maps[i], 1 );
+}
+
+
+// Set cell (i,j) of the VE table.
+static void tune( int i, int j, uint8_t v )
+{
+    veMap.cell(i,j) = v;
+    veMap.modified();
+}
+
+
+static void report( const char* name, FileStorage& eeprom, double t, bool done )
+{
+    printf( "%-28s %6s %8zu %6zu %10.1f %10.1f\n", name, done ? "yes" : "no",
+            eeprom.bytesWritten(), eeprom.writes(),
+            eeprom.bytesWritten() * EEPROM_WRITE_MS, t*1e6 );
+}
+
+
+static void commit( const char* name, MapStorage<NR_MAPS>& storage, FileStorage& eeprom )
+{
+    eeprom.resetCounters();
+
+    double t0   = now();
+    bool   done = storage.commit();
+
+    report( name, eeprom, now() - t0, done );
+}
+
+
+static void crcs( uint32_t* c )
+{
+    for( int i=0; i<NR_MAPS; i++ ) c[i] = maps[i]->crc();
+}
+
+
+// Invert the byte at 'offset' of the stored wire images in bank b.
+static void corrupt( FileStorage& eeprom, int8_t b, uint16_t offset )
+{
+    const uint16_t addr = b*BANK_SIZE + sizeof(StorageBankHeader)
+                        + NR_MAPS*sizeof(StorageMapHeader) + offset;
+    uint8_t        v;
+
+    eeprom.read( addr, &v, 1 );
+    v = ~v;
+    eeprom.update( addr, &v, 1 );
+}
+
+
+int main( int argc, char** argv )
+{
+    const char* path = argc > 1 ? argv[1] : "benchStorage.eeprom";
+
+    unlink( path );
+
+    FileStorage          eeprom( path, EEPROM_SIZE );
+    MapStorage<NR_MAPS>  storage( eeprom, 0, BANK_SIZE );
+
+    if( !eeprom.isOpen() ) { printf( "Cannot open %s\n", path ); return 1; }
+
+    initMaps();
+    addMaps( storage );
+
+    int bytes = 0;
+    for( int i=0; i<NR_MAPS; i++ ) bytes += maps[i]->memSize();
+
+    printf( "%d maps, %d bytes, banks of %d bytes\n\n", NR_MAPS, bytes, BANK_SIZE );
+
+    // Commits
+    printf( "%-28s %6s %8s %6s %10s %10s\n", "commit", "done", "bytes", "runs",
+            "EEPROM ms", "host us" );
+
+    commit( "first, empty EEPROM",  storage, eeprom );
+    commit( "second, unchanged",    storage, eeprom );
+
+    tune( 5, 5, 99 );
+    commit( "1 cell, bank B empty", storage, eeprom );
+
+    tune( 5, 6, 98 );
+    commit( "1 more cell",          storage, eeprom );
+
+    tune( 5, 7, 97 );
+    commit( "1 more cell",          storage, eeprom );
+
+    for( int i=0; i<16; i++ ) tune( i, i, 10 + i );
+    commit( "16 cells",             storage, eeprom );
+
+    // Boot
+    printf( "\n%-28s %8s %10s\n", "boot", "bytes", "host us" );
+
+    {
+      MapStorage<NR_MAPS> s2( eeprom, 0, BANK_SIZE );
+      addMaps( s2 );
+
+      eeprom.resetCounters();
+      double t0 = now();
+      int8_t b  = s2.validBank();
+      printf( "%-28s %8zu %10.1f  bank %d\n", "headers only", eeprom.bytesRead(),
+              (now() - t0)*1e6, b );
+
+      eeprom.resetCounters();
+      t0 = now();
+      b  = s2.boot();
+      printf( "%-28s %8zu %10.1f  bank %d\n", "headers and maps", eeprom.bytesRead(),
+              (now() - t0)*1e6, b );
+    }
+
+    {
+      MapStorage<NR_MAPS> s3( eeprom, 0, BANK_SIZE );
+      s3.add( veMap, 1 ); s3.add( ignLazy, 1 ); s3.add( wueCurve, 1 );
+
+      eeprom.resetCounters();
+      double t0 = now();
+      int8_t b  = s3.boot();
+      printf( "%-28s %8zu %10.1f  bank %d\n", "lazy ignition map", eeprom.bytesRead(),
+              (now() - t0)*1e6, b );
+
+      eeprom.resetCounters();
+      t0 = now();
+      ignLazy.f( 2500, 30 );
+      printf( "%-28s %8zu %10.1f  %s\n", "first ignition lookup", eeprom.bytesRead(),
+              (now() - t0)*1e6, ignLazy.crc() == ignMap.crc() ? "ok" : "bad" );
+    }
+
+    // Power failures
+    uint32_t oldCrc[NR_MAPS], newCrc[NR_MAPS];
+    static uint8_t before[EEPROM_SIZE];
+
+    crcs( oldCrc );
+    eeprom.read( 0, before, EEPROM_SIZE );
+
+    for( int i=0; i<16; i++ ) tune( i, 15-i, 200 + i );
+    crcs( newCrc );
+
+    eeprom.resetCounters();
+    storage.commit();
+
+    const long total = eeprom.bytesWritten();
+    int        nOld  = 0, nNew = 0, nBad = 0;
+
+    for( long limit = 0; limit <= total; limit++ )
+    {
+      eeprom.update( 0, before, EEPROM_SIZE );        // state before the commit
+
+      {
+        MapStorage<NR_MAPS> s( eeprom, 0, BANK_SIZE );
+        addMaps( s );
+
+        s.boot();
+        for( int i=0; i<16; i++ ) tune( i, 15-i, 200 + i );
+
+        eeprom.setWriteLimit( limit );
+        s.commit();
+        eeprom.setWriteLimit( -1 );
+      }
+
+      MapStorage<NR_MAPS> s( eeprom, 0, BANK_SIZE );  // reboot
+      addMaps( s );
+
+      uint32_t c[NR_MAPS];
+
+      if( s.boot() < 0 ) { nBad++; continue; }
+
+      crcs( c );
+
+      if(      memcmp( c, oldCrc, sizeof(c) ) == 0 ) nOld++;
+      else if( memcmp( c, newCrc, sizeof(c) ) == 0 ) nNew++;
+      else                                           nBad++;
+    }
+
+    printf( "\nPower failure after 0 .. %ld bytes of a commit: %d old, %d new, %d corrupt\n",
+            total, nOld, nNew, nBad );
+
+    // Corrupt maps
+    eeprom.update( 0, before, EEPROM_SIZE );
+
+    {
+      MapStorage<NR_MAPS> s( eeprom, 0, BANK_SIZE );
+      addMaps( s );
+
+      const int8_t newest = s.validBank();
+
+      corrupt( eeprom, newest, 100 );                 // VE table
+
+      const int8_t b  = s.boot();
+      const bool   ok = b == 1 - newest && !s.modified();
+
+      printf( "Newest bank corrupt: bank %d booted, %s\n", b, ok ? "ok" : "bad" );
+      if( !ok ) nBad++;
+
+      corrupt( eeprom, 1 - newest, 100 );
+
+      uint32_t c[NR_MAPS];
+
+      veMap.cell(0,0) = 123;
+      veMap.modified();
+      crcs( oldCrc );
+
+      const bool kept = s.boot() < 0 && ( crcs( c ), memcmp( c, oldCrc, sizeof(c) ) == 0 );
+
+      printf( "Both banks corrupt: boot failed, maps %s\n", kept ? "untouched" : "changed" );
+      if( !kept ) nBad++;
+    }
+
+    // Corrupt lazy map
+    eeprom.update( 0, before, EEPROM_SIZE );
+
+    {
+      const uint16_t ign = veMap.memSize() + 100;   // in the ignition map
+
+      MapStorage<NR_MAPS> s( eeprom, 0, BANK_SIZE );
+      s.add( veMap, 1 ); s.add( ignLazy, 1 ); s.add( wueCurve, 1 );
+
+      const int8_t newest = s.validBank();
+
+      corrupt( eeprom, newest, ign );
+
+      s.boot();
+      ignLazy.f( 2500, 30 );
+
+      bool ok = ignLazy.loaded() && ignLazy.crc() == ignMap.crc();
+
+      printf( "Lazy map corrupt in newest bank: %s\n", ok ? "loaded from other bank" : "bad" );
+      if( !ok ) nBad++;
+
+      corrupt( eeprom, 1 - newest, ign );
+
+      for( int i=0; i<16; i++ ) ignLazy.cell(i,i) = 77;  // previous contents
+      ignLazy.modified();
+      ignLazy.rewritten();
+
+      const uint32_t previous = ignLazy.crc();
+
+      s.boot();
+      ignLazy.f( 2500, 30 );
+
+      ok = ignLazy.loadState() == LazyBase::LAZY_FAILED && ignLazy.crc() == previous;
+
+      printf( "Lazy map corrupt in both banks: %s\n", ok ? "failed, map untouched" : "bad" );
+      if( !ok ) nBad++;
+
+      tune( 0, 0, 55 );
+      ok = !s.commit();
+
+      static uint8_t image[1024];
+      BufferTransport out( image, sizeof(image) );
+      ExtendedSerial  so( out );
+
+      ignMap.sendTo( so );
+
+      BufferTransport in = BufferTransport::reader( image, ignMap.memSize() );
+      ExtendedSerial  si( in );
+
+      ignLazy.initReceive( 0, ignLazy.memSize() );
+      ignLazy.receiveFrom( si );
+
+      ok = ok && ignLazy.loaded() && s.commit();
+
+      printf( "Commit after failed lazy load: %s\n", ok ? "refused, then done after receive" : "bad" );
+      if( !ok ) nBad++;
+    }
+
+    unlink( path );
+
+    return nBad ? 1 : 0;
+}
+
+
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
@@ -147,7 +147,10 @@ void setup()
 
 #define sprint(expression) Serial.print(F("Size of ")); Serial.print( F(#expression) );  \
             Serial.print( F("\t with size: ") ); Serial.print( expression.xSize() ); \
-            Serial.print( F(": ") ); Serial.println( sizeof(expression) )
+            Serial.print( F(": ") ); Serial.print( sizeof(expression) );             \
+            Serial.print( F(", memSize: ") ); Serial.print( expression.memSize() );  \
+            Serial.print( F(", saved as core: ") );                                  \
+            Serial.println( expression.adapterOverhead() )
 
    sprint( testInt8 );
    sprint( testFix16 );
@@ -0,0 +1,167 @@
+//-----------------------------------------------------------------------------
+// Test compressed map transfers
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2018 Arend Lammertink
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by the Free
+// Software Foundation, version 3.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+// more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+//
+// The 16x16 float tuning table of src.ino is sent with sendCompressed() in
+// each mode and received thru a DecompressingTransport into a second map,
+// with the compressed bytes arriving a few at a time as over a serial link.
+// For each mode the size of the wire image, the bytes on the link and
+// whether the received map has the CRC of the sent one are printed.
+//
+// Then a header with an unknown mode and one with a row size larger than the
+// receiver's history are fed to a receiver, which must stop with mode()
+// COMPRESS_ERROR rather than decode them.
+//
+// The output should match testCompress_output.txt.
+//
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+
+#include "Map2D3D.h"
+#include "MapCompress.h"
+#include "Transport.h"
+
+#include <stdio.h>
+
+//-----------------------------------------------------------------------------
+// Globals
+//-----------------------------------------------------------------------------
+
+#define HISTORY     64      // bytes of row history of sender and receiver
+#define DRIBBLE     7       // bytes moved to the receiver per step
+
+typedef Map3D<16, 16, int16_t, float>  TuneMap;
+
+// Some test data from Miata Brain ECU, as in src.ino
+// https://sourceforge.net/projects/miatabrain/
+static const int16_t rpmSteps[16] =
+   {   256, 512, 1024, 1536, 2048, 2560, 3072, 3584, 4086, 4598, 5120, 5632, 6144, 6656, 7168, 7680};
+
+static const int16_t loadSteps[16] =
+   {     0,  10,   20,   30,   40,   50,   60,   70,   80,   90,  100,  110,  120,  130,  140,  150};
+
+static const float tuningMap[256] =
+   {   2.0, 10.0, 10.0, 28.0, 30.4, 30.4, 30.4, 36.9, 37.6, 40.9, 39.6, 31.3, 32.2, 30.0, 30.0, 30.0,
+       2.0, 10.0, 10.0, 28.0, 30.4, 30.4, 30.4, 36.9, 37.6, 40.9, 39.6, 31.3, 32.2, 30.0, 30.0, 30.0,
+       2.0, 10.0, 10.0, 28.0, 30.4, 30.4, 30.4, 36.9, 37.6, 40.9, 39.6, 31.3, 32.2, 30.0, 30.0, 30.0,
+       2.0, 10.0, 13.1, 24.2, 29.6, 29.8, 30.7, 36.0, 37.6, 39.8, 38.7, 31.3, 32.2, 30.0, 30.0, 30.0,
+       2.0, 14.0, 15.3, 22.0, 26.2, 27.3, 27.8, 31.6, 33.1, 34.4, 34.4, 32.4, 32.2, 30.0, 30.0, 30.0,
+       2.0, 12.2, 13.3, 19.8, 23.8, 24.9, 25.3, 28.9, 30.9, 32.0, 32.4, 30.2, 31.6, 30.0, 30.0, 30.0,
+       2.0,  8.7, 12.0, 18.7, 20.9, 23.3, 24.0, 27.6, 29.1, 30.2, 31.3, 28.4, 29.1, 27.6, 27.8, 27.8,
+       2.0,  5.1,  7.6, 16.9, 20.2, 21.8, 22.7, 26.0, 27.8, 29.6, 29.1, 26.2, 27.1, 26.4, 26.7, 26.7,
+       2.0,  3.3,  5.6, 15.6, 20.0, 21.3, 22.0, 24.0, 25.6, 27.6, 26.9, 25.1, 26.4, 25.3, 25.3, 25.3,
+       2.0,  1.6,  2.7, 12.2, 19.1, 20.9, 21.3, 23.3, 24.2, 25.8, 26.0, 24.0, 25.3, 24.7, 24.9, 24.9,
+       2.0, -1.3,  1.1,  8.9, 14.7, 20.2, 20.4, 22.4, 22.2, 23.1, 25.1, 23.3, 24.7, 23.8, 24.2, 24.2,
+       2.0, -2.0, -2.0,  4.9,  9.1, 11.8, 17.6, 19.1, 19.1, 22.7, 24.7, 22.7, 23.8, 24.0, 22.9, 22.9,
+       2.0, -2.0, -2.0,  4.9,  9.1, 11.8, 14.4, 19.1, 19.1, 19.6, 23.6, 21.3, 22.9, 22.9, 22.9, 22.9,
+       2.0, -2.0, -2.0,  4.9,  9.1, 11.8, 14.4, 19.1, 19.1, 19.6, 22.4, 21.3, 22.9, 22.9, 22.9, 22.9,
+       2.0, -2.0, -2.0,  4.9,  9.1, 11.8, 14.4, 19.1, 19.1, 19.6, 22.4, 21.3, 22.9, 22.9, 22.9, 22.9,
+       2.0, -2.0, -2.0,  4.9,  9.1, 11.8, 14.4, 19.1, 19.1, 19.6, 22.4, 21.3, 22.9, 22.9, 22.9, 22.9};
+
+static const char* modeNames[] = { "none", "rle", "delta+rle" };
+
+//-----------------------------------------------------------------------------
+// Functions
+//-----------------------------------------------------------------------------
+
+// Send 'src' compressed with 'mode' and receive it into 'dst'. Returns true
+// if dst ends up equal to src.
+static bool roundTrip( TuneMap& src, TuneMap& dst, uint8_t mode )
+{
+    RingTransport<2048>  link;      // sender to "serial line"
+    RingTransport<64>    rx;        // bytes arrived at the receiver
+
+    const size_t sent = sendCompressed<HISTORY>( src, link, mode );
+
+    DecompressingTransport<HISTORY> dt(rx);
+    ExtendedSerial                  ds(dt);
+
+    dst.initReceive( 0, dst.memSize() );
+
+    while( !dst.receiveFrom( ds ) )
+    {
+      if( !link.available() ) break;    // all arrived, map incomplete
+
+      for( int k=0; k<DRIBBLE && link.available(); k++ ) rx.write( (uint8_t)link.read() );
+    }
+
+    const bool ok = dst.receiveDone() && dst.crc() == src.crc();
+
+    printf( "%-10s  %4d bytes -> %4u on the link, received as %-10s  %s\n",
+            modeNames[mode], src.memSize(), (unsigned)sent,
+            dt.mode() <= COMPRESS_DELTA_RLE ? modeNames[dt.mode()] : "error", ok ? "ok" : "FAILED" );
+
+    return ok;
+}
+
+
+// Feed 'len' bytes to a receiver and report its mode and what it decoded.
+static void badHeader( const char* what, const uint8_t* bytes, size_t len )
+{
+    BufferTransport                 in = BufferTransport::reader( bytes, len );
+    DecompressingTransport<HISTORY> dt(in);
+
+    int decoded = 0;
+    while( dt.read() >= 0 ) decoded++;
+
+    printf( "%-14s mode %3d, %-8s  decoded: %d\n", what, dt.mode(),
+            dt.mode() == COMPRESS_ERROR ? "error" : "accepted", decoded );
+}
+
+
+int main()
+{
+    TuneMap a;
+
+    a.setX1s( rpmSteps );
+    a.setX2s( loadSteps );
+    a.setYs( tuningMap );
+
+    printf( "------------------------------------------\n" );
+    printf( "   Compressed transfer of a 16x16 float map\n" );
+    printf( "------------------------------------------\n" );
+
+    int failed = 0;
+
+    for( uint8_t mode = COMPRESS_NONE; mode <= COMPRESS_DELTA_RLE; mode++ )
+    {
+      TuneMap b;
+      if( !roundTrip( a, b, mode ) ) failed++;
+    }
+
+    printf( "------------------------------------------\n" );
+    printf( "   Bad headers\n" );
+    printf( "------------------------------------------\n" );
+
+    const uint8_t unknownMode[] = { 7, 0x00, 0x2A };
+    const uint8_t longRow[]     = { COMPRESS_DELTA_RLE, 0x00, 0x01, 0x00, 0x2A };  // 256 > HISTORY
+    const uint8_t zeroRow[]     = { COMPRESS_DELTA_RLE, 0x00, 0x00, 0x00, 0x2A };
+    const uint8_t goodRow[]     = { COMPRESS_DELTA_RLE, 0x40, 0x00, 0x00, 0x2A };
+
+    badHeader( "unknown mode", unknownMode, sizeof(unknownMode) );
+    badHeader( "row size 256", longRow,     sizeof(longRow)     );
+    badHeader( "row size 0",   zeroRow,     sizeof(zeroRow)     );
+    badHeader( "row size 64",  goodRow,     sizeof(goodRow)     );
+
+    printf( "------------------------------------------\n" );
+    printf( "%s\n", failed ? "FAILED" : "All transfers ok" );
+
+    return failed;
+}
@@ -0,0 +1,189 @@
+//-----------------------------------------------------------------------------
+// Test patches between calibration snapshots
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2018 Arend Lammertink
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by the Free
+// Software Foundation, version 3.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+// more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+//
+// A calibration of a 16x16 float map and a 12 point Fix16 map is snapshot
+// before and after a few cells and an axis value are tuned. The patches
+// between the snapshots are printed, and their size on the wire compared to
+// sending both maps in full.
+//
+// The patches are then streamed thru a MapPatcher, a few bytes per call,
+// into a copy of the calibration as it was before, and applied directly to
+// a second copy with MapDiff::apply. Both copies must end up with the CRCs
+// of the tuned maps. This is repeated for both byte orders.
+//
+// The output should match testPatch_output.txt.
+//
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+
+#include "Map2D3D.h"
+#include "MapPatch.h"
+#include "Transport.h"
+
+#include <stdio.h>
+
+//-----------------------------------------------------------------------------
+// Globals
+//-----------------------------------------------------------------------------
+
+#define SLICE       7       // bytes received per call of MapPatcher
+
+typedef Map3D<16, 16, int16_t, float, uint8_t>  FuelMap;
+typedef Map2D<12, uint8_t, Fix16>               AccelMap;
+
+static const char* mapNames[] = { "fuel", "accel" };
+
+static FuelMap  fuel,  fuelRx,  fuelCopy;
+static AccelMap accel, accelRx, accelCopy;
+
+static MapSnapshot<2, 2048>     before, after;
+static MapDiff<16, 256>         diff;
+
+//-----------------------------------------------------------------------------
+// Functions
+//-----------------------------------------------------------------------------
+
+// Load the maps from their wire images in snapshot 'snap'.
+static void restore( Map* const* maps, const MapSnapshot<2, 2048>& snap,
+                     ExtendedSerial::ByteOrder order )
+{
+    for( int i=0; i<snap.size(); i++ )
+    {
+      BufferTransport bt = BufferTransport::reader( snap.image(i), snap.imageSize(i) );
+      ExtendedSerial  s(bt);
+
+      s.setByteOrder( order );
+
+      maps[i]->initReceive( 0, snap.imageSize(i) );
+      maps[i]->receiveFrom( s );
+    }
+}
+
+
+// Returns true if maps a[0..1] have the CRCs of b[0..1].
+static bool equal( Map* const* a, Map* const* b )
+{
+    return a[0]->crc() == b[0]->crc() && a[1]->crc() == b[1]->crc();
+}
+
+
+static bool run( ExtendedSerial::ByteOrder order )
+{
+    int16_t rpm[16];
+    uint8_t load[16];
+    float   ve[256];
+    uint8_t tps[12];
+    float   enrich[12];
+
+    for( int i=0; i<16;  i++ ) { rpm[i] = 500 + i*500; load[i] = i*10; }
+    for( int i=0; i<256; i++ ) { ve[i] = 20 + i*0.25f; }
+    for( int i=0; i<12;  i++ ) { tps[i] = i*20; enrich[i] = i*0.5f; }
+
+    fuel.setX1s( rpm );
+    fuel.setX2s( load );
+    fuel.setYsFromFloat( ve );
+    accel.setXs( tps );
+    accel.setYsFromFloat( enrich );
+
+    Map* maps[]   = { &fuel,   &accel     };
+    Map* rxMaps[] = { &fuelRx, &accelRx   };
+    Map* copies[] = { &fuelCopy, &accelCopy };
+
+    before.take( maps, 2, order );
+
+    // Tune: three cells close together, one further on, an axis value of
+    // the fuel map and the last cell of the accel map.
+    ve[17]  = 60.0f;
+    ve[18]  = 61.5f;
+    ve[20]  = 59.0f;
+    ve[200] = 80.0f;
+    load[3] = 33;
+    enrich[11] = 7.0f;
+
+    fuel.setX2s( load );
+    fuel.setYsFromFloat( ve );
+    accel.setYsFromFloat( enrich );
+
+    after.take( maps, 2, order );
+
+    diff.clear();
+    if( !diff.diff( maps, 2, before, after ) ) { printf( "diff FAILED\n" ); return false; }
+
+    printf( "Byte order: %s\n", order == ExtendedSerial::WIRE_LITTLE_ENDIAN ? "little endian" : "big endian" );
+
+    for( int i=0; i<diff.size(); i++ )
+    {
+      const MapPatch& p = diff.patch(i);
+      printf( "  patch %-5s  offset %4u  size %3u\n", mapNames[p.map], p.offset, p.size );
+    }
+
+    printf( "  %u bytes on the wire instead of %d\n",
+            (unsigned)diff.wireSize(), fuel.memSize() + accel.memSize() );
+
+    // Stream the patches into the calibration as it was before.
+    restore( rxMaps, before, order );
+
+    RingTransport<512>  ring;
+    ExtendedSerial      tx(ring), rx(ring);
+
+    tx.setByteOrder( order );
+    rx.setByteOrder( order );
+
+    diff.sendTo( tx );
+
+    MapPatcher patcher( rxMaps, 2 );
+    int        calls = 1;
+
+    patcher.start();
+    while( !patcher.receiveFrom( rx, SLICE ) ) calls++;
+
+    const bool streamed = equal( rxMaps, maps );
+
+    printf( "  streamed: %d patches in %d calls, %s\n", patcher.patches(), calls,
+            streamed ? "ok" : "FAILED" );
+
+    // Apply them directly to another copy.
+    restore( copies, before, order );
+
+    const bool applied = diff.apply( copies, 2, order ) && equal( copies, maps );
+
+    printf( "  applied:  %s\n", applied ? "ok" : "FAILED" );
+
+    return streamed && applied;
+}
+
+
+int main()
+{
+    printf( "------------------------------------------\n" );
+    printf( "   Patches between calibration snapshots\n" );
+    printf( "------------------------------------------\n" );
+
+    int failed = 0;
+
+    if( !run( ExtendedSerial::WIRE_LITTLE_ENDIAN ) ) failed++;
+    if( !run( ExtendedSerial::WIRE_BIG_ENDIAN ) )    failed++;
+
+    printf( "------------------------------------------\n" );
+    printf( "%s\n", failed ? "FAILED" : "All patches ok" );
+
+    return failed;
+}
@@ -0,0 +1,97 @@
+//-----------------------------------------------------------------------------
+// Test toString() at the limits of its buffers
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2018 Arend Lammertink
+//
+// This program is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by the Free
+// Software Foundation, version 3.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+// more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+//
+// Numbers are formatted in fields wider than the buffer, in buffers too
+// small for their digits, and in the widest base. Padding which does not fit
+// must be cut off, never digits; digits which do not fit must give "ovf".
+// Each case prints the result in quotes and whether it is as expected.
+//
+// The output should match testToString_output.txt.
+//
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+
+#include "toString.h"
+
+#include <stdio.h>
+#include <string.h>
+
+//-----------------------------------------------------------------------------
+// Functions
+//-----------------------------------------------------------------------------
+
+static int failed = 0;
+
+static void check( const char* what, const char* result, const char* expected )
+{
+    const bool ok = strcmp( result, expected ) == 0;
+
+    if( !ok ) failed++;
+
+    printf( "%-28s \"%s\"  %s\n", what, result, ok ? "ok" : "FAILED" );
+}
+
+
+int main()
+{
+    char buf[8];
+    char all[TO_STRING_SIZE];
+
+    printf( "------------------------------------------\n" );
+    printf( "   toString() limits\n" );
+    printf( "------------------------------------------\n" );
+
+    // Field wider than the buffer: the padding is cut, the digits kept.
+    check( "toString(buf,8,5,40)",      toString( buf, 8, 5, 40 ),      "      5" );
+    check( "toString(buf,8,-42L,40)",   toString( buf, 8, -42L, 40 ),   "    -42" );
+    check( "toString(buf,8,3.25,40,2)", toString( buf, 8, 3.25, 40, 2 ), "   3.25" );
+
+    const char* s = toString( 5, 40 );
+    const bool  cut = s[ strlen(s) - 1 ] == '5' &&
+                      strlen(s) == ( 40 < TO_STRING_SIZE - 1 ? 40 : TO_STRING_SIZE - 1 );
+
+    printf( "%-28s %s\n", "toString(5, 40)", cut ? "padding cut, ok" : "FAILED" );
+    if( !cut ) failed++;
+
+    // Digits which do not fit the buffer give an overflow marker.
+    check( "toString(buf,5,123456L,8)", toString( buf, 5, 123456L, 8 ), " ovf" );
+    check( "toString(buf,5,1234L,8)",   toString( buf, 5, 1234L, 8 ),   "1234" );
+    check( "toString(buf,5,12345L,0)",  toString( buf, 5, 12345L, 0 ),  "ovf" );
+    check( "toString(buf,3,123,4)",     toString( buf, 3, 123, 4 ),     "ov" );
+    check( "toString(buf,8,-1234567L)", toString( buf, 8, -1234567L, 4 ), " ovf" );
+    check( "toString(buf,8,1.5,9,3)",   toString( buf, 8, 1.5, 9, 3 ),  "  1.500" );
+
+    // The widest number: all bits of a long in binary.
+    memset( all, '1', sizeof(all) - 2 );
+    all[ sizeof(all) - 2 ] = '\0';
+
+    s = toString( -1L, 4, BIN );
+    printf( "%-28s %s\n", "toString(-1L, 4, BIN)",
+            strcmp( s, all ) == 0 && strlen(s) == 8*sizeof(long) ? "all bits, ok" : "FAILED" );
+    if( strcmp( s, all ) != 0 ) failed++;
+
+    check( "toString(255UL, 12, BIN)",  toString( 255UL, 12, BIN ),     "    11111111" );
+
+    printf( "------------------------------------------\n" );
+    printf( "%s\n", failed ? "FAILED" : "All conversions ok" );
+
+    return failed;
+}
@@ -68,11 +68,7 @@ for X in ["int8_t", "uint8_t", "int16_t", "uint16_t", "Fix16" ]:
 
     rhead,rtail = getCast(interpol_tp, Y)
 
-    print"#ifdef DEBUG"
-    print"  " + interpol_tp + " retval = ("
-    print"#else"
     print"  return " + rhead
-    print"#endif"
 
 
     prcx,pocx = getCast(X,interpol_tp)
@@ -83,13 +79,8 @@ for X in ["int8_t", "uint8_t", "int16_t", "uint16_t", "Fix16" ]:
     print"                               " + prcx + "x_2" + pocx + ","
     print"                               " + prcy + "y_1" + pocy + ","
     print"                               " + prcy + "y_2" + pocy + " )"
-    print
 
-    print"#ifndef DEBUG"
     print"                             " + rtail +";"
-    print"#else"
-    print"  return " + rhead + "retval" + rtail +";"
-    print"#endif"
 
     print"}"
     print
@@ -49,10 +49,14 @@ def getCast( from_tp, to_tp ):
 
 
 
-for X in ["int8_t", "uint8_t", "int16_t", "uint16_t", "Fix16"]:
+# The axes of a 3D map may have different types, so every combination of X1
+# and X2 gets its own specialization, each axis with its own cast to Fix16.
+
+for X1 in ["int8_t", "uint8_t", "int16_t", "uint16_t", "Fix16"]:
+ for X2 in ["int8_t", "uint8_t", "int16_t", "uint16_t", "Fix16"]:
   for Y in ["int8_t", "uint8_t", "int16_t", "uint16_t", "Fix16", "float", "double"]:
 
-    if X == "Fix16" and Y == "Fix16":
+    if X1 == "Fix16" and X2 == "Fix16" and Y == "Fix16":
       break  # no casting exercise required, so no specialisation either.
 
     interpol_tp = Y
@@ -61,41 +65,34 @@ for X in ["int8_t", "uint8_t", "int16_t", "uint16_t", "Fix16"]:
 
 
     print"template<>"
-    print"inline", Y, "interpolate(", X, "x1,", X, "x2,"
-    print"                           ", X,"x_1,", X, "x_2,", X,"x_3,", X, "x_4,"
+    print"inline", Y, "interpolate(", X1, "x1,", X2, "x2,"
+    print"                           ", X1,"x_1,", X1, "x_2,", X2,"x_3,", X2, "x_4,"
     print"                           ", Y, "y_1,", Y, "y_2,",  Y, "y_3,", Y, "y_4 )"
     print"{"
 
 
     rhead,rtail = getCast(interpol_tp, Y)
 
-    print"#ifdef DEBUG"
-    print"  " + interpol_tp + " retval = ("
-    print"#else"
     print"  return " + rhead
-    print"#endif"
 
 
-    prcx,pocx = getCast(X,interpol_tp)
-    prcy,pocy = getCast(Y,interpol_tp)
+    prcx1,pocx1 = getCast(X1,interpol_tp)
+    prcx2,pocx2 = getCast(X2,interpol_tp)
+    prcy,pocy   = getCast(Y,interpol_tp)
     
-    print"                  interpolate( " + prcx + "x1"  + pocx + ","
-    print"                               " + prcx + "x2"  + pocx + ","
-    print"                               " + prcx + "x_1" + pocx + ","
-    print"                               " + prcx + "x_2" + pocx + ","
-    print"                               " + prcx + "x_3" + pocx + ","
-    print"                               " + prcx + "x_4" + pocx + ","
+    print"                  interpolate( " + prcx1 + "x1"  + pocx1 + ","
+    print"                               " + prcx2 + "x2"  + pocx2 + ","
+    print"                               " + prcx1 + "x_1" + pocx1 + ","
+    print"                               " + prcx1 + "x_2" + pocx1 + ","
+    print"                               " + prcx2 + "x_3" + pocx2 + ","
+    print"                               " + prcx2 + "x_4" + pocx2 + ","
     print"                               " + prcy + "y_1" + pocy + ","
     print"                               " + prcy + "y_2" + pocy + ","
     print"                               " + prcy + "y_3" + pocy + ","
     print"                               " + prcy + "y_4" + pocy + " )"
 
 
-    print"#ifndef DEBUG"
     print"                             " + rtail +";"
-    print"#else"
-    print"  return " + rhead + "retval" + rtail +";"
-    print"#endif"
 
     print"}"
     print
@@ -28,22 +28,13 @@ template<>
 inline int8_t interpolate( int8_t x, int8_t x_1, int8_t x_2,
                             int8_t y_1, int8_t y_2 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return static_cast<int8_t>(static_cast<int16_t>(
-#endif
                   interpolate( static_cast<Fix16>(static_cast<int16_t>(x)),
                                static_cast<Fix16>(static_cast<int16_t>(x_1)),
                                static_cast<Fix16>(static_cast<int16_t>(x_2)),
                                static_cast<Fix16>(static_cast<int16_t>(y_1)),
                                static_cast<Fix16>(static_cast<int16_t>(y_2)) )
-
-#ifndef DEBUG
                              ));
-#else
-  return static_cast<int8_t>(static_cast<int16_t>(retval));
-#endif
 }
 
 
@@ -51,22 +42,13 @@ template<>
 inline uint8_t interpolate( int8_t x, int8_t x_1, int8_t x_2,
                             uint8_t y_1, uint8_t y_2 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return static_cast<uint8_t>(static_cast<int16_t>(
-#endif
                   interpolate( static_cast<Fix16>(static_cast<int16_t>(x)),
                                static_cast<Fix16>(static_cast<int16_t>(x_1)),
                                static_cast<Fix16>(static_cast<int16_t>(x_2)),
                                static_cast<Fix16>(static_cast<int16_t>(y_1)),
                                static_cast<Fix16>(static_cast<int16_t>(y_2)) )
-
-#ifndef DEBUG
                              ));
-#else
-  return static_cast<uint8_t>(static_cast<int16_t>(retval));
-#endif
 }
 
 
@@ -74,22 +56,13 @@ template<>
 inline int16_t interpolate( int8_t x, int8_t x_1, int8_t x_2,
                             int16_t y_1, int16_t y_2 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return static_cast<int16_t>(
-#endif
                   interpolate( static_cast<Fix16>(static_cast<int16_t>(x)),
                                static_cast<Fix16>(static_cast<int16_t>(x_1)),
                                static_cast<Fix16>(static_cast<int16_t>(x_2)),
                                static_cast<Fix16>(y_1),
                                static_cast<Fix16>(y_2) )
-
-#ifndef DEBUG
                              );
-#else
-  return static_cast<int16_t>(retval);
-#endif
 }
 
 
@@ -97,22 +70,13 @@ template<>
 inline uint16_t interpolate( int8_t x, int8_t x_1, int8_t x_2,
                             uint16_t y_1, uint16_t y_2 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return static_cast<uint16_t>(static_cast<float>(
-#endif
                   interpolate( static_cast<Fix16>(static_cast<int16_t>(x)),
                                static_cast<Fix16>(static_cast<int16_t>(x_1)),
                                static_cast<Fix16>(static_cast<int16_t>(x_2)),
                                static_cast<Fix16>(static_cast<float>(y_1)),
                                static_cast<Fix16>(static_cast<float>(y_2)) )
-
-#ifndef DEBUG
                              ));
-#else
-  return static_cast<uint16_t>(static_cast<float>(retval));
-#endif
 }
 
 
@@ -120,22 +84,13 @@ template<>
 inline Fix16 interpolate( int8_t x, int8_t x_1, int8_t x_2,
                             Fix16 y_1, Fix16 y_2 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return 
-#endif
                   interpolate( static_cast<Fix16>(static_cast<int16_t>(x)),
                                static_cast<Fix16>(static_cast<int16_t>(x_1)),
                                static_cast<Fix16>(static_cast<int16_t>(x_2)),
                                y_1,
                                y_2 )
-
-#ifndef DEBUG
                              ;
-#else
-  return retval;
-#endif
 }
 
 
@@ -143,22 +98,13 @@ template<>
 inline float interpolate( int8_t x, int8_t x_1, int8_t x_2,
                             float y_1, float y_2 )
 {
-#ifdef DEBUG
-  float retval = (
-#else
   return 
-#endif
                   interpolate( static_cast<float>(x),
                                static_cast<float>(x_1),
                                static_cast<float>(x_2),
                                y_1,
                                y_2 )
-
-#ifndef DEBUG
                              ;
-#else
-  return retval;
-#endif
 }
 
 
@@ -166,22 +112,13 @@ template<>
 inline double interpolate( int8_t x, int8_t x_1, int8_t x_2,
                             double y_1, double y_2 )
 {
-#ifdef DEBUG
-  double retval = (
-#else
   return 
-#endif
                   interpolate( static_cast<double>(x),
                                static_cast<double>(x_1),
                                static_cast<double>(x_2),
                                y_1,
                                y_2 )
-
-#ifndef DEBUG
                              ;
-#else
-  return retval;
-#endif
 }
 
 
@@ -189,22 +126,13 @@ template<>
 inline int8_t interpolate( uint8_t x, uint8_t x_1, uint8_t x_2,
                             int8_t y_1, int8_t y_2 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return static_cast<int8_t>(static_cast<int16_t>(
-#endif
                   interpolate( static_cast<Fix16>(static_cast<int16_t>(x)),
                                static_cast<Fix16>(static_cast<int16_t>(x_1)),
                                static_cast<Fix16>(static_cast<int16_t>(x_2)),
                                static_cast<Fix16>(static_cast<int16_t>(y_1)),
                                static_cast<Fix16>(static_cast<int16_t>(y_2)) )
-
-#ifndef DEBUG
                              ));
-#else
-  return static_cast<int8_t>(static_cast<int16_t>(retval));
-#endif
 }
 
 
@@ -212,22 +140,13 @@ template<>
 inline uint8_t interpolate( uint8_t x, uint8_t x_1, uint8_t x_2,
                             uint8_t y_1, uint8_t y_2 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return static_cast<uint8_t>(static_cast<int16_t>(
-#endif
                   interpolate( static_cast<Fix16>(static_cast<int16_t>(x)),
                                static_cast<Fix16>(static_cast<int16_t>(x_1)),
                                static_cast<Fix16>(static_cast<int16_t>(x_2)),
                                static_cast<Fix16>(static_cast<int16_t>(y_1)),
                                static_cast<Fix16>(static_cast<int16_t>(y_2)) )
-
-#ifndef DEBUG
                              ));
-#else
-  return static_cast<uint8_t>(static_cast<int16_t>(retval));
-#endif
 }
 
 
@@ -235,22 +154,13 @@ template<>
 inline int16_t interpolate( uint8_t x, uint8_t x_1, uint8_t x_2,
                             int16_t y_1, int16_t y_2 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return static_cast<int16_t>(
-#endif
                   interpolate( static_cast<Fix16>(static_cast<int16_t>(x)),
                                static_cast<Fix16>(static_cast<int16_t>(x_1)),
                                static_cast<Fix16>(static_cast<int16_t>(x_2)),
                                static_cast<Fix16>(y_1),
                                static_cast<Fix16>(y_2) )
-
-#ifndef DEBUG
                              );
-#else
-  return static_cast<int16_t>(retval);
-#endif
 }
 
 
@@ -258,22 +168,13 @@ template<>
 inline uint16_t interpolate( uint8_t x, uint8_t x_1, uint8_t x_2,
                             uint16_t y_1, uint16_t y_2 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return static_cast<uint16_t>(static_cast<float>(
-#endif
                   interpolate( static_cast<Fix16>(static_cast<int16_t>(x)),
                                static_cast<Fix16>(static_cast<int16_t>(x_1)),
                                static_cast<Fix16>(static_cast<int16_t>(x_2)),
                                static_cast<Fix16>(static_cast<float>(y_1)),
                                static_cast<Fix16>(static_cast<float>(y_2)) )
-
-#ifndef DEBUG
                              ));
-#else
-  return static_cast<uint16_t>(static_cast<float>(retval));
-#endif
 }
 
 
@@ -281,22 +182,13 @@ template<>
 inline Fix16 interpolate( uint8_t x, uint8_t x_1, uint8_t x_2,
                             Fix16 y_1, Fix16 y_2 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return 
-#endif
                   interpolate( static_cast<Fix16>(static_cast<int16_t>(x)),
                                static_cast<Fix16>(static_cast<int16_t>(x_1)),
                                static_cast<Fix16>(static_cast<int16_t>(x_2)),
                                y_1,
                                y_2 )
-
-#ifndef DEBUG
                              ;
-#else
-  return retval;
-#endif
 }
 
 
@@ -304,22 +196,13 @@ template<>
 inline float interpolate( uint8_t x, uint8_t x_1, uint8_t x_2,
                             float y_1, float y_2 )
 {
-#ifdef DEBUG
-  float retval = (
-#else
   return 
-#endif
                   interpolate( static_cast<float>(x),
                                static_cast<float>(x_1),
                                static_cast<float>(x_2),
                                y_1,
                                y_2 )
-
-#ifndef DEBUG
                              ;
-#else
-  return retval;
-#endif
 }
 
 
@@ -327,22 +210,13 @@ template<>
 inline double interpolate( uint8_t x, uint8_t x_1, uint8_t x_2,
                             double y_1, double y_2 )
 {
-#ifdef DEBUG
-  double retval = (
-#else
   return 
-#endif
                   interpolate( static_cast<double>(x),
                                static_cast<double>(x_1),
                                static_cast<double>(x_2),
                                y_1,
                                y_2 )
-
-#ifndef DEBUG
                              ;
-#else
-  return retval;
-#endif
 }
 
 
@@ -350,22 +224,13 @@ template<>
 inline int8_t interpolate( int16_t x, int16_t x_1, int16_t x_2,
                             int8_t y_1, int8_t y_2 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return static_cast<int8_t>(static_cast<int16_t>(
-#endif
                   interpolate( static_cast<Fix16>(x),
                                static_cast<Fix16>(x_1),
                                static_cast<Fix16>(x_2),
                                static_cast<Fix16>(static_cast<int16_t>(y_1)),
                                static_cast<Fix16>(static_cast<int16_t>(y_2)) )
-
-#ifndef DEBUG
                              ));
-#else
-  return static_cast<int8_t>(static_cast<int16_t>(retval));
-#endif
 }
 
 
@@ -373,22 +238,13 @@ template<>
 inline uint8_t interpolate( int16_t x, int16_t x_1, int16_t x_2,
                             uint8_t y_1, uint8_t y_2 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return static_cast<uint8_t>(static_cast<int16_t>(
-#endif
                   interpolate( static_cast<Fix16>(x),
                                static_cast<Fix16>(x_1),
                                static_cast<Fix16>(x_2),
                                static_cast<Fix16>(static_cast<int16_t>(y_1)),
                                static_cast<Fix16>(static_cast<int16_t>(y_2)) )
-
-#ifndef DEBUG
                              ));
-#else
-  return static_cast<uint8_t>(static_cast<int16_t>(retval));
-#endif
 }
 
 
@@ -396,22 +252,13 @@ template<>
 inline int16_t interpolate( int16_t x, int16_t x_1, int16_t x_2,
                             int16_t y_1, int16_t y_2 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return static_cast<int16_t>(
-#endif
                   interpolate( static_cast<Fix16>(x),
                                static_cast<Fix16>(x_1),
                                static_cast<Fix16>(x_2),
                                static_cast<Fix16>(y_1),
                                static_cast<Fix16>(y_2) )
-
-#ifndef DEBUG
                              );
-#else
-  return static_cast<int16_t>(retval);
-#endif
 }
 
 
@@ -419,22 +266,13 @@ template<>
 inline uint16_t interpolate( int16_t x, int16_t x_1, int16_t x_2,
                             uint16_t y_1, uint16_t y_2 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return static_cast<uint16_t>(static_cast<float>(
-#endif
                   interpolate( static_cast<Fix16>(x),
                                static_cast<Fix16>(x_1),
                                static_cast<Fix16>(x_2),
                                static_cast<Fix16>(static_cast<float>(y_1)),
                                static_cast<Fix16>(static_cast<float>(y_2)) )
-
-#ifndef DEBUG
                              ));
-#else
-  return static_cast<uint16_t>(static_cast<float>(retval));
-#endif
 }
 
 
@@ -442,22 +280,13 @@ template<>
 inline Fix16 interpolate( int16_t x, int16_t x_1, int16_t x_2,
                             Fix16 y_1, Fix16 y_2 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return 
-#endif
                   interpolate( static_cast<Fix16>(x),
                                static_cast<Fix16>(x_1),
                                static_cast<Fix16>(x_2),
                                y_1,
                                y_2 )
-
-#ifndef DEBUG
                              ;
-#else
-  return retval;
-#endif
 }
 
 
@@ -465,22 +294,13 @@ template<>
 inline float interpolate( int16_t x, int16_t x_1, int16_t x_2,
                             float y_1, float y_2 )
 {
-#ifdef DEBUG
-  float retval = (
-#else
   return 
-#endif
                   interpolate( static_cast<float>(x),
                                static_cast<float>(x_1),
                                static_cast<float>(x_2),
                                y_1,
                                y_2 )
-
-#ifndef DEBUG
                              ;
-#else
-  return retval;
-#endif
 }
 
 
@@ -488,22 +308,13 @@ template<>
 inline double interpolate( int16_t x, int16_t x_1, int16_t x_2,
                             double y_1, double y_2 )
 {
-#ifdef DEBUG
-  double retval = (
-#else
   return 
-#endif
                   interpolate( static_cast<double>(x),
                                static_cast<double>(x_1),
                                static_cast<double>(x_2),
                                y_1,
                                y_2 )
-
-#ifndef DEBUG
                              ;
-#else
-  return retval;
-#endif
 }
 
 
@@ -511,22 +322,13 @@ template<>
 inline int8_t interpolate( uint16_t x, uint16_t x_1, uint16_t x_2,
                             int8_t y_1, int8_t y_2 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return static_cast<int8_t>(static_cast<int16_t>(
-#endif
                   interpolate( static_cast<Fix16>(static_cast<float>(x)),
                                static_cast<Fix16>(static_cast<float>(x_1)),
                                static_cast<Fix16>(static_cast<float>(x_2)),
                                static_cast<Fix16>(static_cast<int16_t>(y_1)),
                                static_cast<Fix16>(static_cast<int16_t>(y_2)) )
-
-#ifndef DEBUG
                              ));
-#else
-  return static_cast<int8_t>(static_cast<int16_t>(retval));
-#endif
 }
 
 
@@ -534,22 +336,13 @@ template<>
 inline uint8_t interpolate( uint16_t x, uint16_t x_1, uint16_t x_2,
                             uint8_t y_1, uint8_t y_2 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return static_cast<uint8_t>(static_cast<int16_t>(
-#endif
                   interpolate( static_cast<Fix16>(static_cast<float>(x)),
                                static_cast<Fix16>(static_cast<float>(x_1)),
                                static_cast<Fix16>(static_cast<float>(x_2)),
                                static_cast<Fix16>(static_cast<int16_t>(y_1)),
                                static_cast<Fix16>(static_cast<int16_t>(y_2)) )
-
-#ifndef DEBUG
                              ));
-#else
-  return static_cast<uint8_t>(static_cast<int16_t>(retval));
-#endif
 }
 
 
@@ -557,22 +350,13 @@ template<>
 inline int16_t interpolate( uint16_t x, uint16_t x_1, uint16_t x_2,
                             int16_t y_1, int16_t y_2 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return static_cast<int16_t>(
-#endif
                   interpolate( static_cast<Fix16>(static_cast<float>(x)),
                                static_cast<Fix16>(static_cast<float>(x_1)),
                                static_cast<Fix16>(static_cast<float>(x_2)),
                                static_cast<Fix16>(y_1),
                                static_cast<Fix16>(y_2) )
-
-#ifndef DEBUG
                              );
-#else
-  return static_cast<int16_t>(retval);
-#endif
 }
 
 
@@ -580,22 +364,13 @@ template<>
 inline uint16_t interpolate( uint16_t x, uint16_t x_1, uint16_t x_2,
                             uint16_t y_1, uint16_t y_2 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return static_cast<uint16_t>(static_cast<float>(
-#endif
                   interpolate( static_cast<Fix16>(static_cast<float>(x)),
                                static_cast<Fix16>(static_cast<float>(x_1)),
                                static_cast<Fix16>(static_cast<float>(x_2)),
                                static_cast<Fix16>(static_cast<float>(y_1)),
                                static_cast<Fix16>(static_cast<float>(y_2)) )
-
-#ifndef DEBUG
                              ));
-#else
-  return static_cast<uint16_t>(static_cast<float>(retval));
-#endif
 }
 
 
@@ -603,22 +378,13 @@ template<>
 inline Fix16 interpolate( uint16_t x, uint16_t x_1, uint16_t x_2,
                             Fix16 y_1, Fix16 y_2 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return 
-#endif
                   interpolate( static_cast<Fix16>(static_cast<float>(x)),
                                static_cast<Fix16>(static_cast<float>(x_1)),
                                static_cast<Fix16>(static_cast<float>(x_2)),
                                y_1,
                                y_2 )
-
-#ifndef DEBUG
                              ;
-#else
-  return retval;
-#endif
 }
 
 
@@ -626,22 +392,13 @@ template<>
 inline float interpolate( uint16_t x, uint16_t x_1, uint16_t x_2,
                             float y_1, float y_2 )
 {
-#ifdef DEBUG
-  float retval = (
-#else
   return 
-#endif
                   interpolate( static_cast<float>(x),
                                static_cast<float>(x_1),
                                static_cast<float>(x_2),
                                y_1,
                                y_2 )
-
-#ifndef DEBUG
                              ;
-#else
-  return retval;
-#endif
 }
 
 
@@ -649,22 +406,13 @@ template<>
 inline double interpolate( uint16_t x, uint16_t x_1, uint16_t x_2,
                             double y_1, double y_2 )
 {
-#ifdef DEBUG
-  double retval = (
-#else
   return 
-#endif
                   interpolate( static_cast<double>(x),
                                static_cast<double>(x_1),
                                static_cast<double>(x_2),
                                y_1,
                                y_2 )
-
-#ifndef DEBUG
                              ;
-#else
-  return retval;
-#endif
 }
 
 
@@ -672,22 +420,13 @@ template<>
 inline int8_t interpolate( Fix16 x, Fix16 x_1, Fix16 x_2,
                             int8_t y_1, int8_t y_2 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return static_cast<int8_t>(static_cast<int16_t>(
-#endif
                   interpolate( x,
                                x_1,
                                x_2,
                                static_cast<Fix16>(static_cast<int16_t>(y_1)),
                                static_cast<Fix16>(static_cast<int16_t>(y_2)) )
-
-#ifndef DEBUG
                              ));
-#else
-  return static_cast<int8_t>(static_cast<int16_t>(retval));
-#endif
 }
 
 
@@ -695,22 +434,13 @@ template<>
 inline uint8_t interpolate( Fix16 x, Fix16 x_1, Fix16 x_2,
                             uint8_t y_1, uint8_t y_2 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return static_cast<uint8_t>(static_cast<int16_t>(
-#endif
                   interpolate( x,
                                x_1,
                                x_2,
                                static_cast<Fix16>(static_cast<int16_t>(y_1)),
                                static_cast<Fix16>(static_cast<int16_t>(y_2)) )
-
-#ifndef DEBUG
                              ));
-#else
-  return static_cast<uint8_t>(static_cast<int16_t>(retval));
-#endif
 }
 
 
@@ -718,22 +448,13 @@ template<>
 inline int16_t interpolate( Fix16 x, Fix16 x_1, Fix16 x_2,
                             int16_t y_1, int16_t y_2 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return static_cast<int16_t>(
-#endif
                   interpolate( x,
                                x_1,
                                x_2,
                                static_cast<Fix16>(y_1),
                                static_cast<Fix16>(y_2) )
-
-#ifndef DEBUG
                              );
-#else
-  return static_cast<int16_t>(retval);
-#endif
 }
 
 
@@ -741,22 +462,13 @@ template<>
 inline uint16_t interpolate( Fix16 x, Fix16 x_1, Fix16 x_2,
                             uint16_t y_1, uint16_t y_2 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return static_cast<uint16_t>(static_cast<float>(
-#endif
                   interpolate( x,
                                x_1,
                                x_2,
                                static_cast<Fix16>(static_cast<float>(y_1)),
                                static_cast<Fix16>(static_cast<float>(y_2)) )
-
-#ifndef DEBUG
                              ));
-#else
-  return static_cast<uint16_t>(static_cast<float>(retval));
-#endif
 }
 
 
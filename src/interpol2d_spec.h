@@ -29,11 +29,7 @@ inline int8_t interpolate( int8_t x1, int8_t x2,
                             int8_t x_1, int8_t x_2, int8_t x_3, int8_t x_4,
                             int8_t y_1, int8_t y_2, int8_t y_3, int8_t y_4 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return static_cast<int8_t>(static_cast<int16_t>(
-#endif
                   interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
                                static_cast<Fix16>(static_cast<int16_t>(x2)),
                                static_cast<Fix16>(static_cast<int16_t>(x_1)),
@@ -44,11 +40,7 @@ inline int8_t interpolate( int8_t x1, int8_t x2,
                                static_cast<Fix16>(static_cast<int16_t>(y_2)),
                                static_cast<Fix16>(static_cast<int16_t>(y_3)),
                                static_cast<Fix16>(static_cast<int16_t>(y_4)) )
-#ifndef DEBUG
                              ));
-#else
-  return static_cast<int8_t>(static_cast<int16_t>(retval));
-#endif
 }
 
 
@@ -57,11 +49,7 @@ inline uint8_t interpolate( int8_t x1, int8_t x2,
                             int8_t x_1, int8_t x_2, int8_t x_3, int8_t x_4,
                             uint8_t y_1, uint8_t y_2, uint8_t y_3, uint8_t y_4 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return static_cast<uint8_t>(static_cast<int16_t>(
-#endif
                   interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
                                static_cast<Fix16>(static_cast<int16_t>(x2)),
                                static_cast<Fix16>(static_cast<int16_t>(x_1)),
@@ -72,11 +60,7 @@ inline uint8_t interpolate( int8_t x1, int8_t x2,
                                static_cast<Fix16>(static_cast<int16_t>(y_2)),
                                static_cast<Fix16>(static_cast<int16_t>(y_3)),
                                static_cast<Fix16>(static_cast<int16_t>(y_4)) )
-#ifndef DEBUG
                              ));
-#else
-  return static_cast<uint8_t>(static_cast<int16_t>(retval));
-#endif
 }
 
 
@@ -85,11 +69,7 @@ inline int16_t interpolate( int8_t x1, int8_t x2,
                             int8_t x_1, int8_t x_2, int8_t x_3, int8_t x_4,
                             int16_t y_1, int16_t y_2, int16_t y_3, int16_t y_4 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return static_cast<int16_t>(
-#endif
                   interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
                                static_cast<Fix16>(static_cast<int16_t>(x2)),
                                static_cast<Fix16>(static_cast<int16_t>(x_1)),
@@ -100,11 +80,7 @@ inline int16_t interpolate( int8_t x1, int8_t x2,
                                static_cast<Fix16>(y_2),
                                static_cast<Fix16>(y_3),
                                static_cast<Fix16>(y_4) )
-#ifndef DEBUG
                              );
-#else
-  return static_cast<int16_t>(retval);
-#endif
 }
 
 
@@ -113,11 +89,7 @@ inline uint16_t interpolate( int8_t x1, int8_t x2,
                             int8_t x_1, int8_t x_2, int8_t x_3, int8_t x_4,
                             uint16_t y_1, uint16_t y_2, uint16_t y_3, uint16_t y_4 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return static_cast<uint16_t>(static_cast<float>(
-#endif
                   interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
                                static_cast<Fix16>(static_cast<int16_t>(x2)),
                                static_cast<Fix16>(static_cast<int16_t>(x_1)),
@@ -128,11 +100,7 @@ inline uint16_t interpolate( int8_t x1, int8_t x2,
                                static_cast<Fix16>(static_cast<float>(y_2)),
                                static_cast<Fix16>(static_cast<float>(y_3)),
                                static_cast<Fix16>(static_cast<float>(y_4)) )
-#ifndef DEBUG
                              ));
-#else
-  return static_cast<uint16_t>(static_cast<float>(retval));
-#endif
 }
 
 
@@ -141,11 +109,7 @@ inline Fix16 interpolate( int8_t x1, int8_t x2,
                             int8_t x_1, int8_t x_2, int8_t x_3, int8_t x_4,
                             Fix16 y_1, Fix16 y_2, Fix16 y_3, Fix16 y_4 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return 
-#endif
                   interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
                                static_cast<Fix16>(static_cast<int16_t>(x2)),
                                static_cast<Fix16>(static_cast<int16_t>(x_1)),
@@ -156,11 +120,7 @@ inline Fix16 interpolate( int8_t x1, int8_t x2,
                                y_2,
                                y_3,
                                y_4 )
-#ifndef DEBUG
                              ;
-#else
-  return retval;
-#endif
 }
 
 
@@ -169,11 +129,7 @@ inline float interpolate( int8_t x1, int8_t x2,
                             int8_t x_1, int8_t x_2, int8_t x_3, int8_t x_4,
                             float y_1, float y_2, float y_3, float y_4 )
 {
-#ifdef DEBUG
-  float retval = (
-#else
   return 
-#endif
                   interpolate( static_cast<float>(x1),
                                static_cast<float>(x2),
                                static_cast<float>(x_1),
@@ -184,11 +140,7 @@ inline float interpolate( int8_t x1, int8_t x2,
                                y_2,
                                y_3,
                                y_4 )
-#ifndef DEBUG
                              ;
-#else
-  return retval;
-#endif
 }
 
 
@@ -197,11 +149,7 @@ inline double interpolate( int8_t x1, int8_t x2,
                             int8_t x_1, int8_t x_2, int8_t x_3, int8_t x_4,
                             double y_1, double y_2, double y_3, double y_4 )
 {
-#ifdef DEBUG
-  double retval = (
-#else
   return 
-#endif
                   interpolate( static_cast<double>(x1),
                                static_cast<double>(x2),
                                static_cast<double>(x_1),
@@ -212,24 +160,16 @@ inline double interpolate( int8_t x1, int8_t x2,
                                y_2,
                                y_3,
                                y_4 )
-#ifndef DEBUG
                              ;
-#else
-  return retval;
-#endif
 }
 
 
 template<>
-inline int8_t interpolate( uint8_t x1, uint8_t x2,
-                            uint8_t x_1, uint8_t x_2, uint8_t x_3, uint8_t x_4,
+inline int8_t interpolate( int8_t x1, uint8_t x2,
+                            int8_t x_1, int8_t x_2, uint8_t x_3, uint8_t x_4,
                             int8_t y_1, int8_t y_2, int8_t y_3, int8_t y_4 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return static_cast<int8_t>(static_cast<int16_t>(
-#endif
                   interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
                                static_cast<Fix16>(static_cast<int16_t>(x2)),
                                static_cast<Fix16>(static_cast<int16_t>(x_1)),
@@ -240,24 +180,16 @@ inline int8_t interpolate( uint8_t x1, uint8_t x2,
                                static_cast<Fix16>(static_cast<int16_t>(y_2)),
                                static_cast<Fix16>(static_cast<int16_t>(y_3)),
                                static_cast<Fix16>(static_cast<int16_t>(y_4)) )
-#ifndef DEBUG
                              ));
-#else
-  return static_cast<int8_t>(static_cast<int16_t>(retval));
-#endif
 }
 
 
 template<>
-inline uint8_t interpolate( uint8_t x1, uint8_t x2,
-                            uint8_t x_1, uint8_t x_2, uint8_t x_3, uint8_t x_4,
+inline uint8_t interpolate( int8_t x1, uint8_t x2,
+                            int8_t x_1, int8_t x_2, uint8_t x_3, uint8_t x_4,
                             uint8_t y_1, uint8_t y_2, uint8_t y_3, uint8_t y_4 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return static_cast<uint8_t>(static_cast<int16_t>(
-#endif
                   interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
                                static_cast<Fix16>(static_cast<int16_t>(x2)),
                                static_cast<Fix16>(static_cast<int16_t>(x_1)),
@@ -268,24 +200,16 @@ inline uint8_t interpolate( uint8_t x1, uint8_t x2,
                                static_cast<Fix16>(static_cast<int16_t>(y_2)),
                                static_cast<Fix16>(static_cast<int16_t>(y_3)),
                                static_cast<Fix16>(static_cast<int16_t>(y_4)) )
-#ifndef DEBUG
                              ));
-#else
-  return static_cast<uint8_t>(static_cast<int16_t>(retval));
-#endif
 }
 
 
 template<>
-inline int16_t interpolate( uint8_t x1, uint8_t x2,
-                            uint8_t x_1, uint8_t x_2, uint8_t x_3, uint8_t x_4,
+inline int16_t interpolate( int8_t x1, uint8_t x2,
+                            int8_t x_1, int8_t x_2, uint8_t x_3, uint8_t x_4,
                             int16_t y_1, int16_t y_2, int16_t y_3, int16_t y_4 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return static_cast<int16_t>(
-#endif
                   interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
                                static_cast<Fix16>(static_cast<int16_t>(x2)),
                                static_cast<Fix16>(static_cast<int16_t>(x_1)),
@@ -296,24 +220,16 @@ inline int16_t interpolate( uint8_t x1, uint8_t x2,
                                static_cast<Fix16>(y_2),
                                static_cast<Fix16>(y_3),
                                static_cast<Fix16>(y_4) )
-#ifndef DEBUG
                              );
-#else
-  return static_cast<int16_t>(retval);
-#endif
 }
 
 
 template<>
-inline uint16_t interpolate( uint8_t x1, uint8_t x2,
-                            uint8_t x_1, uint8_t x_2, uint8_t x_3, uint8_t x_4,
+inline uint16_t interpolate( int8_t x1, uint8_t x2,
+                            int8_t x_1, int8_t x_2, uint8_t x_3, uint8_t x_4,
                             uint16_t y_1, uint16_t y_2, uint16_t y_3, uint16_t y_4 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return static_cast<uint16_t>(static_cast<float>(
-#endif
                   interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
                                static_cast<Fix16>(static_cast<int16_t>(x2)),
                                static_cast<Fix16>(static_cast<int16_t>(x_1)),
@@ -324,24 +240,16 @@ inline uint16_t interpolate( uint8_t x1, uint8_t x2,
                                static_cast<Fix16>(static_cast<float>(y_2)),
                                static_cast<Fix16>(static_cast<float>(y_3)),
                                static_cast<Fix16>(static_cast<float>(y_4)) )
-#ifndef DEBUG
                              ));
-#else
-  return static_cast<uint16_t>(static_cast<float>(retval));
-#endif
 }
 
 
 template<>
-inline Fix16 interpolate( uint8_t x1, uint8_t x2,
-                            uint8_t x_1, uint8_t x_2, uint8_t x_3, uint8_t x_4,
+inline Fix16 interpolate( int8_t x1, uint8_t x2,
+                            int8_t x_1, int8_t x_2, uint8_t x_3, uint8_t x_4,
                             Fix16 y_1, Fix16 y_2, Fix16 y_3, Fix16 y_4 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return 
-#endif
                   interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
                                static_cast<Fix16>(static_cast<int16_t>(x2)),
                                static_cast<Fix16>(static_cast<int16_t>(x_1)),
@@ -352,24 +260,16 @@ inline Fix16 interpolate( uint8_t x1, uint8_t x2,
                                y_2,
                                y_3,
                                y_4 )
-#ifndef DEBUG
                              ;
-#else
-  return retval;
-#endif
 }
 
 
 template<>
-inline float interpolate( uint8_t x1, uint8_t x2,
-                            uint8_t x_1, uint8_t x_2, uint8_t x_3, uint8_t x_4,
+inline float interpolate( int8_t x1, uint8_t x2,
+                            int8_t x_1, int8_t x_2, uint8_t x_3, uint8_t x_4,
                             float y_1, float y_2, float y_3, float y_4 )
 {
-#ifdef DEBUG
-  float retval = (
-#else
   return 
-#endif
                   interpolate( static_cast<float>(x1),
                                static_cast<float>(x2),
                                static_cast<float>(x_1),
@@ -380,24 +280,16 @@ inline float interpolate( uint8_t x1, uint8_t x2,
                                y_2,
                                y_3,
                                y_4 )
-#ifndef DEBUG
                              ;
-#else
-  return retval;
-#endif
 }
 
 
 template<>
-inline double interpolate( uint8_t x1, uint8_t x2,
-                            uint8_t x_1, uint8_t x_2, uint8_t x_3, uint8_t x_4,
+inline double interpolate( int8_t x1, uint8_t x2,
+                            int8_t x_1, int8_t x_2, uint8_t x_3, uint8_t x_4,
                             double y_1, double y_2, double y_3, double y_4 )
 {
-#ifdef DEBUG
-  double retval = (
-#else
   return 
-#endif
                   interpolate( static_cast<double>(x1),
                                static_cast<double>(x2),
                                static_cast<double>(x_1),
@@ -408,164 +300,116 @@ inline double interpolate( uint8_t x1, uint8_t x2,
                                y_2,
                                y_3,
                                y_4 )
-#ifndef DEBUG
                              ;
-#else
-  return retval;
-#endif
 }
 
 
 template<>
-inline int8_t interpolate( int16_t x1, int16_t x2,
-                            int16_t x_1, int16_t x_2, int16_t x_3, int16_t x_4,
+inline int8_t interpolate( int8_t x1, int16_t x2,
+                            int8_t x_1, int8_t x_2, int16_t x_3, int16_t x_4,
                             int8_t y_1, int8_t y_2, int8_t y_3, int8_t y_4 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return static_cast<int8_t>(static_cast<int16_t>(
-#endif
-                  interpolate( static_cast<Fix16>(x1),
+                  interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
                                static_cast<Fix16>(x2),
-                               static_cast<Fix16>(x_1),
-                               static_cast<Fix16>(x_2),
+                               static_cast<Fix16>(static_cast<int16_t>(x_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_2)),
                                static_cast<Fix16>(x_3),
                                static_cast<Fix16>(x_4),
                                static_cast<Fix16>(static_cast<int16_t>(y_1)),
                                static_cast<Fix16>(static_cast<int16_t>(y_2)),
                                static_cast<Fix16>(static_cast<int16_t>(y_3)),
                                static_cast<Fix16>(static_cast<int16_t>(y_4)) )
-#ifndef DEBUG
                              ));
-#else
-  return static_cast<int8_t>(static_cast<int16_t>(retval));
-#endif
 }
 
 
 template<>
-inline uint8_t interpolate( int16_t x1, int16_t x2,
-                            int16_t x_1, int16_t x_2, int16_t x_3, int16_t x_4,
+inline uint8_t interpolate( int8_t x1, int16_t x2,
+                            int8_t x_1, int8_t x_2, int16_t x_3, int16_t x_4,
                             uint8_t y_1, uint8_t y_2, uint8_t y_3, uint8_t y_4 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return static_cast<uint8_t>(static_cast<int16_t>(
-#endif
-                  interpolate( static_cast<Fix16>(x1),
+                  interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
                                static_cast<Fix16>(x2),
-                               static_cast<Fix16>(x_1),
-                               static_cast<Fix16>(x_2),
+                               static_cast<Fix16>(static_cast<int16_t>(x_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_2)),
                                static_cast<Fix16>(x_3),
                                static_cast<Fix16>(x_4),
                                static_cast<Fix16>(static_cast<int16_t>(y_1)),
                                static_cast<Fix16>(static_cast<int16_t>(y_2)),
                                static_cast<Fix16>(static_cast<int16_t>(y_3)),
                                static_cast<Fix16>(static_cast<int16_t>(y_4)) )
-#ifndef DEBUG
                              ));
-#else
-  return static_cast<uint8_t>(static_cast<int16_t>(retval));
-#endif
 }
 
 
 template<>
-inline int16_t interpolate( int16_t x1, int16_t x2,
-                            int16_t x_1, int16_t x_2, int16_t x_3, int16_t x_4,
+inline int16_t interpolate( int8_t x1, int16_t x2,
+                            int8_t x_1, int8_t x_2, int16_t x_3, int16_t x_4,
                             int16_t y_1, int16_t y_2, int16_t y_3, int16_t y_4 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return static_cast<int16_t>(
-#endif
-                  interpolate( static_cast<Fix16>(x1),
+                  interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
                                static_cast<Fix16>(x2),
-                               static_cast<Fix16>(x_1),
-                               static_cast<Fix16>(x_2),
+                               static_cast<Fix16>(static_cast<int16_t>(x_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_2)),
                                static_cast<Fix16>(x_3),
                                static_cast<Fix16>(x_4),
                                static_cast<Fix16>(y_1),
                                static_cast<Fix16>(y_2),
                                static_cast<Fix16>(y_3),
                                static_cast<Fix16>(y_4) )
-#ifndef DEBUG
                              );
-#else
-  return static_cast<int16_t>(retval);
-#endif
 }
 
 
 template<>
-inline uint16_t interpolate( int16_t x1, int16_t x2,
-                            int16_t x_1, int16_t x_2, int16_t x_3, int16_t x_4,
+inline uint16_t interpolate( int8_t x1, int16_t x2,
+                            int8_t x_1, int8_t x_2, int16_t x_3, int16_t x_4,
                             uint16_t y_1, uint16_t y_2, uint16_t y_3, uint16_t y_4 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return static_cast<uint16_t>(static_cast<float>(
-#endif
-                  interpolate( static_cast<Fix16>(x1),
+                  interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
                                static_cast<Fix16>(x2),
-                               static_cast<Fix16>(x_1),
-                               static_cast<Fix16>(x_2),
+                               static_cast<Fix16>(static_cast<int16_t>(x_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_2)),
                                static_cast<Fix16>(x_3),
                                static_cast<Fix16>(x_4),
                                static_cast<Fix16>(static_cast<float>(y_1)),
                                static_cast<Fix16>(static_cast<float>(y_2)),
                                static_cast<Fix16>(static_cast<float>(y_3)),
                                static_cast<Fix16>(static_cast<float>(y_4)) )
-#ifndef DEBUG
                              ));
-#else
-  return static_cast<uint16_t>(static_cast<float>(retval));
-#endif
 }
 
 
 template<>
-inline Fix16 interpolate( int16_t x1, int16_t x2,
-                            int16_t x_1, int16_t x_2, int16_t x_3, int16_t x_4,
+inline Fix16 interpolate( int8_t x1, int16_t x2,
+                            int8_t x_1, int8_t x_2, int16_t x_3, int16_t x_4,
                             Fix16 y_1, Fix16 y_2, Fix16 y_3, Fix16 y_4 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return 
-#endif
-                  interpolate( static_cast<Fix16>(x1),
+                  interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
                                static_cast<Fix16>(x2),
-                               static_cast<Fix16>(x_1),
-                               static_cast<Fix16>(x_2),
+                               static_cast<Fix16>(static_cast<int16_t>(x_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_2)),
                                static_cast<Fix16>(x_3),
                                static_cast<Fix16>(x_4),
                                y_1,
                                y_2,
                                y_3,
                                y_4 )
-#ifndef DEBUG
                              ;
-#else
-  return retval;
-#endif
 }
 
 
 template<>
-inline float interpolate( int16_t x1, int16_t x2,
-                            int16_t x_1, int16_t x_2, int16_t x_3, int16_t x_4,
+inline float interpolate( int8_t x1, int16_t x2,
+                            int8_t x_1, int8_t x_2, int16_t x_3, int16_t x_4,
                             float y_1, float y_2, float y_3, float y_4 )
 {
-#ifdef DEBUG
-  float retval = (
-#else
   return 
-#endif
                   interpolate( static_cast<float>(x1),
                                static_cast<float>(x2),
                                static_cast<float>(x_1),
@@ -576,24 +420,16 @@ inline float interpolate( int16_t x1, int16_t x2,
                                y_2,
                                y_3,
                                y_4 )
-#ifndef DEBUG
                              ;
-#else
-  return retval;
-#endif
 }
 
 
 template<>
-inline double interpolate( int16_t x1, int16_t x2,
-                            int16_t x_1, int16_t x_2, int16_t x_3, int16_t x_4,
+inline double interpolate( int8_t x1, int16_t x2,
+                            int8_t x_1, int8_t x_2, int16_t x_3, int16_t x_4,
                             double y_1, double y_2, double y_3, double y_4 )
 {
-#ifdef DEBUG
-  double retval = (
-#else
   return 
-#endif
                   interpolate( static_cast<double>(x1),
                                static_cast<double>(x2),
                                static_cast<double>(x_1),
@@ -604,164 +440,116 @@ inline double interpolate( int16_t x1, int16_t x2,
                                y_2,
                                y_3,
                                y_4 )
-#ifndef DEBUG
                              ;
-#else
-  return retval;
-#endif
 }
 
 
 template<>
-inline int8_t interpolate( uint16_t x1, uint16_t x2,
-                            uint16_t x_1, uint16_t x_2, uint16_t x_3, uint16_t x_4,
+inline int8_t interpolate( int8_t x1, uint16_t x2,
+                            int8_t x_1, int8_t x_2, uint16_t x_3, uint16_t x_4,
                             int8_t y_1, int8_t y_2, int8_t y_3, int8_t y_4 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return static_cast<int8_t>(static_cast<int16_t>(
-#endif
-                  interpolate( static_cast<Fix16>(static_cast<float>(x1)),
+                  interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
                                static_cast<Fix16>(static_cast<float>(x2)),
-                               static_cast<Fix16>(static_cast<float>(x_1)),
-                               static_cast<Fix16>(static_cast<float>(x_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_2)),
                                static_cast<Fix16>(static_cast<float>(x_3)),
                                static_cast<Fix16>(static_cast<float>(x_4)),
                                static_cast<Fix16>(static_cast<int16_t>(y_1)),
                                static_cast<Fix16>(static_cast<int16_t>(y_2)),
                                static_cast<Fix16>(static_cast<int16_t>(y_3)),
                                static_cast<Fix16>(static_cast<int16_t>(y_4)) )
-#ifndef DEBUG
                              ));
-#else
-  return static_cast<int8_t>(static_cast<int16_t>(retval));
-#endif
 }
 
 
 template<>
-inline uint8_t interpolate( uint16_t x1, uint16_t x2,
-                            uint16_t x_1, uint16_t x_2, uint16_t x_3, uint16_t x_4,
+inline uint8_t interpolate( int8_t x1, uint16_t x2,
+                            int8_t x_1, int8_t x_2, uint16_t x_3, uint16_t x_4,
                             uint8_t y_1, uint8_t y_2, uint8_t y_3, uint8_t y_4 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return static_cast<uint8_t>(static_cast<int16_t>(
-#endif
-                  interpolate( static_cast<Fix16>(static_cast<float>(x1)),
+                  interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
                                static_cast<Fix16>(static_cast<float>(x2)),
-                               static_cast<Fix16>(static_cast<float>(x_1)),
-                               static_cast<Fix16>(static_cast<float>(x_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_2)),
                                static_cast<Fix16>(static_cast<float>(x_3)),
                                static_cast<Fix16>(static_cast<float>(x_4)),
                                static_cast<Fix16>(static_cast<int16_t>(y_1)),
                                static_cast<Fix16>(static_cast<int16_t>(y_2)),
                                static_cast<Fix16>(static_cast<int16_t>(y_3)),
                                static_cast<Fix16>(static_cast<int16_t>(y_4)) )
-#ifndef DEBUG
                              ));
-#else
-  return static_cast<uint8_t>(static_cast<int16_t>(retval));
-#endif
 }
 
 
 template<>
-inline int16_t interpolate( uint16_t x1, uint16_t x2,
-                            uint16_t x_1, uint16_t x_2, uint16_t x_3, uint16_t x_4,
+inline int16_t interpolate( int8_t x1, uint16_t x2,
+                            int8_t x_1, int8_t x_2, uint16_t x_3, uint16_t x_4,
                             int16_t y_1, int16_t y_2, int16_t y_3, int16_t y_4 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return static_cast<int16_t>(
-#endif
-                  interpolate( static_cast<Fix16>(static_cast<float>(x1)),
+                  interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
                                static_cast<Fix16>(static_cast<float>(x2)),
-                               static_cast<Fix16>(static_cast<float>(x_1)),
-                               static_cast<Fix16>(static_cast<float>(x_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_2)),
                                static_cast<Fix16>(static_cast<float>(x_3)),
                                static_cast<Fix16>(static_cast<float>(x_4)),
                                static_cast<Fix16>(y_1),
                                static_cast<Fix16>(y_2),
                                static_cast<Fix16>(y_3),
                                static_cast<Fix16>(y_4) )
-#ifndef DEBUG
                              );
-#else
-  return static_cast<int16_t>(retval);
-#endif
 }
 
 
 template<>
-inline uint16_t interpolate( uint16_t x1, uint16_t x2,
-                            uint16_t x_1, uint16_t x_2, uint16_t x_3, uint16_t x_4,
+inline uint16_t interpolate( int8_t x1, uint16_t x2,
+                            int8_t x_1, int8_t x_2, uint16_t x_3, uint16_t x_4,
                             uint16_t y_1, uint16_t y_2, uint16_t y_3, uint16_t y_4 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return static_cast<uint16_t>(static_cast<float>(
-#endif
-                  interpolate( static_cast<Fix16>(static_cast<float>(x1)),
+                  interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
                                static_cast<Fix16>(static_cast<float>(x2)),
-                               static_cast<Fix16>(static_cast<float>(x_1)),
-                               static_cast<Fix16>(static_cast<float>(x_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_2)),
                                static_cast<Fix16>(static_cast<float>(x_3)),
                                static_cast<Fix16>(static_cast<float>(x_4)),
                                static_cast<Fix16>(static_cast<float>(y_1)),
                                static_cast<Fix16>(static_cast<float>(y_2)),
                                static_cast<Fix16>(static_cast<float>(y_3)),
                                static_cast<Fix16>(static_cast<float>(y_4)) )
-#ifndef DEBUG
                              ));
-#else
-  return static_cast<uint16_t>(static_cast<float>(retval));
-#endif
 }
 
 
 template<>
-inline Fix16 interpolate( uint16_t x1, uint16_t x2,
-                            uint16_t x_1, uint16_t x_2, uint16_t x_3, uint16_t x_4,
+inline Fix16 interpolate( int8_t x1, uint16_t x2,
+                            int8_t x_1, int8_t x_2, uint16_t x_3, uint16_t x_4,
                             Fix16 y_1, Fix16 y_2, Fix16 y_3, Fix16 y_4 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return 
-#endif
-                  interpolate( static_cast<Fix16>(static_cast<float>(x1)),
+                  interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
                                static_cast<Fix16>(static_cast<float>(x2)),
-                               static_cast<Fix16>(static_cast<float>(x_1)),
-                               static_cast<Fix16>(static_cast<float>(x_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_2)),
                                static_cast<Fix16>(static_cast<float>(x_3)),
                                static_cast<Fix16>(static_cast<float>(x_4)),
                                y_1,
                                y_2,
                                y_3,
                                y_4 )
-#ifndef DEBUG
                              ;
-#else
-  return retval;
-#endif
 }
 
 
 template<>
-inline float interpolate( uint16_t x1, uint16_t x2,
-                            uint16_t x_1, uint16_t x_2, uint16_t x_3, uint16_t x_4,
+inline float interpolate( int8_t x1, uint16_t x2,
+                            int8_t x_1, int8_t x_2, uint16_t x_3, uint16_t x_4,
                             float y_1, float y_2, float y_3, float y_4 )
 {
-#ifdef DEBUG
-  float retval = (
-#else
   return 
-#endif
                   interpolate( static_cast<float>(x1),
                                static_cast<float>(x2),
                                static_cast<float>(x_1),
@@ -772,24 +560,16 @@ inline float interpolate( uint16_t x1, uint16_t x2,
                                y_2,
                                y_3,
                                y_4 )
-#ifndef DEBUG
                              ;
-#else
-  return retval;
-#endif
 }
 
 
 template<>
-inline double interpolate( uint16_t x1, uint16_t x2,
-                            uint16_t x_1, uint16_t x_2, uint16_t x_3, uint16_t x_4,
+inline double interpolate( int8_t x1, uint16_t x2,
+                            int8_t x_1, int8_t x_2, uint16_t x_3, uint16_t x_4,
                             double y_1, double y_2, double y_3, double y_4 )
 {
-#ifdef DEBUG
-  double retval = (
-#else
   return 
-#endif
                   interpolate( static_cast<double>(x1),
                                static_cast<double>(x2),
                                static_cast<double>(x_1),
@@ -800,123 +580,2887 @@ inline double interpolate( uint16_t x1, uint16_t x2,
                                y_2,
                                y_3,
                                y_4 )
-#ifndef DEBUG
                              ;
-#else
-  return retval;
-#endif
 }
 
 
 template<>
-inline int8_t interpolate( Fix16 x1, Fix16 x2,
-                            Fix16 x_1, Fix16 x_2, Fix16 x_3, Fix16 x_4,
+inline int8_t interpolate( int8_t x1, Fix16 x2,
+                            int8_t x_1, int8_t x_2, Fix16 x_3, Fix16 x_4,
                             int8_t y_1, int8_t y_2, int8_t y_3, int8_t y_4 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return static_cast<int8_t>(static_cast<int16_t>(
-#endif
-                  interpolate( x1,
+                  interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
                                x2,
-                               x_1,
-                               x_2,
+                               static_cast<Fix16>(static_cast<int16_t>(x_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_2)),
                                x_3,
                                x_4,
                                static_cast<Fix16>(static_cast<int16_t>(y_1)),
                                static_cast<Fix16>(static_cast<int16_t>(y_2)),
                                static_cast<Fix16>(static_cast<int16_t>(y_3)),
                                static_cast<Fix16>(static_cast<int16_t>(y_4)) )
-#ifndef DEBUG
                              ));
-#else
-  return static_cast<int8_t>(static_cast<int16_t>(retval));
-#endif
 }
 
 
 template<>
-inline uint8_t interpolate( Fix16 x1, Fix16 x2,
-                            Fix16 x_1, Fix16 x_2, Fix16 x_3, Fix16 x_4,
+inline uint8_t interpolate( int8_t x1, Fix16 x2,
+                            int8_t x_1, int8_t x_2, Fix16 x_3, Fix16 x_4,
                             uint8_t y_1, uint8_t y_2, uint8_t y_3, uint8_t y_4 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return static_cast<uint8_t>(static_cast<int16_t>(
-#endif
-                  interpolate( x1,
+                  interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
                                x2,
-                               x_1,
-                               x_2,
+                               static_cast<Fix16>(static_cast<int16_t>(x_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_2)),
                                x_3,
                                x_4,
                                static_cast<Fix16>(static_cast<int16_t>(y_1)),
                                static_cast<Fix16>(static_cast<int16_t>(y_2)),
                                static_cast<Fix16>(static_cast<int16_t>(y_3)),
                                static_cast<Fix16>(static_cast<int16_t>(y_4)) )
-#ifndef DEBUG
                              ));
-#else
-  return static_cast<uint8_t>(static_cast<int16_t>(retval));
-#endif
 }
 
 
 template<>
-inline int16_t interpolate( Fix16 x1, Fix16 x2,
-                            Fix16 x_1, Fix16 x_2, Fix16 x_3, Fix16 x_4,
+inline int16_t interpolate( int8_t x1, Fix16 x2,
+                            int8_t x_1, int8_t x_2, Fix16 x_3, Fix16 x_4,
                             int16_t y_1, int16_t y_2, int16_t y_3, int16_t y_4 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return static_cast<int16_t>(
-#endif
-                  interpolate( x1,
+                  interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
                                x2,
-                               x_1,
-                               x_2,
+                               static_cast<Fix16>(static_cast<int16_t>(x_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_2)),
                                x_3,
                                x_4,
                                static_cast<Fix16>(y_1),
                                static_cast<Fix16>(y_2),
                                static_cast<Fix16>(y_3),
                                static_cast<Fix16>(y_4) )
-#ifndef DEBUG
                              );
-#else
-  return static_cast<int16_t>(retval);
-#endif
 }
 
 
 template<>
-inline uint16_t interpolate( Fix16 x1, Fix16 x2,
-                            Fix16 x_1, Fix16 x_2, Fix16 x_3, Fix16 x_4,
+inline uint16_t interpolate( int8_t x1, Fix16 x2,
+                            int8_t x_1, int8_t x_2, Fix16 x_3, Fix16 x_4,
                             uint16_t y_1, uint16_t y_2, uint16_t y_3, uint16_t y_4 )
 {
-#ifdef DEBUG
-  Fix16 retval = (
-#else
   return static_cast<uint16_t>(static_cast<float>(
-#endif
-                  interpolate( x1,
+                  interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
                                x2,
-                               x_1,
-                               x_2,
+                               static_cast<Fix16>(static_cast<int16_t>(x_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_2)),
+                               x_3,
+                               x_4,
+                               static_cast<Fix16>(static_cast<float>(y_1)),
+                               static_cast<Fix16>(static_cast<float>(y_2)),
+                               static_cast<Fix16>(static_cast<float>(y_3)),
+                               static_cast<Fix16>(static_cast<float>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline Fix16 interpolate( int8_t x1, Fix16 x2,
+                            int8_t x_1, int8_t x_2, Fix16 x_3, Fix16 x_4,
+                            Fix16 y_1, Fix16 y_2, Fix16 y_3, Fix16 y_4 )
+{
+  return 
+                  interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
+                               x2,
+                               static_cast<Fix16>(static_cast<int16_t>(x_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_2)),
+                               x_3,
+                               x_4,
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline float interpolate( int8_t x1, Fix16 x2,
+                            int8_t x_1, int8_t x_2, Fix16 x_3, Fix16 x_4,
+                            float y_1, float y_2, float y_3, float y_4 )
+{
+  return 
+                  interpolate( static_cast<float>(x1),
+                               static_cast<float>(x2),
+                               static_cast<float>(x_1),
+                               static_cast<float>(x_2),
+                               static_cast<float>(x_3),
+                               static_cast<float>(x_4),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline double interpolate( int8_t x1, Fix16 x2,
+                            int8_t x_1, int8_t x_2, Fix16 x_3, Fix16 x_4,
+                            double y_1, double y_2, double y_3, double y_4 )
+{
+  return 
+                  interpolate( static_cast<double>(x1),
+                               static_cast<double>(x2),
+                               static_cast<double>(x_1),
+                               static_cast<double>(x_2),
+                               static_cast<double>(x_3),
+                               static_cast<double>(x_4),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline int8_t interpolate( uint8_t x1, int8_t x2,
+                            uint8_t x_1, uint8_t x_2, int8_t x_3, int8_t x_4,
+                            int8_t y_1, int8_t y_2, int8_t y_3, int8_t y_4 )
+{
+  return static_cast<int8_t>(static_cast<int16_t>(
+                  interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x2)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_4)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline uint8_t interpolate( uint8_t x1, int8_t x2,
+                            uint8_t x_1, uint8_t x_2, int8_t x_3, int8_t x_4,
+                            uint8_t y_1, uint8_t y_2, uint8_t y_3, uint8_t y_4 )
+{
+  return static_cast<uint8_t>(static_cast<int16_t>(
+                  interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x2)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_4)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline int16_t interpolate( uint8_t x1, int8_t x2,
+                            uint8_t x_1, uint8_t x_2, int8_t x_3, int8_t x_4,
+                            int16_t y_1, int16_t y_2, int16_t y_3, int16_t y_4 )
+{
+  return static_cast<int16_t>(
+                  interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x2)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_4)),
+                               static_cast<Fix16>(y_1),
+                               static_cast<Fix16>(y_2),
+                               static_cast<Fix16>(y_3),
+                               static_cast<Fix16>(y_4) )
+                             );
+}
+
+
+template<>
+inline uint16_t interpolate( uint8_t x1, int8_t x2,
+                            uint8_t x_1, uint8_t x_2, int8_t x_3, int8_t x_4,
+                            uint16_t y_1, uint16_t y_2, uint16_t y_3, uint16_t y_4 )
+{
+  return static_cast<uint16_t>(static_cast<float>(
+                  interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x2)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_4)),
+                               static_cast<Fix16>(static_cast<float>(y_1)),
+                               static_cast<Fix16>(static_cast<float>(y_2)),
+                               static_cast<Fix16>(static_cast<float>(y_3)),
+                               static_cast<Fix16>(static_cast<float>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline Fix16 interpolate( uint8_t x1, int8_t x2,
+                            uint8_t x_1, uint8_t x_2, int8_t x_3, int8_t x_4,
+                            Fix16 y_1, Fix16 y_2, Fix16 y_3, Fix16 y_4 )
+{
+  return 
+                  interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x2)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_4)),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline float interpolate( uint8_t x1, int8_t x2,
+                            uint8_t x_1, uint8_t x_2, int8_t x_3, int8_t x_4,
+                            float y_1, float y_2, float y_3, float y_4 )
+{
+  return 
+                  interpolate( static_cast<float>(x1),
+                               static_cast<float>(x2),
+                               static_cast<float>(x_1),
+                               static_cast<float>(x_2),
+                               static_cast<float>(x_3),
+                               static_cast<float>(x_4),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline double interpolate( uint8_t x1, int8_t x2,
+                            uint8_t x_1, uint8_t x_2, int8_t x_3, int8_t x_4,
+                            double y_1, double y_2, double y_3, double y_4 )
+{
+  return 
+                  interpolate( static_cast<double>(x1),
+                               static_cast<double>(x2),
+                               static_cast<double>(x_1),
+                               static_cast<double>(x_2),
+                               static_cast<double>(x_3),
+                               static_cast<double>(x_4),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline int8_t interpolate( uint8_t x1, uint8_t x2,
+                            uint8_t x_1, uint8_t x_2, uint8_t x_3, uint8_t x_4,
+                            int8_t y_1, int8_t y_2, int8_t y_3, int8_t y_4 )
+{
+  return static_cast<int8_t>(static_cast<int16_t>(
+                  interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x2)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_4)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline uint8_t interpolate( uint8_t x1, uint8_t x2,
+                            uint8_t x_1, uint8_t x_2, uint8_t x_3, uint8_t x_4,
+                            uint8_t y_1, uint8_t y_2, uint8_t y_3, uint8_t y_4 )
+{
+  return static_cast<uint8_t>(static_cast<int16_t>(
+                  interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x2)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_4)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline int16_t interpolate( uint8_t x1, uint8_t x2,
+                            uint8_t x_1, uint8_t x_2, uint8_t x_3, uint8_t x_4,
+                            int16_t y_1, int16_t y_2, int16_t y_3, int16_t y_4 )
+{
+  return static_cast<int16_t>(
+                  interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x2)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_4)),
+                               static_cast<Fix16>(y_1),
+                               static_cast<Fix16>(y_2),
+                               static_cast<Fix16>(y_3),
+                               static_cast<Fix16>(y_4) )
+                             );
+}
+
+
+template<>
+inline uint16_t interpolate( uint8_t x1, uint8_t x2,
+                            uint8_t x_1, uint8_t x_2, uint8_t x_3, uint8_t x_4,
+                            uint16_t y_1, uint16_t y_2, uint16_t y_3, uint16_t y_4 )
+{
+  return static_cast<uint16_t>(static_cast<float>(
+                  interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x2)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_4)),
+                               static_cast<Fix16>(static_cast<float>(y_1)),
+                               static_cast<Fix16>(static_cast<float>(y_2)),
+                               static_cast<Fix16>(static_cast<float>(y_3)),
+                               static_cast<Fix16>(static_cast<float>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline Fix16 interpolate( uint8_t x1, uint8_t x2,
+                            uint8_t x_1, uint8_t x_2, uint8_t x_3, uint8_t x_4,
+                            Fix16 y_1, Fix16 y_2, Fix16 y_3, Fix16 y_4 )
+{
+  return 
+                  interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x2)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_4)),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline float interpolate( uint8_t x1, uint8_t x2,
+                            uint8_t x_1, uint8_t x_2, uint8_t x_3, uint8_t x_4,
+                            float y_1, float y_2, float y_3, float y_4 )
+{
+  return 
+                  interpolate( static_cast<float>(x1),
+                               static_cast<float>(x2),
+                               static_cast<float>(x_1),
+                               static_cast<float>(x_2),
+                               static_cast<float>(x_3),
+                               static_cast<float>(x_4),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline double interpolate( uint8_t x1, uint8_t x2,
+                            uint8_t x_1, uint8_t x_2, uint8_t x_3, uint8_t x_4,
+                            double y_1, double y_2, double y_3, double y_4 )
+{
+  return 
+                  interpolate( static_cast<double>(x1),
+                               static_cast<double>(x2),
+                               static_cast<double>(x_1),
+                               static_cast<double>(x_2),
+                               static_cast<double>(x_3),
+                               static_cast<double>(x_4),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline int8_t interpolate( uint8_t x1, int16_t x2,
+                            uint8_t x_1, uint8_t x_2, int16_t x_3, int16_t x_4,
+                            int8_t y_1, int8_t y_2, int8_t y_3, int8_t y_4 )
+{
+  return static_cast<int8_t>(static_cast<int16_t>(
+                  interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
+                               static_cast<Fix16>(x2),
+                               static_cast<Fix16>(static_cast<int16_t>(x_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_2)),
+                               static_cast<Fix16>(x_3),
+                               static_cast<Fix16>(x_4),
+                               static_cast<Fix16>(static_cast<int16_t>(y_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline uint8_t interpolate( uint8_t x1, int16_t x2,
+                            uint8_t x_1, uint8_t x_2, int16_t x_3, int16_t x_4,
+                            uint8_t y_1, uint8_t y_2, uint8_t y_3, uint8_t y_4 )
+{
+  return static_cast<uint8_t>(static_cast<int16_t>(
+                  interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
+                               static_cast<Fix16>(x2),
+                               static_cast<Fix16>(static_cast<int16_t>(x_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_2)),
+                               static_cast<Fix16>(x_3),
+                               static_cast<Fix16>(x_4),
+                               static_cast<Fix16>(static_cast<int16_t>(y_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline int16_t interpolate( uint8_t x1, int16_t x2,
+                            uint8_t x_1, uint8_t x_2, int16_t x_3, int16_t x_4,
+                            int16_t y_1, int16_t y_2, int16_t y_3, int16_t y_4 )
+{
+  return static_cast<int16_t>(
+                  interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
+                               static_cast<Fix16>(x2),
+                               static_cast<Fix16>(static_cast<int16_t>(x_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_2)),
+                               static_cast<Fix16>(x_3),
+                               static_cast<Fix16>(x_4),
+                               static_cast<Fix16>(y_1),
+                               static_cast<Fix16>(y_2),
+                               static_cast<Fix16>(y_3),
+                               static_cast<Fix16>(y_4) )
+                             );
+}
+
+
+template<>
+inline uint16_t interpolate( uint8_t x1, int16_t x2,
+                            uint8_t x_1, uint8_t x_2, int16_t x_3, int16_t x_4,
+                            uint16_t y_1, uint16_t y_2, uint16_t y_3, uint16_t y_4 )
+{
+  return static_cast<uint16_t>(static_cast<float>(
+                  interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
+                               static_cast<Fix16>(x2),
+                               static_cast<Fix16>(static_cast<int16_t>(x_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_2)),
+                               static_cast<Fix16>(x_3),
+                               static_cast<Fix16>(x_4),
+                               static_cast<Fix16>(static_cast<float>(y_1)),
+                               static_cast<Fix16>(static_cast<float>(y_2)),
+                               static_cast<Fix16>(static_cast<float>(y_3)),
+                               static_cast<Fix16>(static_cast<float>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline Fix16 interpolate( uint8_t x1, int16_t x2,
+                            uint8_t x_1, uint8_t x_2, int16_t x_3, int16_t x_4,
+                            Fix16 y_1, Fix16 y_2, Fix16 y_3, Fix16 y_4 )
+{
+  return 
+                  interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
+                               static_cast<Fix16>(x2),
+                               static_cast<Fix16>(static_cast<int16_t>(x_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_2)),
+                               static_cast<Fix16>(x_3),
+                               static_cast<Fix16>(x_4),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline float interpolate( uint8_t x1, int16_t x2,
+                            uint8_t x_1, uint8_t x_2, int16_t x_3, int16_t x_4,
+                            float y_1, float y_2, float y_3, float y_4 )
+{
+  return 
+                  interpolate( static_cast<float>(x1),
+                               static_cast<float>(x2),
+                               static_cast<float>(x_1),
+                               static_cast<float>(x_2),
+                               static_cast<float>(x_3),
+                               static_cast<float>(x_4),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline double interpolate( uint8_t x1, int16_t x2,
+                            uint8_t x_1, uint8_t x_2, int16_t x_3, int16_t x_4,
+                            double y_1, double y_2, double y_3, double y_4 )
+{
+  return 
+                  interpolate( static_cast<double>(x1),
+                               static_cast<double>(x2),
+                               static_cast<double>(x_1),
+                               static_cast<double>(x_2),
+                               static_cast<double>(x_3),
+                               static_cast<double>(x_4),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline int8_t interpolate( uint8_t x1, uint16_t x2,
+                            uint8_t x_1, uint8_t x_2, uint16_t x_3, uint16_t x_4,
+                            int8_t y_1, int8_t y_2, int8_t y_3, int8_t y_4 )
+{
+  return static_cast<int8_t>(static_cast<int16_t>(
+                  interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
+                               static_cast<Fix16>(static_cast<float>(x2)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_2)),
+                               static_cast<Fix16>(static_cast<float>(x_3)),
+                               static_cast<Fix16>(static_cast<float>(x_4)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline uint8_t interpolate( uint8_t x1, uint16_t x2,
+                            uint8_t x_1, uint8_t x_2, uint16_t x_3, uint16_t x_4,
+                            uint8_t y_1, uint8_t y_2, uint8_t y_3, uint8_t y_4 )
+{
+  return static_cast<uint8_t>(static_cast<int16_t>(
+                  interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
+                               static_cast<Fix16>(static_cast<float>(x2)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_2)),
+                               static_cast<Fix16>(static_cast<float>(x_3)),
+                               static_cast<Fix16>(static_cast<float>(x_4)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline int16_t interpolate( uint8_t x1, uint16_t x2,
+                            uint8_t x_1, uint8_t x_2, uint16_t x_3, uint16_t x_4,
+                            int16_t y_1, int16_t y_2, int16_t y_3, int16_t y_4 )
+{
+  return static_cast<int16_t>(
+                  interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
+                               static_cast<Fix16>(static_cast<float>(x2)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_2)),
+                               static_cast<Fix16>(static_cast<float>(x_3)),
+                               static_cast<Fix16>(static_cast<float>(x_4)),
+                               static_cast<Fix16>(y_1),
+                               static_cast<Fix16>(y_2),
+                               static_cast<Fix16>(y_3),
+                               static_cast<Fix16>(y_4) )
+                             );
+}
+
+
+template<>
+inline uint16_t interpolate( uint8_t x1, uint16_t x2,
+                            uint8_t x_1, uint8_t x_2, uint16_t x_3, uint16_t x_4,
+                            uint16_t y_1, uint16_t y_2, uint16_t y_3, uint16_t y_4 )
+{
+  return static_cast<uint16_t>(static_cast<float>(
+                  interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
+                               static_cast<Fix16>(static_cast<float>(x2)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_2)),
+                               static_cast<Fix16>(static_cast<float>(x_3)),
+                               static_cast<Fix16>(static_cast<float>(x_4)),
+                               static_cast<Fix16>(static_cast<float>(y_1)),
+                               static_cast<Fix16>(static_cast<float>(y_2)),
+                               static_cast<Fix16>(static_cast<float>(y_3)),
+                               static_cast<Fix16>(static_cast<float>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline Fix16 interpolate( uint8_t x1, uint16_t x2,
+                            uint8_t x_1, uint8_t x_2, uint16_t x_3, uint16_t x_4,
+                            Fix16 y_1, Fix16 y_2, Fix16 y_3, Fix16 y_4 )
+{
+  return 
+                  interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
+                               static_cast<Fix16>(static_cast<float>(x2)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_2)),
+                               static_cast<Fix16>(static_cast<float>(x_3)),
+                               static_cast<Fix16>(static_cast<float>(x_4)),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline float interpolate( uint8_t x1, uint16_t x2,
+                            uint8_t x_1, uint8_t x_2, uint16_t x_3, uint16_t x_4,
+                            float y_1, float y_2, float y_3, float y_4 )
+{
+  return 
+                  interpolate( static_cast<float>(x1),
+                               static_cast<float>(x2),
+                               static_cast<float>(x_1),
+                               static_cast<float>(x_2),
+                               static_cast<float>(x_3),
+                               static_cast<float>(x_4),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline double interpolate( uint8_t x1, uint16_t x2,
+                            uint8_t x_1, uint8_t x_2, uint16_t x_3, uint16_t x_4,
+                            double y_1, double y_2, double y_3, double y_4 )
+{
+  return 
+                  interpolate( static_cast<double>(x1),
+                               static_cast<double>(x2),
+                               static_cast<double>(x_1),
+                               static_cast<double>(x_2),
+                               static_cast<double>(x_3),
+                               static_cast<double>(x_4),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline int8_t interpolate( uint8_t x1, Fix16 x2,
+                            uint8_t x_1, uint8_t x_2, Fix16 x_3, Fix16 x_4,
+                            int8_t y_1, int8_t y_2, int8_t y_3, int8_t y_4 )
+{
+  return static_cast<int8_t>(static_cast<int16_t>(
+                  interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
+                               x2,
+                               static_cast<Fix16>(static_cast<int16_t>(x_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_2)),
+                               x_3,
+                               x_4,
+                               static_cast<Fix16>(static_cast<int16_t>(y_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline uint8_t interpolate( uint8_t x1, Fix16 x2,
+                            uint8_t x_1, uint8_t x_2, Fix16 x_3, Fix16 x_4,
+                            uint8_t y_1, uint8_t y_2, uint8_t y_3, uint8_t y_4 )
+{
+  return static_cast<uint8_t>(static_cast<int16_t>(
+                  interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
+                               x2,
+                               static_cast<Fix16>(static_cast<int16_t>(x_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_2)),
+                               x_3,
+                               x_4,
+                               static_cast<Fix16>(static_cast<int16_t>(y_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline int16_t interpolate( uint8_t x1, Fix16 x2,
+                            uint8_t x_1, uint8_t x_2, Fix16 x_3, Fix16 x_4,
+                            int16_t y_1, int16_t y_2, int16_t y_3, int16_t y_4 )
+{
+  return static_cast<int16_t>(
+                  interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
+                               x2,
+                               static_cast<Fix16>(static_cast<int16_t>(x_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_2)),
+                               x_3,
+                               x_4,
+                               static_cast<Fix16>(y_1),
+                               static_cast<Fix16>(y_2),
+                               static_cast<Fix16>(y_3),
+                               static_cast<Fix16>(y_4) )
+                             );
+}
+
+
+template<>
+inline uint16_t interpolate( uint8_t x1, Fix16 x2,
+                            uint8_t x_1, uint8_t x_2, Fix16 x_3, Fix16 x_4,
+                            uint16_t y_1, uint16_t y_2, uint16_t y_3, uint16_t y_4 )
+{
+  return static_cast<uint16_t>(static_cast<float>(
+                  interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
+                               x2,
+                               static_cast<Fix16>(static_cast<int16_t>(x_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_2)),
+                               x_3,
+                               x_4,
+                               static_cast<Fix16>(static_cast<float>(y_1)),
+                               static_cast<Fix16>(static_cast<float>(y_2)),
+                               static_cast<Fix16>(static_cast<float>(y_3)),
+                               static_cast<Fix16>(static_cast<float>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline Fix16 interpolate( uint8_t x1, Fix16 x2,
+                            uint8_t x_1, uint8_t x_2, Fix16 x_3, Fix16 x_4,
+                            Fix16 y_1, Fix16 y_2, Fix16 y_3, Fix16 y_4 )
+{
+  return 
+                  interpolate( static_cast<Fix16>(static_cast<int16_t>(x1)),
+                               x2,
+                               static_cast<Fix16>(static_cast<int16_t>(x_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_2)),
+                               x_3,
+                               x_4,
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline float interpolate( uint8_t x1, Fix16 x2,
+                            uint8_t x_1, uint8_t x_2, Fix16 x_3, Fix16 x_4,
+                            float y_1, float y_2, float y_3, float y_4 )
+{
+  return 
+                  interpolate( static_cast<float>(x1),
+                               static_cast<float>(x2),
+                               static_cast<float>(x_1),
+                               static_cast<float>(x_2),
+                               static_cast<float>(x_3),
+                               static_cast<float>(x_4),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline double interpolate( uint8_t x1, Fix16 x2,
+                            uint8_t x_1, uint8_t x_2, Fix16 x_3, Fix16 x_4,
+                            double y_1, double y_2, double y_3, double y_4 )
+{
+  return 
+                  interpolate( static_cast<double>(x1),
+                               static_cast<double>(x2),
+                               static_cast<double>(x_1),
+                               static_cast<double>(x_2),
+                               static_cast<double>(x_3),
+                               static_cast<double>(x_4),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline int8_t interpolate( int16_t x1, int8_t x2,
+                            int16_t x_1, int16_t x_2, int8_t x_3, int8_t x_4,
+                            int8_t y_1, int8_t y_2, int8_t y_3, int8_t y_4 )
+{
+  return static_cast<int8_t>(static_cast<int16_t>(
+                  interpolate( static_cast<Fix16>(x1),
+                               static_cast<Fix16>(static_cast<int16_t>(x2)),
+                               static_cast<Fix16>(x_1),
+                               static_cast<Fix16>(x_2),
+                               static_cast<Fix16>(static_cast<int16_t>(x_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_4)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline uint8_t interpolate( int16_t x1, int8_t x2,
+                            int16_t x_1, int16_t x_2, int8_t x_3, int8_t x_4,
+                            uint8_t y_1, uint8_t y_2, uint8_t y_3, uint8_t y_4 )
+{
+  return static_cast<uint8_t>(static_cast<int16_t>(
+                  interpolate( static_cast<Fix16>(x1),
+                               static_cast<Fix16>(static_cast<int16_t>(x2)),
+                               static_cast<Fix16>(x_1),
+                               static_cast<Fix16>(x_2),
+                               static_cast<Fix16>(static_cast<int16_t>(x_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_4)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline int16_t interpolate( int16_t x1, int8_t x2,
+                            int16_t x_1, int16_t x_2, int8_t x_3, int8_t x_4,
+                            int16_t y_1, int16_t y_2, int16_t y_3, int16_t y_4 )
+{
+  return static_cast<int16_t>(
+                  interpolate( static_cast<Fix16>(x1),
+                               static_cast<Fix16>(static_cast<int16_t>(x2)),
+                               static_cast<Fix16>(x_1),
+                               static_cast<Fix16>(x_2),
+                               static_cast<Fix16>(static_cast<int16_t>(x_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_4)),
+                               static_cast<Fix16>(y_1),
+                               static_cast<Fix16>(y_2),
+                               static_cast<Fix16>(y_3),
+                               static_cast<Fix16>(y_4) )
+                             );
+}
+
+
+template<>
+inline uint16_t interpolate( int16_t x1, int8_t x2,
+                            int16_t x_1, int16_t x_2, int8_t x_3, int8_t x_4,
+                            uint16_t y_1, uint16_t y_2, uint16_t y_3, uint16_t y_4 )
+{
+  return static_cast<uint16_t>(static_cast<float>(
+                  interpolate( static_cast<Fix16>(x1),
+                               static_cast<Fix16>(static_cast<int16_t>(x2)),
+                               static_cast<Fix16>(x_1),
+                               static_cast<Fix16>(x_2),
+                               static_cast<Fix16>(static_cast<int16_t>(x_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_4)),
+                               static_cast<Fix16>(static_cast<float>(y_1)),
+                               static_cast<Fix16>(static_cast<float>(y_2)),
+                               static_cast<Fix16>(static_cast<float>(y_3)),
+                               static_cast<Fix16>(static_cast<float>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline Fix16 interpolate( int16_t x1, int8_t x2,
+                            int16_t x_1, int16_t x_2, int8_t x_3, int8_t x_4,
+                            Fix16 y_1, Fix16 y_2, Fix16 y_3, Fix16 y_4 )
+{
+  return 
+                  interpolate( static_cast<Fix16>(x1),
+                               static_cast<Fix16>(static_cast<int16_t>(x2)),
+                               static_cast<Fix16>(x_1),
+                               static_cast<Fix16>(x_2),
+                               static_cast<Fix16>(static_cast<int16_t>(x_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_4)),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline float interpolate( int16_t x1, int8_t x2,
+                            int16_t x_1, int16_t x_2, int8_t x_3, int8_t x_4,
+                            float y_1, float y_2, float y_3, float y_4 )
+{
+  return 
+                  interpolate( static_cast<float>(x1),
+                               static_cast<float>(x2),
+                               static_cast<float>(x_1),
+                               static_cast<float>(x_2),
+                               static_cast<float>(x_3),
+                               static_cast<float>(x_4),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline double interpolate( int16_t x1, int8_t x2,
+                            int16_t x_1, int16_t x_2, int8_t x_3, int8_t x_4,
+                            double y_1, double y_2, double y_3, double y_4 )
+{
+  return 
+                  interpolate( static_cast<double>(x1),
+                               static_cast<double>(x2),
+                               static_cast<double>(x_1),
+                               static_cast<double>(x_2),
+                               static_cast<double>(x_3),
+                               static_cast<double>(x_4),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline int8_t interpolate( int16_t x1, uint8_t x2,
+                            int16_t x_1, int16_t x_2, uint8_t x_3, uint8_t x_4,
+                            int8_t y_1, int8_t y_2, int8_t y_3, int8_t y_4 )
+{
+  return static_cast<int8_t>(static_cast<int16_t>(
+                  interpolate( static_cast<Fix16>(x1),
+                               static_cast<Fix16>(static_cast<int16_t>(x2)),
+                               static_cast<Fix16>(x_1),
+                               static_cast<Fix16>(x_2),
+                               static_cast<Fix16>(static_cast<int16_t>(x_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_4)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline uint8_t interpolate( int16_t x1, uint8_t x2,
+                            int16_t x_1, int16_t x_2, uint8_t x_3, uint8_t x_4,
+                            uint8_t y_1, uint8_t y_2, uint8_t y_3, uint8_t y_4 )
+{
+  return static_cast<uint8_t>(static_cast<int16_t>(
+                  interpolate( static_cast<Fix16>(x1),
+                               static_cast<Fix16>(static_cast<int16_t>(x2)),
+                               static_cast<Fix16>(x_1),
+                               static_cast<Fix16>(x_2),
+                               static_cast<Fix16>(static_cast<int16_t>(x_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_4)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline int16_t interpolate( int16_t x1, uint8_t x2,
+                            int16_t x_1, int16_t x_2, uint8_t x_3, uint8_t x_4,
+                            int16_t y_1, int16_t y_2, int16_t y_3, int16_t y_4 )
+{
+  return static_cast<int16_t>(
+                  interpolate( static_cast<Fix16>(x1),
+                               static_cast<Fix16>(static_cast<int16_t>(x2)),
+                               static_cast<Fix16>(x_1),
+                               static_cast<Fix16>(x_2),
+                               static_cast<Fix16>(static_cast<int16_t>(x_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_4)),
+                               static_cast<Fix16>(y_1),
+                               static_cast<Fix16>(y_2),
+                               static_cast<Fix16>(y_3),
+                               static_cast<Fix16>(y_4) )
+                             );
+}
+
+
+template<>
+inline uint16_t interpolate( int16_t x1, uint8_t x2,
+                            int16_t x_1, int16_t x_2, uint8_t x_3, uint8_t x_4,
+                            uint16_t y_1, uint16_t y_2, uint16_t y_3, uint16_t y_4 )
+{
+  return static_cast<uint16_t>(static_cast<float>(
+                  interpolate( static_cast<Fix16>(x1),
+                               static_cast<Fix16>(static_cast<int16_t>(x2)),
+                               static_cast<Fix16>(x_1),
+                               static_cast<Fix16>(x_2),
+                               static_cast<Fix16>(static_cast<int16_t>(x_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_4)),
+                               static_cast<Fix16>(static_cast<float>(y_1)),
+                               static_cast<Fix16>(static_cast<float>(y_2)),
+                               static_cast<Fix16>(static_cast<float>(y_3)),
+                               static_cast<Fix16>(static_cast<float>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline Fix16 interpolate( int16_t x1, uint8_t x2,
+                            int16_t x_1, int16_t x_2, uint8_t x_3, uint8_t x_4,
+                            Fix16 y_1, Fix16 y_2, Fix16 y_3, Fix16 y_4 )
+{
+  return 
+                  interpolate( static_cast<Fix16>(x1),
+                               static_cast<Fix16>(static_cast<int16_t>(x2)),
+                               static_cast<Fix16>(x_1),
+                               static_cast<Fix16>(x_2),
+                               static_cast<Fix16>(static_cast<int16_t>(x_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_4)),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline float interpolate( int16_t x1, uint8_t x2,
+                            int16_t x_1, int16_t x_2, uint8_t x_3, uint8_t x_4,
+                            float y_1, float y_2, float y_3, float y_4 )
+{
+  return 
+                  interpolate( static_cast<float>(x1),
+                               static_cast<float>(x2),
+                               static_cast<float>(x_1),
+                               static_cast<float>(x_2),
+                               static_cast<float>(x_3),
+                               static_cast<float>(x_4),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline double interpolate( int16_t x1, uint8_t x2,
+                            int16_t x_1, int16_t x_2, uint8_t x_3, uint8_t x_4,
+                            double y_1, double y_2, double y_3, double y_4 )
+{
+  return 
+                  interpolate( static_cast<double>(x1),
+                               static_cast<double>(x2),
+                               static_cast<double>(x_1),
+                               static_cast<double>(x_2),
+                               static_cast<double>(x_3),
+                               static_cast<double>(x_4),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline int8_t interpolate( int16_t x1, int16_t x2,
+                            int16_t x_1, int16_t x_2, int16_t x_3, int16_t x_4,
+                            int8_t y_1, int8_t y_2, int8_t y_3, int8_t y_4 )
+{
+  return static_cast<int8_t>(static_cast<int16_t>(
+                  interpolate( static_cast<Fix16>(x1),
+                               static_cast<Fix16>(x2),
+                               static_cast<Fix16>(x_1),
+                               static_cast<Fix16>(x_2),
+                               static_cast<Fix16>(x_3),
+                               static_cast<Fix16>(x_4),
+                               static_cast<Fix16>(static_cast<int16_t>(y_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline uint8_t interpolate( int16_t x1, int16_t x2,
+                            int16_t x_1, int16_t x_2, int16_t x_3, int16_t x_4,
+                            uint8_t y_1, uint8_t y_2, uint8_t y_3, uint8_t y_4 )
+{
+  return static_cast<uint8_t>(static_cast<int16_t>(
+                  interpolate( static_cast<Fix16>(x1),
+                               static_cast<Fix16>(x2),
+                               static_cast<Fix16>(x_1),
+                               static_cast<Fix16>(x_2),
+                               static_cast<Fix16>(x_3),
+                               static_cast<Fix16>(x_4),
+                               static_cast<Fix16>(static_cast<int16_t>(y_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline int16_t interpolate( int16_t x1, int16_t x2,
+                            int16_t x_1, int16_t x_2, int16_t x_3, int16_t x_4,
+                            int16_t y_1, int16_t y_2, int16_t y_3, int16_t y_4 )
+{
+  return static_cast<int16_t>(
+                  interpolate( static_cast<Fix16>(x1),
+                               static_cast<Fix16>(x2),
+                               static_cast<Fix16>(x_1),
+                               static_cast<Fix16>(x_2),
+                               static_cast<Fix16>(x_3),
+                               static_cast<Fix16>(x_4),
+                               static_cast<Fix16>(y_1),
+                               static_cast<Fix16>(y_2),
+                               static_cast<Fix16>(y_3),
+                               static_cast<Fix16>(y_4) )
+                             );
+}
+
+
+template<>
+inline uint16_t interpolate( int16_t x1, int16_t x2,
+                            int16_t x_1, int16_t x_2, int16_t x_3, int16_t x_4,
+                            uint16_t y_1, uint16_t y_2, uint16_t y_3, uint16_t y_4 )
+{
+  return static_cast<uint16_t>(static_cast<float>(
+                  interpolate( static_cast<Fix16>(x1),
+                               static_cast<Fix16>(x2),
+                               static_cast<Fix16>(x_1),
+                               static_cast<Fix16>(x_2),
+                               static_cast<Fix16>(x_3),
+                               static_cast<Fix16>(x_4),
+                               static_cast<Fix16>(static_cast<float>(y_1)),
+                               static_cast<Fix16>(static_cast<float>(y_2)),
+                               static_cast<Fix16>(static_cast<float>(y_3)),
+                               static_cast<Fix16>(static_cast<float>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline Fix16 interpolate( int16_t x1, int16_t x2,
+                            int16_t x_1, int16_t x_2, int16_t x_3, int16_t x_4,
+                            Fix16 y_1, Fix16 y_2, Fix16 y_3, Fix16 y_4 )
+{
+  return 
+                  interpolate( static_cast<Fix16>(x1),
+                               static_cast<Fix16>(x2),
+                               static_cast<Fix16>(x_1),
+                               static_cast<Fix16>(x_2),
+                               static_cast<Fix16>(x_3),
+                               static_cast<Fix16>(x_4),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline float interpolate( int16_t x1, int16_t x2,
+                            int16_t x_1, int16_t x_2, int16_t x_3, int16_t x_4,
+                            float y_1, float y_2, float y_3, float y_4 )
+{
+  return 
+                  interpolate( static_cast<float>(x1),
+                               static_cast<float>(x2),
+                               static_cast<float>(x_1),
+                               static_cast<float>(x_2),
+                               static_cast<float>(x_3),
+                               static_cast<float>(x_4),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline double interpolate( int16_t x1, int16_t x2,
+                            int16_t x_1, int16_t x_2, int16_t x_3, int16_t x_4,
+                            double y_1, double y_2, double y_3, double y_4 )
+{
+  return 
+                  interpolate( static_cast<double>(x1),
+                               static_cast<double>(x2),
+                               static_cast<double>(x_1),
+                               static_cast<double>(x_2),
+                               static_cast<double>(x_3),
+                               static_cast<double>(x_4),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline int8_t interpolate( int16_t x1, uint16_t x2,
+                            int16_t x_1, int16_t x_2, uint16_t x_3, uint16_t x_4,
+                            int8_t y_1, int8_t y_2, int8_t y_3, int8_t y_4 )
+{
+  return static_cast<int8_t>(static_cast<int16_t>(
+                  interpolate( static_cast<Fix16>(x1),
+                               static_cast<Fix16>(static_cast<float>(x2)),
+                               static_cast<Fix16>(x_1),
+                               static_cast<Fix16>(x_2),
+                               static_cast<Fix16>(static_cast<float>(x_3)),
+                               static_cast<Fix16>(static_cast<float>(x_4)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline uint8_t interpolate( int16_t x1, uint16_t x2,
+                            int16_t x_1, int16_t x_2, uint16_t x_3, uint16_t x_4,
+                            uint8_t y_1, uint8_t y_2, uint8_t y_3, uint8_t y_4 )
+{
+  return static_cast<uint8_t>(static_cast<int16_t>(
+                  interpolate( static_cast<Fix16>(x1),
+                               static_cast<Fix16>(static_cast<float>(x2)),
+                               static_cast<Fix16>(x_1),
+                               static_cast<Fix16>(x_2),
+                               static_cast<Fix16>(static_cast<float>(x_3)),
+                               static_cast<Fix16>(static_cast<float>(x_4)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline int16_t interpolate( int16_t x1, uint16_t x2,
+                            int16_t x_1, int16_t x_2, uint16_t x_3, uint16_t x_4,
+                            int16_t y_1, int16_t y_2, int16_t y_3, int16_t y_4 )
+{
+  return static_cast<int16_t>(
+                  interpolate( static_cast<Fix16>(x1),
+                               static_cast<Fix16>(static_cast<float>(x2)),
+                               static_cast<Fix16>(x_1),
+                               static_cast<Fix16>(x_2),
+                               static_cast<Fix16>(static_cast<float>(x_3)),
+                               static_cast<Fix16>(static_cast<float>(x_4)),
+                               static_cast<Fix16>(y_1),
+                               static_cast<Fix16>(y_2),
+                               static_cast<Fix16>(y_3),
+                               static_cast<Fix16>(y_4) )
+                             );
+}
+
+
+template<>
+inline uint16_t interpolate( int16_t x1, uint16_t x2,
+                            int16_t x_1, int16_t x_2, uint16_t x_3, uint16_t x_4,
+                            uint16_t y_1, uint16_t y_2, uint16_t y_3, uint16_t y_4 )
+{
+  return static_cast<uint16_t>(static_cast<float>(
+                  interpolate( static_cast<Fix16>(x1),
+                               static_cast<Fix16>(static_cast<float>(x2)),
+                               static_cast<Fix16>(x_1),
+                               static_cast<Fix16>(x_2),
+                               static_cast<Fix16>(static_cast<float>(x_3)),
+                               static_cast<Fix16>(static_cast<float>(x_4)),
+                               static_cast<Fix16>(static_cast<float>(y_1)),
+                               static_cast<Fix16>(static_cast<float>(y_2)),
+                               static_cast<Fix16>(static_cast<float>(y_3)),
+                               static_cast<Fix16>(static_cast<float>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline Fix16 interpolate( int16_t x1, uint16_t x2,
+                            int16_t x_1, int16_t x_2, uint16_t x_3, uint16_t x_4,
+                            Fix16 y_1, Fix16 y_2, Fix16 y_3, Fix16 y_4 )
+{
+  return 
+                  interpolate( static_cast<Fix16>(x1),
+                               static_cast<Fix16>(static_cast<float>(x2)),
+                               static_cast<Fix16>(x_1),
+                               static_cast<Fix16>(x_2),
+                               static_cast<Fix16>(static_cast<float>(x_3)),
+                               static_cast<Fix16>(static_cast<float>(x_4)),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline float interpolate( int16_t x1, uint16_t x2,
+                            int16_t x_1, int16_t x_2, uint16_t x_3, uint16_t x_4,
+                            float y_1, float y_2, float y_3, float y_4 )
+{
+  return 
+                  interpolate( static_cast<float>(x1),
+                               static_cast<float>(x2),
+                               static_cast<float>(x_1),
+                               static_cast<float>(x_2),
+                               static_cast<float>(x_3),
+                               static_cast<float>(x_4),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline double interpolate( int16_t x1, uint16_t x2,
+                            int16_t x_1, int16_t x_2, uint16_t x_3, uint16_t x_4,
+                            double y_1, double y_2, double y_3, double y_4 )
+{
+  return 
+                  interpolate( static_cast<double>(x1),
+                               static_cast<double>(x2),
+                               static_cast<double>(x_1),
+                               static_cast<double>(x_2),
+                               static_cast<double>(x_3),
+                               static_cast<double>(x_4),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline int8_t interpolate( int16_t x1, Fix16 x2,
+                            int16_t x_1, int16_t x_2, Fix16 x_3, Fix16 x_4,
+                            int8_t y_1, int8_t y_2, int8_t y_3, int8_t y_4 )
+{
+  return static_cast<int8_t>(static_cast<int16_t>(
+                  interpolate( static_cast<Fix16>(x1),
+                               x2,
+                               static_cast<Fix16>(x_1),
+                               static_cast<Fix16>(x_2),
+                               x_3,
+                               x_4,
+                               static_cast<Fix16>(static_cast<int16_t>(y_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline uint8_t interpolate( int16_t x1, Fix16 x2,
+                            int16_t x_1, int16_t x_2, Fix16 x_3, Fix16 x_4,
+                            uint8_t y_1, uint8_t y_2, uint8_t y_3, uint8_t y_4 )
+{
+  return static_cast<uint8_t>(static_cast<int16_t>(
+                  interpolate( static_cast<Fix16>(x1),
+                               x2,
+                               static_cast<Fix16>(x_1),
+                               static_cast<Fix16>(x_2),
+                               x_3,
+                               x_4,
+                               static_cast<Fix16>(static_cast<int16_t>(y_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline int16_t interpolate( int16_t x1, Fix16 x2,
+                            int16_t x_1, int16_t x_2, Fix16 x_3, Fix16 x_4,
+                            int16_t y_1, int16_t y_2, int16_t y_3, int16_t y_4 )
+{
+  return static_cast<int16_t>(
+                  interpolate( static_cast<Fix16>(x1),
+                               x2,
+                               static_cast<Fix16>(x_1),
+                               static_cast<Fix16>(x_2),
+                               x_3,
+                               x_4,
+                               static_cast<Fix16>(y_1),
+                               static_cast<Fix16>(y_2),
+                               static_cast<Fix16>(y_3),
+                               static_cast<Fix16>(y_4) )
+                             );
+}
+
+
+template<>
+inline uint16_t interpolate( int16_t x1, Fix16 x2,
+                            int16_t x_1, int16_t x_2, Fix16 x_3, Fix16 x_4,
+                            uint16_t y_1, uint16_t y_2, uint16_t y_3, uint16_t y_4 )
+{
+  return static_cast<uint16_t>(static_cast<float>(
+                  interpolate( static_cast<Fix16>(x1),
+                               x2,
+                               static_cast<Fix16>(x_1),
+                               static_cast<Fix16>(x_2),
+                               x_3,
+                               x_4,
+                               static_cast<Fix16>(static_cast<float>(y_1)),
+                               static_cast<Fix16>(static_cast<float>(y_2)),
+                               static_cast<Fix16>(static_cast<float>(y_3)),
+                               static_cast<Fix16>(static_cast<float>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline Fix16 interpolate( int16_t x1, Fix16 x2,
+                            int16_t x_1, int16_t x_2, Fix16 x_3, Fix16 x_4,
+                            Fix16 y_1, Fix16 y_2, Fix16 y_3, Fix16 y_4 )
+{
+  return 
+                  interpolate( static_cast<Fix16>(x1),
+                               x2,
+                               static_cast<Fix16>(x_1),
+                               static_cast<Fix16>(x_2),
+                               x_3,
+                               x_4,
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline float interpolate( int16_t x1, Fix16 x2,
+                            int16_t x_1, int16_t x_2, Fix16 x_3, Fix16 x_4,
+                            float y_1, float y_2, float y_3, float y_4 )
+{
+  return 
+                  interpolate( static_cast<float>(x1),
+                               static_cast<float>(x2),
+                               static_cast<float>(x_1),
+                               static_cast<float>(x_2),
+                               static_cast<float>(x_3),
+                               static_cast<float>(x_4),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline double interpolate( int16_t x1, Fix16 x2,
+                            int16_t x_1, int16_t x_2, Fix16 x_3, Fix16 x_4,
+                            double y_1, double y_2, double y_3, double y_4 )
+{
+  return 
+                  interpolate( static_cast<double>(x1),
+                               static_cast<double>(x2),
+                               static_cast<double>(x_1),
+                               static_cast<double>(x_2),
+                               static_cast<double>(x_3),
+                               static_cast<double>(x_4),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline int8_t interpolate( uint16_t x1, int8_t x2,
+                            uint16_t x_1, uint16_t x_2, int8_t x_3, int8_t x_4,
+                            int8_t y_1, int8_t y_2, int8_t y_3, int8_t y_4 )
+{
+  return static_cast<int8_t>(static_cast<int16_t>(
+                  interpolate( static_cast<Fix16>(static_cast<float>(x1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x2)),
+                               static_cast<Fix16>(static_cast<float>(x_1)),
+                               static_cast<Fix16>(static_cast<float>(x_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_4)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline uint8_t interpolate( uint16_t x1, int8_t x2,
+                            uint16_t x_1, uint16_t x_2, int8_t x_3, int8_t x_4,
+                            uint8_t y_1, uint8_t y_2, uint8_t y_3, uint8_t y_4 )
+{
+  return static_cast<uint8_t>(static_cast<int16_t>(
+                  interpolate( static_cast<Fix16>(static_cast<float>(x1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x2)),
+                               static_cast<Fix16>(static_cast<float>(x_1)),
+                               static_cast<Fix16>(static_cast<float>(x_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_4)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline int16_t interpolate( uint16_t x1, int8_t x2,
+                            uint16_t x_1, uint16_t x_2, int8_t x_3, int8_t x_4,
+                            int16_t y_1, int16_t y_2, int16_t y_3, int16_t y_4 )
+{
+  return static_cast<int16_t>(
+                  interpolate( static_cast<Fix16>(static_cast<float>(x1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x2)),
+                               static_cast<Fix16>(static_cast<float>(x_1)),
+                               static_cast<Fix16>(static_cast<float>(x_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_4)),
+                               static_cast<Fix16>(y_1),
+                               static_cast<Fix16>(y_2),
+                               static_cast<Fix16>(y_3),
+                               static_cast<Fix16>(y_4) )
+                             );
+}
+
+
+template<>
+inline uint16_t interpolate( uint16_t x1, int8_t x2,
+                            uint16_t x_1, uint16_t x_2, int8_t x_3, int8_t x_4,
+                            uint16_t y_1, uint16_t y_2, uint16_t y_3, uint16_t y_4 )
+{
+  return static_cast<uint16_t>(static_cast<float>(
+                  interpolate( static_cast<Fix16>(static_cast<float>(x1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x2)),
+                               static_cast<Fix16>(static_cast<float>(x_1)),
+                               static_cast<Fix16>(static_cast<float>(x_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_4)),
+                               static_cast<Fix16>(static_cast<float>(y_1)),
+                               static_cast<Fix16>(static_cast<float>(y_2)),
+                               static_cast<Fix16>(static_cast<float>(y_3)),
+                               static_cast<Fix16>(static_cast<float>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline Fix16 interpolate( uint16_t x1, int8_t x2,
+                            uint16_t x_1, uint16_t x_2, int8_t x_3, int8_t x_4,
+                            Fix16 y_1, Fix16 y_2, Fix16 y_3, Fix16 y_4 )
+{
+  return 
+                  interpolate( static_cast<Fix16>(static_cast<float>(x1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x2)),
+                               static_cast<Fix16>(static_cast<float>(x_1)),
+                               static_cast<Fix16>(static_cast<float>(x_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_4)),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline float interpolate( uint16_t x1, int8_t x2,
+                            uint16_t x_1, uint16_t x_2, int8_t x_3, int8_t x_4,
+                            float y_1, float y_2, float y_3, float y_4 )
+{
+  return 
+                  interpolate( static_cast<float>(x1),
+                               static_cast<float>(x2),
+                               static_cast<float>(x_1),
+                               static_cast<float>(x_2),
+                               static_cast<float>(x_3),
+                               static_cast<float>(x_4),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline double interpolate( uint16_t x1, int8_t x2,
+                            uint16_t x_1, uint16_t x_2, int8_t x_3, int8_t x_4,
+                            double y_1, double y_2, double y_3, double y_4 )
+{
+  return 
+                  interpolate( static_cast<double>(x1),
+                               static_cast<double>(x2),
+                               static_cast<double>(x_1),
+                               static_cast<double>(x_2),
+                               static_cast<double>(x_3),
+                               static_cast<double>(x_4),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline int8_t interpolate( uint16_t x1, uint8_t x2,
+                            uint16_t x_1, uint16_t x_2, uint8_t x_3, uint8_t x_4,
+                            int8_t y_1, int8_t y_2, int8_t y_3, int8_t y_4 )
+{
+  return static_cast<int8_t>(static_cast<int16_t>(
+                  interpolate( static_cast<Fix16>(static_cast<float>(x1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x2)),
+                               static_cast<Fix16>(static_cast<float>(x_1)),
+                               static_cast<Fix16>(static_cast<float>(x_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_4)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline uint8_t interpolate( uint16_t x1, uint8_t x2,
+                            uint16_t x_1, uint16_t x_2, uint8_t x_3, uint8_t x_4,
+                            uint8_t y_1, uint8_t y_2, uint8_t y_3, uint8_t y_4 )
+{
+  return static_cast<uint8_t>(static_cast<int16_t>(
+                  interpolate( static_cast<Fix16>(static_cast<float>(x1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x2)),
+                               static_cast<Fix16>(static_cast<float>(x_1)),
+                               static_cast<Fix16>(static_cast<float>(x_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_4)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline int16_t interpolate( uint16_t x1, uint8_t x2,
+                            uint16_t x_1, uint16_t x_2, uint8_t x_3, uint8_t x_4,
+                            int16_t y_1, int16_t y_2, int16_t y_3, int16_t y_4 )
+{
+  return static_cast<int16_t>(
+                  interpolate( static_cast<Fix16>(static_cast<float>(x1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x2)),
+                               static_cast<Fix16>(static_cast<float>(x_1)),
+                               static_cast<Fix16>(static_cast<float>(x_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_4)),
+                               static_cast<Fix16>(y_1),
+                               static_cast<Fix16>(y_2),
+                               static_cast<Fix16>(y_3),
+                               static_cast<Fix16>(y_4) )
+                             );
+}
+
+
+template<>
+inline uint16_t interpolate( uint16_t x1, uint8_t x2,
+                            uint16_t x_1, uint16_t x_2, uint8_t x_3, uint8_t x_4,
+                            uint16_t y_1, uint16_t y_2, uint16_t y_3, uint16_t y_4 )
+{
+  return static_cast<uint16_t>(static_cast<float>(
+                  interpolate( static_cast<Fix16>(static_cast<float>(x1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x2)),
+                               static_cast<Fix16>(static_cast<float>(x_1)),
+                               static_cast<Fix16>(static_cast<float>(x_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_4)),
+                               static_cast<Fix16>(static_cast<float>(y_1)),
+                               static_cast<Fix16>(static_cast<float>(y_2)),
+                               static_cast<Fix16>(static_cast<float>(y_3)),
+                               static_cast<Fix16>(static_cast<float>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline Fix16 interpolate( uint16_t x1, uint8_t x2,
+                            uint16_t x_1, uint16_t x_2, uint8_t x_3, uint8_t x_4,
+                            Fix16 y_1, Fix16 y_2, Fix16 y_3, Fix16 y_4 )
+{
+  return 
+                  interpolate( static_cast<Fix16>(static_cast<float>(x1)),
+                               static_cast<Fix16>(static_cast<int16_t>(x2)),
+                               static_cast<Fix16>(static_cast<float>(x_1)),
+                               static_cast<Fix16>(static_cast<float>(x_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_4)),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline float interpolate( uint16_t x1, uint8_t x2,
+                            uint16_t x_1, uint16_t x_2, uint8_t x_3, uint8_t x_4,
+                            float y_1, float y_2, float y_3, float y_4 )
+{
+  return 
+                  interpolate( static_cast<float>(x1),
+                               static_cast<float>(x2),
+                               static_cast<float>(x_1),
+                               static_cast<float>(x_2),
+                               static_cast<float>(x_3),
+                               static_cast<float>(x_4),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline double interpolate( uint16_t x1, uint8_t x2,
+                            uint16_t x_1, uint16_t x_2, uint8_t x_3, uint8_t x_4,
+                            double y_1, double y_2, double y_3, double y_4 )
+{
+  return 
+                  interpolate( static_cast<double>(x1),
+                               static_cast<double>(x2),
+                               static_cast<double>(x_1),
+                               static_cast<double>(x_2),
+                               static_cast<double>(x_3),
+                               static_cast<double>(x_4),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline int8_t interpolate( uint16_t x1, int16_t x2,
+                            uint16_t x_1, uint16_t x_2, int16_t x_3, int16_t x_4,
+                            int8_t y_1, int8_t y_2, int8_t y_3, int8_t y_4 )
+{
+  return static_cast<int8_t>(static_cast<int16_t>(
+                  interpolate( static_cast<Fix16>(static_cast<float>(x1)),
+                               static_cast<Fix16>(x2),
+                               static_cast<Fix16>(static_cast<float>(x_1)),
+                               static_cast<Fix16>(static_cast<float>(x_2)),
+                               static_cast<Fix16>(x_3),
+                               static_cast<Fix16>(x_4),
+                               static_cast<Fix16>(static_cast<int16_t>(y_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline uint8_t interpolate( uint16_t x1, int16_t x2,
+                            uint16_t x_1, uint16_t x_2, int16_t x_3, int16_t x_4,
+                            uint8_t y_1, uint8_t y_2, uint8_t y_3, uint8_t y_4 )
+{
+  return static_cast<uint8_t>(static_cast<int16_t>(
+                  interpolate( static_cast<Fix16>(static_cast<float>(x1)),
+                               static_cast<Fix16>(x2),
+                               static_cast<Fix16>(static_cast<float>(x_1)),
+                               static_cast<Fix16>(static_cast<float>(x_2)),
+                               static_cast<Fix16>(x_3),
+                               static_cast<Fix16>(x_4),
+                               static_cast<Fix16>(static_cast<int16_t>(y_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline int16_t interpolate( uint16_t x1, int16_t x2,
+                            uint16_t x_1, uint16_t x_2, int16_t x_3, int16_t x_4,
+                            int16_t y_1, int16_t y_2, int16_t y_3, int16_t y_4 )
+{
+  return static_cast<int16_t>(
+                  interpolate( static_cast<Fix16>(static_cast<float>(x1)),
+                               static_cast<Fix16>(x2),
+                               static_cast<Fix16>(static_cast<float>(x_1)),
+                               static_cast<Fix16>(static_cast<float>(x_2)),
+                               static_cast<Fix16>(x_3),
+                               static_cast<Fix16>(x_4),
+                               static_cast<Fix16>(y_1),
+                               static_cast<Fix16>(y_2),
+                               static_cast<Fix16>(y_3),
+                               static_cast<Fix16>(y_4) )
+                             );
+}
+
+
+template<>
+inline uint16_t interpolate( uint16_t x1, int16_t x2,
+                            uint16_t x_1, uint16_t x_2, int16_t x_3, int16_t x_4,
+                            uint16_t y_1, uint16_t y_2, uint16_t y_3, uint16_t y_4 )
+{
+  return static_cast<uint16_t>(static_cast<float>(
+                  interpolate( static_cast<Fix16>(static_cast<float>(x1)),
+                               static_cast<Fix16>(x2),
+                               static_cast<Fix16>(static_cast<float>(x_1)),
+                               static_cast<Fix16>(static_cast<float>(x_2)),
+                               static_cast<Fix16>(x_3),
+                               static_cast<Fix16>(x_4),
+                               static_cast<Fix16>(static_cast<float>(y_1)),
+                               static_cast<Fix16>(static_cast<float>(y_2)),
+                               static_cast<Fix16>(static_cast<float>(y_3)),
+                               static_cast<Fix16>(static_cast<float>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline Fix16 interpolate( uint16_t x1, int16_t x2,
+                            uint16_t x_1, uint16_t x_2, int16_t x_3, int16_t x_4,
+                            Fix16 y_1, Fix16 y_2, Fix16 y_3, Fix16 y_4 )
+{
+  return 
+                  interpolate( static_cast<Fix16>(static_cast<float>(x1)),
+                               static_cast<Fix16>(x2),
+                               static_cast<Fix16>(static_cast<float>(x_1)),
+                               static_cast<Fix16>(static_cast<float>(x_2)),
+                               static_cast<Fix16>(x_3),
+                               static_cast<Fix16>(x_4),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline float interpolate( uint16_t x1, int16_t x2,
+                            uint16_t x_1, uint16_t x_2, int16_t x_3, int16_t x_4,
+                            float y_1, float y_2, float y_3, float y_4 )
+{
+  return 
+                  interpolate( static_cast<float>(x1),
+                               static_cast<float>(x2),
+                               static_cast<float>(x_1),
+                               static_cast<float>(x_2),
+                               static_cast<float>(x_3),
+                               static_cast<float>(x_4),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline double interpolate( uint16_t x1, int16_t x2,
+                            uint16_t x_1, uint16_t x_2, int16_t x_3, int16_t x_4,
+                            double y_1, double y_2, double y_3, double y_4 )
+{
+  return 
+                  interpolate( static_cast<double>(x1),
+                               static_cast<double>(x2),
+                               static_cast<double>(x_1),
+                               static_cast<double>(x_2),
+                               static_cast<double>(x_3),
+                               static_cast<double>(x_4),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline int8_t interpolate( uint16_t x1, uint16_t x2,
+                            uint16_t x_1, uint16_t x_2, uint16_t x_3, uint16_t x_4,
+                            int8_t y_1, int8_t y_2, int8_t y_3, int8_t y_4 )
+{
+  return static_cast<int8_t>(static_cast<int16_t>(
+                  interpolate( static_cast<Fix16>(static_cast<float>(x1)),
+                               static_cast<Fix16>(static_cast<float>(x2)),
+                               static_cast<Fix16>(static_cast<float>(x_1)),
+                               static_cast<Fix16>(static_cast<float>(x_2)),
+                               static_cast<Fix16>(static_cast<float>(x_3)),
+                               static_cast<Fix16>(static_cast<float>(x_4)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline uint8_t interpolate( uint16_t x1, uint16_t x2,
+                            uint16_t x_1, uint16_t x_2, uint16_t x_3, uint16_t x_4,
+                            uint8_t y_1, uint8_t y_2, uint8_t y_3, uint8_t y_4 )
+{
+  return static_cast<uint8_t>(static_cast<int16_t>(
+                  interpolate( static_cast<Fix16>(static_cast<float>(x1)),
+                               static_cast<Fix16>(static_cast<float>(x2)),
+                               static_cast<Fix16>(static_cast<float>(x_1)),
+                               static_cast<Fix16>(static_cast<float>(x_2)),
+                               static_cast<Fix16>(static_cast<float>(x_3)),
+                               static_cast<Fix16>(static_cast<float>(x_4)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline int16_t interpolate( uint16_t x1, uint16_t x2,
+                            uint16_t x_1, uint16_t x_2, uint16_t x_3, uint16_t x_4,
+                            int16_t y_1, int16_t y_2, int16_t y_3, int16_t y_4 )
+{
+  return static_cast<int16_t>(
+                  interpolate( static_cast<Fix16>(static_cast<float>(x1)),
+                               static_cast<Fix16>(static_cast<float>(x2)),
+                               static_cast<Fix16>(static_cast<float>(x_1)),
+                               static_cast<Fix16>(static_cast<float>(x_2)),
+                               static_cast<Fix16>(static_cast<float>(x_3)),
+                               static_cast<Fix16>(static_cast<float>(x_4)),
+                               static_cast<Fix16>(y_1),
+                               static_cast<Fix16>(y_2),
+                               static_cast<Fix16>(y_3),
+                               static_cast<Fix16>(y_4) )
+                             );
+}
+
+
+template<>
+inline uint16_t interpolate( uint16_t x1, uint16_t x2,
+                            uint16_t x_1, uint16_t x_2, uint16_t x_3, uint16_t x_4,
+                            uint16_t y_1, uint16_t y_2, uint16_t y_3, uint16_t y_4 )
+{
+  return static_cast<uint16_t>(static_cast<float>(
+                  interpolate( static_cast<Fix16>(static_cast<float>(x1)),
+                               static_cast<Fix16>(static_cast<float>(x2)),
+                               static_cast<Fix16>(static_cast<float>(x_1)),
+                               static_cast<Fix16>(static_cast<float>(x_2)),
+                               static_cast<Fix16>(static_cast<float>(x_3)),
+                               static_cast<Fix16>(static_cast<float>(x_4)),
+                               static_cast<Fix16>(static_cast<float>(y_1)),
+                               static_cast<Fix16>(static_cast<float>(y_2)),
+                               static_cast<Fix16>(static_cast<float>(y_3)),
+                               static_cast<Fix16>(static_cast<float>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline Fix16 interpolate( uint16_t x1, uint16_t x2,
+                            uint16_t x_1, uint16_t x_2, uint16_t x_3, uint16_t x_4,
+                            Fix16 y_1, Fix16 y_2, Fix16 y_3, Fix16 y_4 )
+{
+  return 
+                  interpolate( static_cast<Fix16>(static_cast<float>(x1)),
+                               static_cast<Fix16>(static_cast<float>(x2)),
+                               static_cast<Fix16>(static_cast<float>(x_1)),
+                               static_cast<Fix16>(static_cast<float>(x_2)),
+                               static_cast<Fix16>(static_cast<float>(x_3)),
+                               static_cast<Fix16>(static_cast<float>(x_4)),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline float interpolate( uint16_t x1, uint16_t x2,
+                            uint16_t x_1, uint16_t x_2, uint16_t x_3, uint16_t x_4,
+                            float y_1, float y_2, float y_3, float y_4 )
+{
+  return 
+                  interpolate( static_cast<float>(x1),
+                               static_cast<float>(x2),
+                               static_cast<float>(x_1),
+                               static_cast<float>(x_2),
+                               static_cast<float>(x_3),
+                               static_cast<float>(x_4),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline double interpolate( uint16_t x1, uint16_t x2,
+                            uint16_t x_1, uint16_t x_2, uint16_t x_3, uint16_t x_4,
+                            double y_1, double y_2, double y_3, double y_4 )
+{
+  return 
+                  interpolate( static_cast<double>(x1),
+                               static_cast<double>(x2),
+                               static_cast<double>(x_1),
+                               static_cast<double>(x_2),
+                               static_cast<double>(x_3),
+                               static_cast<double>(x_4),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline int8_t interpolate( uint16_t x1, Fix16 x2,
+                            uint16_t x_1, uint16_t x_2, Fix16 x_3, Fix16 x_4,
+                            int8_t y_1, int8_t y_2, int8_t y_3, int8_t y_4 )
+{
+  return static_cast<int8_t>(static_cast<int16_t>(
+                  interpolate( static_cast<Fix16>(static_cast<float>(x1)),
+                               x2,
+                               static_cast<Fix16>(static_cast<float>(x_1)),
+                               static_cast<Fix16>(static_cast<float>(x_2)),
+                               x_3,
+                               x_4,
+                               static_cast<Fix16>(static_cast<int16_t>(y_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline uint8_t interpolate( uint16_t x1, Fix16 x2,
+                            uint16_t x_1, uint16_t x_2, Fix16 x_3, Fix16 x_4,
+                            uint8_t y_1, uint8_t y_2, uint8_t y_3, uint8_t y_4 )
+{
+  return static_cast<uint8_t>(static_cast<int16_t>(
+                  interpolate( static_cast<Fix16>(static_cast<float>(x1)),
+                               x2,
+                               static_cast<Fix16>(static_cast<float>(x_1)),
+                               static_cast<Fix16>(static_cast<float>(x_2)),
+                               x_3,
+                               x_4,
+                               static_cast<Fix16>(static_cast<int16_t>(y_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline int16_t interpolate( uint16_t x1, Fix16 x2,
+                            uint16_t x_1, uint16_t x_2, Fix16 x_3, Fix16 x_4,
+                            int16_t y_1, int16_t y_2, int16_t y_3, int16_t y_4 )
+{
+  return static_cast<int16_t>(
+                  interpolate( static_cast<Fix16>(static_cast<float>(x1)),
+                               x2,
+                               static_cast<Fix16>(static_cast<float>(x_1)),
+                               static_cast<Fix16>(static_cast<float>(x_2)),
+                               x_3,
+                               x_4,
+                               static_cast<Fix16>(y_1),
+                               static_cast<Fix16>(y_2),
+                               static_cast<Fix16>(y_3),
+                               static_cast<Fix16>(y_4) )
+                             );
+}
+
+
+template<>
+inline uint16_t interpolate( uint16_t x1, Fix16 x2,
+                            uint16_t x_1, uint16_t x_2, Fix16 x_3, Fix16 x_4,
+                            uint16_t y_1, uint16_t y_2, uint16_t y_3, uint16_t y_4 )
+{
+  return static_cast<uint16_t>(static_cast<float>(
+                  interpolate( static_cast<Fix16>(static_cast<float>(x1)),
+                               x2,
+                               static_cast<Fix16>(static_cast<float>(x_1)),
+                               static_cast<Fix16>(static_cast<float>(x_2)),
+                               x_3,
+                               x_4,
+                               static_cast<Fix16>(static_cast<float>(y_1)),
+                               static_cast<Fix16>(static_cast<float>(y_2)),
+                               static_cast<Fix16>(static_cast<float>(y_3)),
+                               static_cast<Fix16>(static_cast<float>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline Fix16 interpolate( uint16_t x1, Fix16 x2,
+                            uint16_t x_1, uint16_t x_2, Fix16 x_3, Fix16 x_4,
+                            Fix16 y_1, Fix16 y_2, Fix16 y_3, Fix16 y_4 )
+{
+  return 
+                  interpolate( static_cast<Fix16>(static_cast<float>(x1)),
+                               x2,
+                               static_cast<Fix16>(static_cast<float>(x_1)),
+                               static_cast<Fix16>(static_cast<float>(x_2)),
+                               x_3,
+                               x_4,
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline float interpolate( uint16_t x1, Fix16 x2,
+                            uint16_t x_1, uint16_t x_2, Fix16 x_3, Fix16 x_4,
+                            float y_1, float y_2, float y_3, float y_4 )
+{
+  return 
+                  interpolate( static_cast<float>(x1),
+                               static_cast<float>(x2),
+                               static_cast<float>(x_1),
+                               static_cast<float>(x_2),
+                               static_cast<float>(x_3),
+                               static_cast<float>(x_4),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline double interpolate( uint16_t x1, Fix16 x2,
+                            uint16_t x_1, uint16_t x_2, Fix16 x_3, Fix16 x_4,
+                            double y_1, double y_2, double y_3, double y_4 )
+{
+  return 
+                  interpolate( static_cast<double>(x1),
+                               static_cast<double>(x2),
+                               static_cast<double>(x_1),
+                               static_cast<double>(x_2),
+                               static_cast<double>(x_3),
+                               static_cast<double>(x_4),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline int8_t interpolate( Fix16 x1, int8_t x2,
+                            Fix16 x_1, Fix16 x_2, int8_t x_3, int8_t x_4,
+                            int8_t y_1, int8_t y_2, int8_t y_3, int8_t y_4 )
+{
+  return static_cast<int8_t>(static_cast<int16_t>(
+                  interpolate( x1,
+                               static_cast<Fix16>(static_cast<int16_t>(x2)),
+                               x_1,
+                               x_2,
+                               static_cast<Fix16>(static_cast<int16_t>(x_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_4)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline uint8_t interpolate( Fix16 x1, int8_t x2,
+                            Fix16 x_1, Fix16 x_2, int8_t x_3, int8_t x_4,
+                            uint8_t y_1, uint8_t y_2, uint8_t y_3, uint8_t y_4 )
+{
+  return static_cast<uint8_t>(static_cast<int16_t>(
+                  interpolate( x1,
+                               static_cast<Fix16>(static_cast<int16_t>(x2)),
+                               x_1,
+                               x_2,
+                               static_cast<Fix16>(static_cast<int16_t>(x_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_4)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline int16_t interpolate( Fix16 x1, int8_t x2,
+                            Fix16 x_1, Fix16 x_2, int8_t x_3, int8_t x_4,
+                            int16_t y_1, int16_t y_2, int16_t y_3, int16_t y_4 )
+{
+  return static_cast<int16_t>(
+                  interpolate( x1,
+                               static_cast<Fix16>(static_cast<int16_t>(x2)),
+                               x_1,
+                               x_2,
+                               static_cast<Fix16>(static_cast<int16_t>(x_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_4)),
+                               static_cast<Fix16>(y_1),
+                               static_cast<Fix16>(y_2),
+                               static_cast<Fix16>(y_3),
+                               static_cast<Fix16>(y_4) )
+                             );
+}
+
+
+template<>
+inline uint16_t interpolate( Fix16 x1, int8_t x2,
+                            Fix16 x_1, Fix16 x_2, int8_t x_3, int8_t x_4,
+                            uint16_t y_1, uint16_t y_2, uint16_t y_3, uint16_t y_4 )
+{
+  return static_cast<uint16_t>(static_cast<float>(
+                  interpolate( x1,
+                               static_cast<Fix16>(static_cast<int16_t>(x2)),
+                               x_1,
+                               x_2,
+                               static_cast<Fix16>(static_cast<int16_t>(x_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_4)),
+                               static_cast<Fix16>(static_cast<float>(y_1)),
+                               static_cast<Fix16>(static_cast<float>(y_2)),
+                               static_cast<Fix16>(static_cast<float>(y_3)),
+                               static_cast<Fix16>(static_cast<float>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline Fix16 interpolate( Fix16 x1, int8_t x2,
+                            Fix16 x_1, Fix16 x_2, int8_t x_3, int8_t x_4,
+                            Fix16 y_1, Fix16 y_2, Fix16 y_3, Fix16 y_4 )
+{
+  return 
+                  interpolate( x1,
+                               static_cast<Fix16>(static_cast<int16_t>(x2)),
+                               x_1,
+                               x_2,
+                               static_cast<Fix16>(static_cast<int16_t>(x_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_4)),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline float interpolate( Fix16 x1, int8_t x2,
+                            Fix16 x_1, Fix16 x_2, int8_t x_3, int8_t x_4,
+                            float y_1, float y_2, float y_3, float y_4 )
+{
+  return 
+                  interpolate( static_cast<float>(x1),
+                               static_cast<float>(x2),
+                               static_cast<float>(x_1),
+                               static_cast<float>(x_2),
+                               static_cast<float>(x_3),
+                               static_cast<float>(x_4),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline double interpolate( Fix16 x1, int8_t x2,
+                            Fix16 x_1, Fix16 x_2, int8_t x_3, int8_t x_4,
+                            double y_1, double y_2, double y_3, double y_4 )
+{
+  return 
+                  interpolate( static_cast<double>(x1),
+                               static_cast<double>(x2),
+                               static_cast<double>(x_1),
+                               static_cast<double>(x_2),
+                               static_cast<double>(x_3),
+                               static_cast<double>(x_4),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline int8_t interpolate( Fix16 x1, uint8_t x2,
+                            Fix16 x_1, Fix16 x_2, uint8_t x_3, uint8_t x_4,
+                            int8_t y_1, int8_t y_2, int8_t y_3, int8_t y_4 )
+{
+  return static_cast<int8_t>(static_cast<int16_t>(
+                  interpolate( x1,
+                               static_cast<Fix16>(static_cast<int16_t>(x2)),
+                               x_1,
+                               x_2,
+                               static_cast<Fix16>(static_cast<int16_t>(x_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_4)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline uint8_t interpolate( Fix16 x1, uint8_t x2,
+                            Fix16 x_1, Fix16 x_2, uint8_t x_3, uint8_t x_4,
+                            uint8_t y_1, uint8_t y_2, uint8_t y_3, uint8_t y_4 )
+{
+  return static_cast<uint8_t>(static_cast<int16_t>(
+                  interpolate( x1,
+                               static_cast<Fix16>(static_cast<int16_t>(x2)),
+                               x_1,
+                               x_2,
+                               static_cast<Fix16>(static_cast<int16_t>(x_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_4)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline int16_t interpolate( Fix16 x1, uint8_t x2,
+                            Fix16 x_1, Fix16 x_2, uint8_t x_3, uint8_t x_4,
+                            int16_t y_1, int16_t y_2, int16_t y_3, int16_t y_4 )
+{
+  return static_cast<int16_t>(
+                  interpolate( x1,
+                               static_cast<Fix16>(static_cast<int16_t>(x2)),
+                               x_1,
+                               x_2,
+                               static_cast<Fix16>(static_cast<int16_t>(x_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_4)),
+                               static_cast<Fix16>(y_1),
+                               static_cast<Fix16>(y_2),
+                               static_cast<Fix16>(y_3),
+                               static_cast<Fix16>(y_4) )
+                             );
+}
+
+
+template<>
+inline uint16_t interpolate( Fix16 x1, uint8_t x2,
+                            Fix16 x_1, Fix16 x_2, uint8_t x_3, uint8_t x_4,
+                            uint16_t y_1, uint16_t y_2, uint16_t y_3, uint16_t y_4 )
+{
+  return static_cast<uint16_t>(static_cast<float>(
+                  interpolate( x1,
+                               static_cast<Fix16>(static_cast<int16_t>(x2)),
+                               x_1,
+                               x_2,
+                               static_cast<Fix16>(static_cast<int16_t>(x_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_4)),
+                               static_cast<Fix16>(static_cast<float>(y_1)),
+                               static_cast<Fix16>(static_cast<float>(y_2)),
+                               static_cast<Fix16>(static_cast<float>(y_3)),
+                               static_cast<Fix16>(static_cast<float>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline Fix16 interpolate( Fix16 x1, uint8_t x2,
+                            Fix16 x_1, Fix16 x_2, uint8_t x_3, uint8_t x_4,
+                            Fix16 y_1, Fix16 y_2, Fix16 y_3, Fix16 y_4 )
+{
+  return 
+                  interpolate( x1,
+                               static_cast<Fix16>(static_cast<int16_t>(x2)),
+                               x_1,
+                               x_2,
+                               static_cast<Fix16>(static_cast<int16_t>(x_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(x_4)),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline float interpolate( Fix16 x1, uint8_t x2,
+                            Fix16 x_1, Fix16 x_2, uint8_t x_3, uint8_t x_4,
+                            float y_1, float y_2, float y_3, float y_4 )
+{
+  return 
+                  interpolate( static_cast<float>(x1),
+                               static_cast<float>(x2),
+                               static_cast<float>(x_1),
+                               static_cast<float>(x_2),
+                               static_cast<float>(x_3),
+                               static_cast<float>(x_4),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline double interpolate( Fix16 x1, uint8_t x2,
+                            Fix16 x_1, Fix16 x_2, uint8_t x_3, uint8_t x_4,
+                            double y_1, double y_2, double y_3, double y_4 )
+{
+  return 
+                  interpolate( static_cast<double>(x1),
+                               static_cast<double>(x2),
+                               static_cast<double>(x_1),
+                               static_cast<double>(x_2),
+                               static_cast<double>(x_3),
+                               static_cast<double>(x_4),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline int8_t interpolate( Fix16 x1, int16_t x2,
+                            Fix16 x_1, Fix16 x_2, int16_t x_3, int16_t x_4,
+                            int8_t y_1, int8_t y_2, int8_t y_3, int8_t y_4 )
+{
+  return static_cast<int8_t>(static_cast<int16_t>(
+                  interpolate( x1,
+                               static_cast<Fix16>(x2),
+                               x_1,
+                               x_2,
+                               static_cast<Fix16>(x_3),
+                               static_cast<Fix16>(x_4),
+                               static_cast<Fix16>(static_cast<int16_t>(y_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline uint8_t interpolate( Fix16 x1, int16_t x2,
+                            Fix16 x_1, Fix16 x_2, int16_t x_3, int16_t x_4,
+                            uint8_t y_1, uint8_t y_2, uint8_t y_3, uint8_t y_4 )
+{
+  return static_cast<uint8_t>(static_cast<int16_t>(
+                  interpolate( x1,
+                               static_cast<Fix16>(x2),
+                               x_1,
+                               x_2,
+                               static_cast<Fix16>(x_3),
+                               static_cast<Fix16>(x_4),
+                               static_cast<Fix16>(static_cast<int16_t>(y_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline int16_t interpolate( Fix16 x1, int16_t x2,
+                            Fix16 x_1, Fix16 x_2, int16_t x_3, int16_t x_4,
+                            int16_t y_1, int16_t y_2, int16_t y_3, int16_t y_4 )
+{
+  return static_cast<int16_t>(
+                  interpolate( x1,
+                               static_cast<Fix16>(x2),
+                               x_1,
+                               x_2,
+                               static_cast<Fix16>(x_3),
+                               static_cast<Fix16>(x_4),
+                               static_cast<Fix16>(y_1),
+                               static_cast<Fix16>(y_2),
+                               static_cast<Fix16>(y_3),
+                               static_cast<Fix16>(y_4) )
+                             );
+}
+
+
+template<>
+inline uint16_t interpolate( Fix16 x1, int16_t x2,
+                            Fix16 x_1, Fix16 x_2, int16_t x_3, int16_t x_4,
+                            uint16_t y_1, uint16_t y_2, uint16_t y_3, uint16_t y_4 )
+{
+  return static_cast<uint16_t>(static_cast<float>(
+                  interpolate( x1,
+                               static_cast<Fix16>(x2),
+                               x_1,
+                               x_2,
+                               static_cast<Fix16>(x_3),
+                               static_cast<Fix16>(x_4),
+                               static_cast<Fix16>(static_cast<float>(y_1)),
+                               static_cast<Fix16>(static_cast<float>(y_2)),
+                               static_cast<Fix16>(static_cast<float>(y_3)),
+                               static_cast<Fix16>(static_cast<float>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline Fix16 interpolate( Fix16 x1, int16_t x2,
+                            Fix16 x_1, Fix16 x_2, int16_t x_3, int16_t x_4,
+                            Fix16 y_1, Fix16 y_2, Fix16 y_3, Fix16 y_4 )
+{
+  return 
+                  interpolate( x1,
+                               static_cast<Fix16>(x2),
+                               x_1,
+                               x_2,
+                               static_cast<Fix16>(x_3),
+                               static_cast<Fix16>(x_4),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline float interpolate( Fix16 x1, int16_t x2,
+                            Fix16 x_1, Fix16 x_2, int16_t x_3, int16_t x_4,
+                            float y_1, float y_2, float y_3, float y_4 )
+{
+  return 
+                  interpolate( static_cast<float>(x1),
+                               static_cast<float>(x2),
+                               static_cast<float>(x_1),
+                               static_cast<float>(x_2),
+                               static_cast<float>(x_3),
+                               static_cast<float>(x_4),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline double interpolate( Fix16 x1, int16_t x2,
+                            Fix16 x_1, Fix16 x_2, int16_t x_3, int16_t x_4,
+                            double y_1, double y_2, double y_3, double y_4 )
+{
+  return 
+                  interpolate( static_cast<double>(x1),
+                               static_cast<double>(x2),
+                               static_cast<double>(x_1),
+                               static_cast<double>(x_2),
+                               static_cast<double>(x_3),
+                               static_cast<double>(x_4),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline int8_t interpolate( Fix16 x1, uint16_t x2,
+                            Fix16 x_1, Fix16 x_2, uint16_t x_3, uint16_t x_4,
+                            int8_t y_1, int8_t y_2, int8_t y_3, int8_t y_4 )
+{
+  return static_cast<int8_t>(static_cast<int16_t>(
+                  interpolate( x1,
+                               static_cast<Fix16>(static_cast<float>(x2)),
+                               x_1,
+                               x_2,
+                               static_cast<Fix16>(static_cast<float>(x_3)),
+                               static_cast<Fix16>(static_cast<float>(x_4)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline uint8_t interpolate( Fix16 x1, uint16_t x2,
+                            Fix16 x_1, Fix16 x_2, uint16_t x_3, uint16_t x_4,
+                            uint8_t y_1, uint8_t y_2, uint8_t y_3, uint8_t y_4 )
+{
+  return static_cast<uint8_t>(static_cast<int16_t>(
+                  interpolate( x1,
+                               static_cast<Fix16>(static_cast<float>(x2)),
+                               x_1,
+                               x_2,
+                               static_cast<Fix16>(static_cast<float>(x_3)),
+                               static_cast<Fix16>(static_cast<float>(x_4)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline int16_t interpolate( Fix16 x1, uint16_t x2,
+                            Fix16 x_1, Fix16 x_2, uint16_t x_3, uint16_t x_4,
+                            int16_t y_1, int16_t y_2, int16_t y_3, int16_t y_4 )
+{
+  return static_cast<int16_t>(
+                  interpolate( x1,
+                               static_cast<Fix16>(static_cast<float>(x2)),
+                               x_1,
+                               x_2,
+                               static_cast<Fix16>(static_cast<float>(x_3)),
+                               static_cast<Fix16>(static_cast<float>(x_4)),
+                               static_cast<Fix16>(y_1),
+                               static_cast<Fix16>(y_2),
+                               static_cast<Fix16>(y_3),
+                               static_cast<Fix16>(y_4) )
+                             );
+}
+
+
+template<>
+inline uint16_t interpolate( Fix16 x1, uint16_t x2,
+                            Fix16 x_1, Fix16 x_2, uint16_t x_3, uint16_t x_4,
+                            uint16_t y_1, uint16_t y_2, uint16_t y_3, uint16_t y_4 )
+{
+  return static_cast<uint16_t>(static_cast<float>(
+                  interpolate( x1,
+                               static_cast<Fix16>(static_cast<float>(x2)),
+                               x_1,
+                               x_2,
+                               static_cast<Fix16>(static_cast<float>(x_3)),
+                               static_cast<Fix16>(static_cast<float>(x_4)),
+                               static_cast<Fix16>(static_cast<float>(y_1)),
+                               static_cast<Fix16>(static_cast<float>(y_2)),
+                               static_cast<Fix16>(static_cast<float>(y_3)),
+                               static_cast<Fix16>(static_cast<float>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline Fix16 interpolate( Fix16 x1, uint16_t x2,
+                            Fix16 x_1, Fix16 x_2, uint16_t x_3, uint16_t x_4,
+                            Fix16 y_1, Fix16 y_2, Fix16 y_3, Fix16 y_4 )
+{
+  return 
+                  interpolate( x1,
+                               static_cast<Fix16>(static_cast<float>(x2)),
+                               x_1,
+                               x_2,
+                               static_cast<Fix16>(static_cast<float>(x_3)),
+                               static_cast<Fix16>(static_cast<float>(x_4)),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline float interpolate( Fix16 x1, uint16_t x2,
+                            Fix16 x_1, Fix16 x_2, uint16_t x_3, uint16_t x_4,
+                            float y_1, float y_2, float y_3, float y_4 )
+{
+  return 
+                  interpolate( static_cast<float>(x1),
+                               static_cast<float>(x2),
+                               static_cast<float>(x_1),
+                               static_cast<float>(x_2),
+                               static_cast<float>(x_3),
+                               static_cast<float>(x_4),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline double interpolate( Fix16 x1, uint16_t x2,
+                            Fix16 x_1, Fix16 x_2, uint16_t x_3, uint16_t x_4,
+                            double y_1, double y_2, double y_3, double y_4 )
+{
+  return 
+                  interpolate( static_cast<double>(x1),
+                               static_cast<double>(x2),
+                               static_cast<double>(x_1),
+                               static_cast<double>(x_2),
+                               static_cast<double>(x_3),
+                               static_cast<double>(x_4),
+                               y_1,
+                               y_2,
+                               y_3,
+                               y_4 )
+                             ;
+}
+
+
+template<>
+inline int8_t interpolate( Fix16 x1, Fix16 x2,
+                            Fix16 x_1, Fix16 x_2, Fix16 x_3, Fix16 x_4,
+                            int8_t y_1, int8_t y_2, int8_t y_3, int8_t y_4 )
+{
+  return static_cast<int8_t>(static_cast<int16_t>(
+                  interpolate( x1,
+                               x2,
+                               x_1,
+                               x_2,
+                               x_3,
+                               x_4,
+                               static_cast<Fix16>(static_cast<int16_t>(y_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline uint8_t interpolate( Fix16 x1, Fix16 x2,
+                            Fix16 x_1, Fix16 x_2, Fix16 x_3, Fix16 x_4,
+                            uint8_t y_1, uint8_t y_2, uint8_t y_3, uint8_t y_4 )
+{
+  return static_cast<uint8_t>(static_cast<int16_t>(
+                  interpolate( x1,
+                               x2,
+                               x_1,
+                               x_2,
+                               x_3,
+                               x_4,
+                               static_cast<Fix16>(static_cast<int16_t>(y_1)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_2)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_3)),
+                               static_cast<Fix16>(static_cast<int16_t>(y_4)) )
+                             ));
+}
+
+
+template<>
+inline int16_t interpolate( Fix16 x1, Fix16 x2,
+                            Fix16 x_1, Fix16 x_2, Fix16 x_3, Fix16 x_4,
+                            int16_t y_1, int16_t y_2, int16_t y_3, int16_t y_4 )
+{
+  return static_cast<int16_t>(
+                  interpolate( x1,
+                               x2,
+                               x_1,
+                               x_2,
+                               x_3,
+                               x_4,
+                               static_cast<Fix16>(y_1),
+                               static_cast<Fix16>(y_2),
+                               static_cast<Fix16>(y_3),
+                               static_cast<Fix16>(y_4) )
+                             );
+}
+
+
+template<>
+inline uint16_t interpolate( Fix16 x1, Fix16 x2,
+                            Fix16 x_1, Fix16 x_2, Fix16 x_3, Fix16 x_4,
+                            uint16_t y_1, uint16_t y_2, uint16_t y_3, uint16_t y_4 )
+{
+  return static_cast<uint16_t>(static_cast<float>(
+                  interpolate( x1,
+                               x2,
+                               x_1,
+                               x_2,
                                x_3,
                                x_4,
                                static_cast<Fix16>(static_cast<float>(y_1)),
                                static_cast<Fix16>(static_cast<float>(y_2)),
                                static_cast<Fix16>(static_cast<float>(y_3)),
                                static_cast<Fix16>(static_cast<float>(y_4)) )
-#ifndef DEBUG
                              ));
-#else
-  return static_cast<uint16_t>(static_cast<float>(retval));
-#endif
 }
 
 
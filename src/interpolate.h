@@ -84,12 +84,12 @@ inline Y interpolate( X x, X x_1, X x_2, Y y_1, Y y_2 )
 
 
 //-----------------------------------------------------------------------------
-// 2D bilinear interpolation
+// 2D bilinear interpolation. The x1 and x2 axes may be of different types.
 //-----------------------------------------------------------------------------
 
-template <typename X, typename Y>
-inline Y interpolate( X x1, X x2, X x_1, X x_2, X x_3, X x_4,
-                                  Y y_1, Y y_2, Y y_3, Y y_4 )
+template <typename X1, typename X2, typename Y>
+inline Y interpolate( X1 x1, X2 x2, X1 x_1, X1 x_2, X2 x_3, X2 x_4,
+                                    Y y_1, Y y_2, Y y_3, Y y_4 )
 {
   Y   one   = 1.0f; // avoid ambigious operator overload
 
@@ -121,6 +121,84 @@ inline Y interpolate( X x1, X x2, X x_1, X x_2, X x_3, X x_4,
 
 #endif // SUPPORT_INTEGER_ARITMETHIC
 
+
+//-----------------------------------------------------------------------------
+// Interpolation with precomputed weights.
+//
+// When a number of ys share the same x(es), the fractions dx are computed
+// once with fraction() and applied to each y with lerp(). Computations are
+// done in InterpolType<Y>::type, which is Fix16 for integers, just like the
+// specializations above.
+//-----------------------------------------------------------------------------
+
+template<typename Y> struct InterpolType            { typedef Y     type; };
+
+#ifdef SUPPORT_INTEGER_ARITMETHIC
+template<>           struct InterpolType<int8_t>    { typedef Fix16 type; };
+template<>           struct InterpolType<uint8_t>   { typedef Fix16 type; };
+template<>           struct InterpolType<int16_t>   { typedef Fix16 type; };
+template<>           struct InterpolType<uint16_t>  { typedef Fix16 type; };
+#endif
+
+
+// Cast between types, thru an intermediate type where Fix16 requires so.
+
+template<typename To, typename From>
+inline To castTo( From x )                          { return static_cast<To>(x); }
+
+#ifdef SUPPORT_INTEGER_ARITMETHIC
+template<> inline Fix16    castTo<Fix16,int8_t>   ( int8_t   x )
+                            { return static_cast<Fix16>(static_cast<int16_t>(x)); }
+template<> inline Fix16    castTo<Fix16,uint8_t>  ( uint8_t  x )
+                            { return static_cast<Fix16>(static_cast<int16_t>(x)); }
+template<> inline Fix16    castTo<Fix16,uint16_t> ( uint16_t x )
+                            { return static_cast<Fix16>(static_cast<float>(x));   }
+
+template<> inline int8_t   castTo<int8_t,Fix16>   ( Fix16 x )
+                            { return static_cast<int8_t>(static_cast<int16_t>(x));  }
+template<> inline uint8_t  castTo<uint8_t,Fix16>  ( Fix16 x )
+                            { return static_cast<uint8_t>(static_cast<int16_t>(x)); }
+template<> inline uint16_t castTo<uint16_t,Fix16> ( Fix16 x )
+                            { return static_cast<uint16_t>(static_cast<float>(x));  }
+#endif
+
+
+// 0 <= dx <= 1, for x_1 <= x <= x_2
+
+template <typename T, typename X>
+inline T fraction( X x, X x_1, X x_2 )
+{
+  T   _x    = castTo<T>(x);
+  T   _x_1  = castTo<T>(x_1);
+  T   _x_2  = castTo<T>(x_2);
+
+  return (_x - _x_1) / (_x_2 - _x_1);
+}
+
+
+// 1D, returns the interpolated value in T
+
+template <typename T, typename Y>
+inline T lerp( T dx, Y y_1, Y y_2 )
+{
+  T   one   = 1.0f; // avoid ambigious operator overload
+
+  return (one-dx)*castTo<T>(y_1) + dx*castTo<T>(y_2);
+}
+
+
+// 2D, corners in the same order as for interpolate()
+
+template <typename T, typename Y>
+inline T lerp( T dx1, T dx2, Y y_1, Y y_2, Y y_3, Y y_4 )
+{
+  T   one   = 1.0f; // avoid ambigious operator overload
+
+  return (one-dx1)*(one-dx2)*castTo<T>(y_1) + dx1*(one-dx2)*castTo<T>(y_2) +
+                   dx1*dx2*castTo<T>(y_3) + (one-dx1)*dx2*castTo<T>(y_4);
+}
+
+
 //-----------------------------------------------------------------------------
 // 
 //-----------------------------------------------------------------------------
@@ -28,174 +28,299 @@
 
 #include "toString.h"
 
-// progmem on Arduino
-#ifndef F
-#define F(c) c
+#ifdef AVR
+#include <avr/pgmspace.h>
+#else
+#ifndef PROGMEM
+#define PROGMEM
+#endif
+#ifndef pgm_read_byte
+#define pgm_read_byte(p)  (*(const uint8_t*)(p))
+#endif
+#ifndef pgm_read_dword
+#define pgm_read_dword(p) (*(const uint32_t*)(p))
+#endif
 #endif
 
 
-static const char* NumberToString(unsigned long n, int tabsize, uint8_t base);
-static const char* NumberToString(long n, int tabsize, uint8_t base);
-static const char* FloatToString(double number, int tabsize, uint8_t digits);
+static const char* NumberToString(char* buf, size_t size, unsigned long n, int tabsize, uint8_t base);
+static const char* NumberToString(char* buf, size_t size, long n, int tabsize, uint8_t base);
+static const char* FloatToString(char* buf, size_t size, double number, int tabsize, uint8_t digits);
+static const char* Fix16ToString(char* buf, size_t size, Fix16 number, int tabsize, uint8_t digits);
+
+static char* nextBuffer();
 
 
 // Public Methods //////////////////////////////////////////////////////////////
 
 
+const char* toString(char* buf, size_t size, char b, int tabsize, int base)
+{
+  return NumberToString(buf, size, (long) b, tabsize, base);
+}
+
+const char* toString(char* buf, size_t size, unsigned char b, int tabsize, int base)
+{
+  return NumberToString(buf, size, (unsigned long) b, tabsize, base);
+}
+
+const char* toString(char* buf, size_t size, int n, int tabsize, int base)
+{
+  return NumberToString(buf, size, (long) n, tabsize, base);
+}
+
+const char* toString(char* buf, size_t size, unsigned int n, int tabsize, int base)
+{
+  return NumberToString(buf, size, (unsigned long) n, tabsize, base);
+}
+
+const char* toString(char* buf, size_t size, long n, int tabsize, int base)
+{
+  return NumberToString(buf, size, n, tabsize, base);
+}
+
+const char* toString(char* buf, size_t size, unsigned long n, int tabsize, int base)
+{
+  return NumberToString(buf, size, n, tabsize, base);
+}
+
+const char* toString(char* buf, size_t size, double n, int tabsize, int digits)
+{
+  return FloatToString(buf, size, n, tabsize, digits);
+}
+
+const char* toString(char* buf, size_t size, Fix16 n, int tabsize, int digits)
+{
+  return Fix16ToString(buf, size, n, tabsize, digits);
+}
+
+
 const char* toString(char b, int tabsize, int base)
 {
-  return NumberToString((long) b, tabsize, base);
+  return toString(nextBuffer(), TO_STRING_SIZE, b, tabsize, base);
 }
 
 const char* toString(unsigned char b, int tabsize, int base)
 {
-  return NumberToString((unsigned long) b, tabsize, base);
+  return toString(nextBuffer(), TO_STRING_SIZE, b, tabsize, base);
 }
 
 const char* toString(int n, int tabsize, int base)
 {
-  return NumberToString((long) n, tabsize, base);
+  return toString(nextBuffer(), TO_STRING_SIZE, n, tabsize, base);
 }
 
 const char* toString(unsigned int n, int tabsize, int base)
 {
-  return NumberToString((unsigned long) n, tabsize, base);
+  return toString(nextBuffer(), TO_STRING_SIZE, n, tabsize, base);
 }
 
 const char* toString(long n, int tabsize, int base)
 {
-  return NumberToString(n, tabsize, base);
+  return toString(nextBuffer(), TO_STRING_SIZE, n, tabsize, base);
 }
 
 const char* toString(unsigned long n, int tabsize, int base)
 {
-  return NumberToString(n, tabsize, base);
+  return toString(nextBuffer(), TO_STRING_SIZE, n, tabsize, base);
 }
 
 const char* toString(double n, int tabsize, int digits)
 {
-  return FloatToString(n, tabsize, digits);
+  return toString(nextBuffer(), TO_STRING_SIZE, n, tabsize, digits);
 }
 
 const char* toString(Fix16 n, int tabsize, int digits)
 {
-  return FloatToString(static_cast<double>(n), tabsize, digits);
+  return toString(nextBuffer(), TO_STRING_SIZE, n, tabsize, digits);
 }
 
 
 // Private Methods /////////////////////////////////////////////////////////////
 
-static const char* NumberToString(unsigned long n, int tabsize, uint8_t base)
+// "00" .. "99", so decimal digits are generated two at a time
+static const char digitPairs[200] PROGMEM =
 {
-  static char buf[8 * sizeof(long) + 1]; // Assumes 8-bit chars plus zero byte.
-  char *str = &buf[sizeof(buf) - 1];
+  '0','0','0','1','0','2','0','3','0','4','0','5','0','6','0','7','0','8','0','9',
+  '1','0','1','1','1','2','1','3','1','4','1','5','1','6','1','7','1','8','1','9',
+  '2','0','2','1','2','2','2','3','2','4','2','5','2','6','2','7','2','8','2','9',
+  '3','0','3','1','3','2','3','3','3','4','3','5','3','6','3','7','3','8','3','9',
+  '4','0','4','1','4','2','4','3','4','4','4','5','4','6','4','7','4','8','4','9',
+  '5','0','5','1','5','2','5','3','5','4','5','5','5','6','5','7','5','8','5','9',
+  '6','0','6','1','6','2','6','3','6','4','6','5','6','6','6','7','6','8','6','9',
+  '7','0','7','1','7','2','7','3','7','4','7','5','7','6','7','7','7','8','7','9',
+  '8','0','8','1','8','2','8','3','8','4','8','5','8','6','8','7','8','8','8','9',
+  '9','0','9','1','9','2','9','3','9','4','9','5','9','6','9','7','9','8','9','9'
+};
+
+static const uint32_t powersOf10[9] PROGMEM =
+{
+  1UL, 10UL, 100UL, 1000UL, 10000UL, 100000UL, 1000000UL, 10000000UL, 100000000UL
+};
 
-  *str = '\0';
 
-  // prevent crash if called with base == 1
-  if (base < 2) base = 10;
+static char* nextBuffer()
+{
+  static char    bufs[TO_STRING_BUFFERS][TO_STRING_SIZE];
+  static uint8_t next = 0;
+
+  char* buf = bufs[next];
+  next = (next + 1) % TO_STRING_BUFFERS;
+
+  return buf;
+}
+
+
+// Write the digits of n backwards, ending just before end. Returns the first
+// digit.
+static char* digitsOf(char* end, unsigned long n, uint8_t base)
+{
+  if (base == 10) {
+    while (n >= 100) {
+      unsigned int r = n % 100;
+      n /= 100;
+
+      *--end = pgm_read_byte(&digitPairs[2*r + 1]);
+      *--end = pgm_read_byte(&digitPairs[2*r]);
+    }
+
+    if (n >= 10) {
+      *--end = pgm_read_byte(&digitPairs[2*n + 1]);
+      *--end = pgm_read_byte(&digitPairs[2*n]);
+    }
+    else *--end = '0' + n;
+
+    return end;
+  }
 
   do {
     char c = n % base;
     n /= base;
 
-    *--str = c < 10 ? c + '0' : c + 'A' - 10;
+    *--end = c < 10 ? c + '0' : c + 'A' - 10;
   } while(n);
 
-  while( strlen(str) < tabsize ) *--str = ' ';
-
-  return str;
+  return end;
 }
 
-static const char* NumberToString(long n, int tabsize, uint8_t base)
+
+// Copy the len characters at str into buf, right aligned in a field of
+// tabsize characters. Padding is cut off where it does not fit. If the
+// characters themselves do not fit, "ovf" is written instead.
+static const char* align(char* buf, size_t size, const char* str, size_t len, int tabsize)
 {
-  static char buf[8 * sizeof(long) + 1]; // Assumes 8-bit chars plus zero byte.
-  char *str = &buf[sizeof(buf) - 1];
+  if (size == 0) return buf;
 
-  *str = '\0';
+  if (len > size - 1) {
+    str = "ovf";
+    len = size - 1 < 3 ? size - 1 : 3;
+  }
 
-  bool isneg = false;
+  size_t pad = tabsize > 0 && (size_t)tabsize > len ? tabsize - len : 0;
 
-  if ((base == 10) && (n < 0)){
-    isneg = true;
-    n = -n;
-  }
+  if (pad > size - 1 - len) pad = size - 1 - len;
+
+  memset(buf, ' ', pad);
+  memmove(buf + pad, str, len);
+  buf[pad + len] = '\0';
+
+  return buf;
+}
+
+
+static const char* NumberToString(char* buf, size_t size, unsigned long n, int tabsize, uint8_t base)
+{
+  char  tmp[8 * sizeof(long)]; // Assumes 8-bit chars.
+  char* end = tmp + sizeof(tmp);
 
   // prevent crash if called with base == 1
   if (base < 2) base = 10;
 
-  do {
-    char c = n % base;
-    n /= base;
+  char* str = digitsOf(end, n, base);
 
-    *--str = c < 10 ? c + '0' : c + 'A' - 10;
-  } while(n);
+  return align(buf, size, str, end - str, tabsize);
+}
+
+static const char* NumberToString(char* buf, size_t size, long n, int tabsize, uint8_t base)
+{
+  if (base != 10 || n >= 0) return NumberToString(buf, size, (unsigned long) n, tabsize, base);
 
-  if( isneg ) *--str = '-';
+  char  tmp[8 * sizeof(long) + 1]; // Assumes 8-bit chars, plus sign.
+  char* end = tmp + sizeof(tmp);
+  char* str = digitsOf(end, 0UL - (unsigned long) n, 10);
 
-  while( strlen(str) < tabsize ) *--str = ' ';
+  *--str = '-';
 
-  return str;
+  return align(buf, size, str, end - str, tabsize);
 }
 
-static const char* FloatToString(double number, int tabsize, uint8_t digits) 
+
+// Format sign, int_part and the 'digits' decimals in frac, which is below
+// 10^digits.
+static const char* FixedToString(char* buf, size_t size, bool isneg,
+                                 unsigned long int_part, unsigned long frac,
+                                 int tabsize, uint8_t digits)
 {
-  static char buf[20];
-  char *str = &buf[0];
-  
-  if (isnan(number)) { strcpy(buf, F("nan")); return buf; }
-  if (isinf(number)) { strcpy(buf, F("inf")); return buf; }
-  if (number > 4294967040.0) { strcpy(buf, F("ovf")); return buf; }
-  if (number <-4294967040.0) { strcpy(buf, F("ovf")); return buf; }
+  char  tmp[24];
+  char* end = tmp + sizeof(tmp);
+  char* str = end;
 
-  if (digits > 8 ) digits = 8;
-  
-  // Handle negative numbers
-  if (number < 0.0)
-  {
-     *str++ = '-';
-     number = -number;
+  if (digits > 0) {
+    str = digitsOf(end, frac, 10);
+    while (str > end - digits) *--str = '0';
+    *--str = '.';
   }
 
+  str = digitsOf(str, int_part, 10);
+
+  if (isneg) *--str = '-';
+
+  return align(buf, size, str, end - str, tabsize);
+}
+
+static const char* FloatToString(char* buf, size_t size, double number, int tabsize, uint8_t digits)
+{
+  if (isnan(number))          return align(buf, size, "nan", 3, tabsize);
+  if (isinf(number))          return align(buf, size, "inf", 3, tabsize);
+  if (number > 4294967040.0)  return align(buf, size, "ovf", 3, tabsize);
+  if (number <-4294967040.0)  return align(buf, size, "ovf", 3, tabsize);
+
+  if (digits > 8 ) digits = 8;
+
+  bool isneg = number < 0.0;
+  if (isneg) number = -number;
+
   // Round correctly so that print(1.999, 2) prints as "2.00"
-  double rounding = 0.5;
-  for (uint8_t i=0; i<digits; ++i)
-    rounding /= 10.0;
-  
-  number += rounding;
+  const unsigned long scale = pgm_read_dword(&powersOf10[digits]);
 
-  // Extract the integer part of the number and print it
   unsigned long int_part = (unsigned long)number;
-  double remainder = number - (double)int_part;
-  strcpy(str, NumberToString(int_part,0,DEC));
-  while( *str != 0 ) str++;
+  unsigned long frac     = (unsigned long)((number - (double)int_part) * scale + 0.5);
 
-  // Print the decimal point, but only if there are digits beyond
-  if (digits > 0) {
-    *str++= '.'; 
-  }
+  if (frac >= scale) { int_part++; frac -= scale; }
+
+  return FixedToString(buf, size, isneg, int_part, frac, tabsize, digits);
+}
+
+// Directly from the Q16.16 bits, without converting to float.
+static const char* Fix16ToString(char* buf, size_t size, Fix16 number, int tabsize, uint8_t digits)
+{
+  if (digits > 8 ) digits = 8;
 
-  // Extract digits from the remainder one at a time
-  while (digits-- > 0)
-  {
-    remainder *= 10.0;
-    unsigned int toPrint = (unsigned int)(remainder);
+  const fix16_t v     = number.value;
+  const bool    isneg = v < 0;
+  const uint32_t m    = isneg ? 0UL - (uint32_t) v : (uint32_t) v;
 
-    strcpy(str, NumberToString((unsigned long)remainder,0,DEC));
-    while( !*str ) str++;
+  const unsigned long scale = pgm_read_dword(&powersOf10[digits]);
 
-    remainder -= toPrint; 
-  }
+  unsigned long int_part = m >> 16;
+  unsigned long frac;
 
-  if( int len=strlen(buf) < tabsize )
-  {
-    int shift = tabsize - len;
-    char *str = &buf[0] + tabsize + 1;
-    *str-- = '\0';
+  if (digits <= 4)  // 0xFFFF * 10^4 fits in 32 bits
+    frac = (unsigned long)(((m & 0xFFFF) * scale + 0x8000) >> 16);
+  else
+    frac = (unsigned long)(((uint64_t)(m & 0xFFFF) * scale + 0x8000) >> 16);
 
-    for( int i=0; i<len; i++)         *str-- = *(str-shift);
-    for( int i=0; i<tabsize-len; i++) *str-- = ' ';
-  }
+  if (frac >= scale) { int_part++; frac -= scale; }
 
-  return buf;
+  return FixedToString(buf, size, isneg, int_part, frac, tabsize, digits);
 }
@@ -42,6 +42,26 @@
 #define OCT 8
 #define BIN 2
 
+#define TO_STRING_BUFFERS 4
+
+// Size of a buffer holding any number: the binary digits of a long, a sign
+// and the terminating zero. Longer padding is cut off.
+#define TO_STRING_SIZE (8 * sizeof(long) + 2)
+
+// Re-entrant versions, writing the number, right aligned in a field of
+// tabsize characters, into buf of size bytes. Return buf.
+const char* toString(char* buf, size_t size, char,          int tabsize=4, int = DEC);
+const char* toString(char* buf, size_t size, unsigned char, int tabsize=4, int = DEC);
+const char* toString(char* buf, size_t size, int,           int tabsize=4, int = DEC);
+const char* toString(char* buf, size_t size, unsigned int,  int tabsize=4, int = DEC);
+const char* toString(char* buf, size_t size, long,          int tabsize=4, int = DEC);
+const char* toString(char* buf, size_t size, unsigned long, int tabsize=4, int = DEC);
+const char* toString(char* buf, size_t size, double, int tabsize=4, int digits = 2);  // Max 8 digits.
+const char* toString(char* buf, size_t size, Fix16,  int tabsize=4, int digits = 2);  // Max 8 digits.
+
+// As above, in one of TO_STRING_BUFFERS static buffers, used in turn. The
+// result is valid until as many further calls, so a few can be used in a
+// single expression, but not from multiple threads.
 const char* toString(char,          int tabsize=4, int = DEC);
 const char* toString(unsigned char, int tabsize=4, int = DEC);
 const char* toString(int,           int tabsize=4, int = DEC);